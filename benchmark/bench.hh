@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2025 Materials Modelling Lab, The University of Tokyo
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __PHASE_FIELD__BENCH__
+#define __PHASE_FIELD__BENCH__
+
+#include <benchmark/benchmark.h>
+#include <phase_field/param.hh>
+#include <phase_field/util.hh>
+
+#include <algorithm>
+#include <cstdint>
+#include <omp.h>
+#include <vector>
+
+/*
+ * Shared setup of the benchmark suite. Every case reports
+ *   cells/s:          cell updates (or cells processed) per second
+ *   bytes_per_second: effective bandwidth, the bytes of the arrays the case must read and write
+ *                     once per iteration, so it is comparable across kernels and with STREAM
+ */
+namespace bench {
+using T = phase_field::Field2D::scalar_type;
+
+inline phase_field::Param get_param() {
+  phase_field::Param p = phase_field::get_pure_ni_param();
+  p.lambda = 16.0;
+  p.u = -0.2;
+  p.setup();
+  return p;
+}
+
+/* A quarter circle nucleus of radius n / 4 in the corner, so part of every grid is interface */
+inline phase_field::Field2D get_initial(const std::size_t ny, const std::size_t nx) {
+  phase_field::Field2D phi({ny, nx});
+  phase_field::set_nuclear_to_corner(phi, static_cast<int64_t>(std::min(ny, nx) / 4));
+  return phi;
+}
+
+/**
+ * @brief Report cells/s and the effective bandwidth
+ *
+ * @param cells cells processed per iteration
+ * @param arrays arrays of one cell read or written per iteration
+ */
+inline void set_counters(benchmark::State &state, const double cells, const double arrays) {
+  state.counters["cells/s"] =
+      benchmark::Counter(cells, benchmark::Counter::kIsIterationInvariantRate);
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * cells * arrays * sizeof(T)));
+}
+
+/* Grid sizes of the suite: 64^2 to 8192^2 */
+inline void sizes(benchmark::internal::Benchmark *b, const int64_t max = 8192) {
+  for (int64_t n = 64; n <= max; n *= 2) {
+    b->Arg(n);
+  }
+}
+
+/* (grid size, OpenMP threads): powers of two up to the available threads, and all of them */
+inline void thread_scaling(benchmark::internal::Benchmark *b, const std::vector<int64_t> &grids) {
+  const int64_t max = omp_get_max_threads();
+  for (const auto n : grids) {
+    for (int64_t t = 1; t < max; t *= 2) {
+      b->Args({n, t});
+    }
+    b->Args({n, max});
+  }
+  b->ArgNames({"n", "threads"});
+}
+
+/**
+ * @brief Run the case with the given number of OpenMP threads, restored afterwards
+ */
+class Threads {
+  const int saved;
+
+public:
+  explicit Threads(const int64_t n) : saved(omp_get_max_threads()) {
+    omp_set_num_threads(static_cast<int>(n));
+  }
+  Threads(const Threads &) = delete;
+  Threads &operator=(const Threads &) = delete;
+  ~Threads() { omp_set_num_threads(saved); }
+};
+} // namespace bench
+
+#endif // __PHASE_FIELD__BENCH__
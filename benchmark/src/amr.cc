@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2025 Materials Modelling Lab, The University of Tokyo
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <benchmark/benchmark.h>
+#include <phase_field/amr.hh>
+#include <phase_field/phase_field.hh>
+#include <phase_field/util.hh>
+
+/*
+ * Time to advance a corner nucleus on a range(0)^2 grid by 200 steps, and the memory held by
+ * the field, on the uniform grid and on the adaptive mesh.
+ */
+static constexpr std::size_t n_steps = 200;
+
+static phase_field::Param get_param() {
+  phase_field::Param p = phase_field::get_pure_ni_param();
+  p.lambda = 16.0;
+  p.u = -0.2;
+  p.setup();
+  return p;
+}
+
+static phase_field::Field2D get_initial(const std::size_t n) {
+  phase_field::Field2D phi({n, n});
+  phase_field::set_nuclear_to_corner(phi, n / 16);
+  return phi;
+}
+
+static void BM_uniform(benchmark::State &state) {
+  const auto n = static_cast<std::size_t>(state.range(0));
+  const phase_field::PhaseField2D system(get_param());
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto phi = get_initial(n);
+    auto phi_next = phase_field::Field2D::like(phi);
+    state.ResumeTiming();
+    for (std::size_t i = 0; i < n_steps; ++i) {
+      system.predict(phi, phi_next);
+      std::swap(phi, phi_next);
+    }
+  }
+  state.counters["cells"] = n * n;
+  state.counters["bytes"] = 2 * n * n * sizeof(phase_field::Field2D::scalar_type);
+}
+BENCHMARK(BM_uniform)
+    ->RangeMultiplier(2)
+    ->Range(512, 4096)
+    ->Iterations(2)
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_amr(benchmark::State &state) {
+  const auto n = static_cast<std::size_t>(state.range(0));
+  const auto p = get_param();
+  phase_field::AMRPhaseField2D system(p);
+  for (auto _ : state) {
+    state.PauseTiming();
+    system.initialize(get_initial(n));
+    state.ResumeTiming();
+    system.advance(n_steps);
+  }
+  /* Mesh after the last run */
+  state.counters["cells"] = system.cells();
+  state.counters["bytes"] = system.bytes();
+  state.counters["patches"] = system.patches();
+}
+BENCHMARK(BM_amr)->RangeMultiplier(2)->Range(512, 4096)->Iterations(2)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2025 Materials Modelling Lab, The University of Tokyo
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <bench.hh>
+#include <phase_field/phase_field.hh>
+#include <phase_field/writer.hh>
+
+#include <algorithm>
+#include <filesystem>
+#include <sstream>
+#include <string>
+
+/*
+ * End to end: the loop of phase_field_2d on a range(0)^2 grid, n_steps steps from the initial
+ * nucleus advanced from one snapshot to the next, with a .pfs snapshot every range(1) steps
+ * (0: no output) through the background writer, flushed before the clock stops. The bandwidth
+ * adds the snapshots to the two arrays a step reads and writes.
+ */
+static constexpr std::size_t n_steps = 100;
+
+static void BM_run(benchmark::State &state) {
+  const auto n = static_cast<std::size_t>(state.range(0));
+  const auto interval = static_cast<std::size_t>(state.range(1));
+  const auto output = std::filesystem::temp_directory_path() / "bench_driver";
+  std::filesystem::create_directories(output);
+
+  const auto p = bench::get_param();
+  const phase_field::PhaseField2D system(p);
+  std::size_t snapshots = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    phase_field::PingPong2D fields(bench::get_initial(n, n));
+    state.ResumeTiming();
+    phase_field::io::AsyncWriter writer;
+    const std::size_t chunk = interval ? interval : n_steps;
+    for (std::size_t step = 0; step < n_steps; step += chunk) {
+      if (interval) {
+        std::stringstream ss;
+        ss << "pf_step" << step << ".pfs";
+        writer.submit(output / ss.str(), fields.current(), phase_field::io::Format::snapshot,
+                      {step, step * p.dt, p});
+        ++snapshots;
+      }
+      system.advance(fields, std::min(chunk, n_steps - step));
+    }
+    writer.flush();
+  }
+  std::filesystem::remove_all(output);
+
+  const double cells = static_cast<double>(n * n);
+  state.counters["cells/s"] =
+      benchmark::Counter(cells * n_steps, benchmark::Counter::kIsIterationInvariantRate);
+  state.counters["snapshots"] = static_cast<double>(snapshots) / state.iterations();
+  state.SetBytesProcessed(static_cast<int64_t>((state.iterations() * n_steps * 2 + snapshots) *
+                                               cells * sizeof(bench::T)));
+}
+BENCHMARK(BM_run)
+    ->ArgsProduct({{256, 1024, 4096}, {0, 10}})
+    ->ArgNames({"n", "interval"})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2025 Materials Modelling Lab, The University of Tokyo
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <benchmark/benchmark.h>
+#include <phase_field/ensemble.hh>
+#include <phase_field/phase_field.hh>
+#include <phase_field/util.hh>
+
+/*
+ * range(0) members on a range(1)^2 grid advanced by 100 steps, one PhaseField2D per member
+ * against one EnsemblePhaseField2D for all of them. Members sweep u, lambda and epsilon_c.
+ * cells/s counts member cell updates, cases per hour is cells/s 3600 / (range(1)^2 steps).
+ */
+static constexpr int64_t n_steps = 100;
+
+static std::vector<phase_field::Param> get_params(const int64_t n) {
+  std::vector<phase_field::Param> ret;
+  for (int64_t m = 0; m < n; ++m) {
+    phase_field::Param p = phase_field::get_pure_ni_param();
+    p.u = -0.1 - 0.3 * static_cast<double>(m) / n;
+    p.lambda = 8.0 + 4.0 * (m % 3);
+    p.epsilon_c = 0.012 + 0.002 * (m % 5);
+    p.setup();
+    ret.push_back(p);
+  }
+  return ret;
+}
+
+static phase_field::Field2D get_initial(const int64_t n) {
+  phase_field::Field2D phi({static_cast<std::size_t>(n), static_cast<std::size_t>(n)});
+  phase_field::set_nuclear_to_corner(phi, n / 6);
+  return phi;
+}
+
+static void set_counters(benchmark::State &state) {
+  const double updates = static_cast<double>(state.range(0)) * state.range(1) * state.range(1) *
+                         n_steps;
+  state.counters["cells/s"] =
+      benchmark::Counter(updates, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+static void BM_separate(benchmark::State &state) {
+  const auto params = get_params(state.range(0));
+  std::vector<phase_field::PhaseField2D> systems(params.begin(), params.end());
+  std::vector<phase_field::Field2D> phi(params.size(), get_initial(state.range(1)));
+  auto phi_next = phase_field::Field2D::like(phi[0]);
+  for (auto _ : state) {
+    for (std::size_t m = 0; m < systems.size(); ++m) {
+      for (int64_t i = 0; i < n_steps; ++i) {
+        systems[m].predict(phi[m], phi_next);
+        std::swap(phi[m], phi_next);
+      }
+    }
+  }
+  set_counters(state);
+}
+
+static void BM_ensemble(benchmark::State &state) {
+  const phase_field::EnsemblePhaseField2D system(get_params(state.range(0)));
+  auto phi = system.make_field(state.range(1), state.range(1));
+  auto phi_next = system.make_field(state.range(1), state.range(1));
+  const auto init = get_initial(state.range(1));
+  for (int64_t m = 0; m < system.members(); ++m) {
+    phi.set(m, init);
+  }
+  for (auto _ : state) {
+    for (int64_t i = 0; i < n_steps; ++i) {
+      system.predict(phi, phi_next);
+      std::swap(phi, phi_next);
+    }
+  }
+  set_counters(state);
+}
+
+BENCHMARK(BM_separate)
+    ->ArgsProduct({{8, 32, 128}, {32, 64, 128}})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ensemble)
+    ->ArgsProduct({{8, 32, 128}, {32, 64, 128}})
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
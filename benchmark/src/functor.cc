@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2025 Materials Modelling Lab, The University of Tokyo
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <benchmark/benchmark.h>
+#include <phase_field/impl/kernel.hh>
+#include <random>
+#include <vector>
+
+static void run_aniso_row(benchmark::State &state, const phase_field::simd::AnisoRowFn fn) {
+  phase_field::Param p = phase_field::get_pure_ni_param();
+  p.lambda = 16.0;
+  p.u = -0.2;
+  p.setup();
+  const auto coeff = phase_field::FusedPredictKernel::get_aniso_coeff(p);
+
+  const int64_t n = state.range(0);
+  std::mt19937 engine(0);
+  std::normal_distribution<double> dist(0.0, 1.0 / p.dx);
+  std::vector<double> buf(7 * n);
+  for (int64_t i = 0; i < 2 * n; ++i) {
+    buf[i] = (i % 5 == 0) ? 0.0 : dist(engine);
+  }
+  const phase_field::simd::AnisoRow row{
+      buf.data(),         buf.data() + n,     buf.data() + 2 * n, buf.data() + 3 * n,
+      buf.data() + 4 * n, buf.data() + 5 * n, buf.data() + 6 * n};
+  for (auto _ : state) {
+    fn(coeff, row, 0, n);
+    benchmark::DoNotOptimize(buf.data());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+static void BM_aniso_row_scalar(benchmark::State &state) {
+  run_aniso_row(state, phase_field::simd::aniso_row_scalar);
+}
+BENCHMARK(BM_aniso_row_scalar)->Arg(256)->Arg(4096);
+
+static void BM_aniso_row_dispatch(benchmark::State &state) {
+  run_aniso_row(state, phase_field::simd::aniso_row());
+}
+BENCHMARK(BM_aniso_row_dispatch)->Arg(256)->Arg(4096);
+
+#if defined(__x86_64__) || defined(__i386__)
+static void BM_aniso_row_avx2(benchmark::State &state) {
+  if (!__builtin_cpu_supports("avx2")) {
+    state.SkipWithError("AVX2 not supported");
+    return;
+  }
+  run_aniso_row(state, phase_field::simd::aniso_row_avx2);
+}
+BENCHMARK(BM_aniso_row_avx2)->Arg(256)->Arg(4096);
+
+static void BM_aniso_row_avx512(benchmark::State &state) {
+  if (!__builtin_cpu_supports("avx512f")) {
+    state.SkipWithError("AVX-512 not supported");
+    return;
+  }
+  run_aniso_row(state, phase_field::simd::aniso_row_avx512);
+}
+BENCHMARK(BM_aniso_row_avx512)->Arg(256)->Arg(4096);
+#endif
+
+BENCHMARK_MAIN();
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2025 Materials Modelling Lab, The University of Tokyo
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <bench.hh>
+#include <phase_field/io.hh>
+#include <phase_field/phase_field.hh>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/*
+ * Reading and writing range(0)^2 fields in the legacy text format and in .pfs snapshots. The
+ * bandwidth is that of the file, so text and binary are compared on what reaches the disk.
+ */
+static std::filesystem::path temp_path(const std::string &name, const std::size_t n) {
+  return std::filesystem::temp_directory_path() / ("bench_io_" + name + std::to_string(n));
+}
+
+/* A grown crystal, so the text holds the digits of a real run */
+static phase_field::Field2D get_field(const std::size_t n) {
+  const phase_field::PhaseField2D system(bench::get_param());
+  auto phi = bench::get_initial(n, n);
+  auto phi_next = phase_field::Field2D::like(phi);
+  for (int i = 0; i < 10; ++i) {
+    system.predict(phi, phi_next);
+    std::swap(phi, phi_next);
+  }
+  return phi;
+}
+
+/* Files to be read are written once per size */
+static std::filesystem::path get_dat(const std::size_t n) {
+  const auto filename = temp_path("", n).replace_extension(".dat");
+  if (!std::filesystem::exists(filename)) {
+    phase_field::io::write(filename, get_field(n), true);
+  }
+  return filename;
+}
+
+static std::filesystem::path get_pfs(const std::size_t n) {
+  const auto filename = temp_path("", n).replace_extension(".pfs");
+  if (!std::filesystem::exists(filename)) {
+    phase_field::io::write_snapshot(filename, get_field(n), {}, true);
+  }
+  return filename;
+}
+
+static void set_counters(benchmark::State &state, const std::filesystem::path &filename) {
+  const auto n = static_cast<double>(state.range(0));
+  state.counters["cells/s"] =
+      benchmark::Counter(n * n, benchmark::Counter::kIsIterationInvariantRate);
+  state.SetBytesProcessed(state.iterations() * std::filesystem::file_size(filename));
+}
+
+static void io_sizes(benchmark::internal::Benchmark *b) {
+  for (int64_t n = 256; n <= 4096; n *= 2) {
+    b->Arg(n);
+  }
+  b->UseRealTime()->Unit(benchmark::kMillisecond);
+}
+
+/* The text format takes about 10 bytes per cell, hence the smaller largest grid */
+static void text_sizes(benchmark::internal::Benchmark *b) {
+  for (int64_t n = 256; n <= 2048; n *= 2) {
+    b->Arg(n);
+  }
+  b->UseRealTime()->Unit(benchmark::kMillisecond);
+}
+
+/* The line by line std::stod parser io::read used to be, kept as the baseline */
+static void read_stod(const std::filesystem::path &filename, phase_field::Field2D &field) {
+  std::ifstream fi{filename};
+  std::vector<std::vector<phase_field::Field2D::scalar_type>> data;
+  std::string l1;
+  while (std::getline(fi, l1)) {
+    std::string l2;
+    std::stringstream ss{l1};
+    data.emplace_back();
+    while (std::getline(ss, l2, ' ')) {
+      data.back().emplace_back(std::stod(l2));
+    }
+  }
+  field.resize({data.size(), data.front().size()});
+  for (std::size_t y = 0; y < data.size(); ++y) {
+    for (std::size_t x = 0; x < data[y].size(); ++x) {
+      field[y][x] = data[y][x];
+    }
+  }
+}
+
+template <typename F> static void run_read(benchmark::State &state, F &&read) {
+  const auto n = static_cast<std::size_t>(state.range(0));
+  const auto filename = get_dat(n);
+  phase_field::Field2D field;
+  for (auto _ : state) {
+    read(filename, field);
+    benchmark::DoNotOptimize(field[n - 1][n - 1]);
+  }
+  set_counters(state, filename);
+}
+
+static void BM_read_stod(benchmark::State &state) { run_read(state, read_stod); }
+BENCHMARK(BM_read_stod)->Apply(text_sizes);
+
+static void BM_read(benchmark::State &state) {
+  run_read(state, [](const std::filesystem::path &filename, phase_field::Field2D &field) {
+    phase_field::io::read(filename, field);
+  });
+}
+BENCHMARK(BM_read)->Apply(text_sizes);
+
+static void BM_write(benchmark::State &state) {
+  const auto n = static_cast<std::size_t>(state.range(0));
+  const auto field = get_field(n);
+  const auto filename = temp_path("write", n).replace_extension(".dat");
+  for (auto _ : state) {
+    phase_field::io::write(filename, field, true);
+  }
+  set_counters(state, filename);
+  std::filesystem::remove(filename);
+}
+BENCHMARK(BM_write)->Apply(text_sizes);
+
+static void BM_read_snapshot(benchmark::State &state) {
+  const auto n = static_cast<std::size_t>(state.range(0));
+  const auto filename = get_pfs(n);
+  phase_field::Field2D field;
+  for (auto _ : state) {
+    phase_field::io::read_snapshot(filename, field);
+    benchmark::DoNotOptimize(field[n - 1][n - 1]);
+  }
+  set_counters(state, filename);
+}
+BENCHMARK(BM_read_snapshot)->Apply(io_sizes);
+
+static void BM_write_snapshot(benchmark::State &state) {
+  const auto n = static_cast<std::size_t>(state.range(0));
+  const auto field = get_field(n);
+  const auto filename = temp_path("write", n).replace_extension(".pfs");
+  for (auto _ : state) {
+    phase_field::io::write_snapshot(filename, field, {}, true);
+  }
+  set_counters(state, filename);
+  std::filesystem::remove(filename);
+}
+BENCHMARK(BM_write_snapshot)->Apply(io_sizes);
+
+BENCHMARK_MAIN();
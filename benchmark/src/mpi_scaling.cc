@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2025 Materials Modelling Lab, The University of Tokyo
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <benchmark/benchmark.h>
+#include <phase_field/mpi.hh>
+#include <phase_field/phase_field.hh>
+#include <phase_field/util.hh>
+#include <iostream>
+
+/*
+ * Run with mpirun -np N. Every rank runs the same fixed number of iterations and the slowest
+ * rank sets the time, so the reported numbers are those of the whole job.
+ */
+
+static phase_field::Param get_param() {
+  phase_field::Param p = phase_field::get_pure_ni_param();
+  p.lambda = 16.0;
+  p.u = -0.2;
+  p.setup();
+  return p;
+}
+
+static void run(benchmark::State &state, const int64_t ny, const int64_t nx) {
+  const auto p = get_param();
+  const phase_field::mpi::BlockDecomposition2D decomp(MPI_COMM_WORLD, ny, nx);
+  const phase_field::mpi::DistributedPhaseField2D system(p, decomp);
+  auto phi = decomp.make_field();
+  auto phi_next = decomp.make_field();
+  {
+    phase_field::Field2D global;
+    if (decomp.rank() == 0) {
+      global.resize({static_cast<std::size_t>(ny), static_cast<std::size_t>(nx)});
+      phase_field::set_nuclear_to_corner(global, std::min(ny, nx) / 4);
+    }
+    decomp.scatter(global, phi);
+  }
+
+  for (auto _ : state) {
+    MPI_Barrier(decomp.comm());
+    const double start = MPI_Wtime();
+    system.predict(phi, phi_next);
+    std::swap(phi, phi_next);
+    double elapsed = MPI_Wtime() - start;
+    MPI_Allreduce(MPI_IN_PLACE, &elapsed, 1, MPI_DOUBLE, MPI_MAX, decomp.comm());
+    state.SetIterationTime(elapsed);
+  }
+  state.counters["ranks"] = decomp.size();
+  state.counters["cells"] = benchmark::Counter(static_cast<double>(state.iterations() * ny * nx),
+                                               benchmark::Counter::kIsRate);
+}
+
+/* Fixed global grid of range(0)^2 */
+static void BM_strong_scaling(benchmark::State &state) {
+  run(state, state.range(0), state.range(0));
+}
+BENCHMARK(BM_strong_scaling)
+    ->RangeMultiplier(4)
+    ->Range(256, 4096)
+    ->Iterations(50)
+    ->UseManualTime()
+    ->Unit(benchmark::kMillisecond);
+
+/* Fixed block of range(0)^2 per rank */
+static void BM_weak_scaling(benchmark::State &state) {
+  int dims[2] = {0, 0};
+  int size;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  MPI_Dims_create(size, 2, dims);
+  run(state, state.range(0) * dims[0], state.range(0) * dims[1]);
+}
+BENCHMARK(BM_weak_scaling)
+    ->RangeMultiplier(4)
+    ->Range(256, 4096)
+    ->Iterations(50)
+    ->UseManualTime()
+    ->Unit(benchmark::kMillisecond);
+
+/* Compare a few distributed steps with PhaseField2D on the gathered field */
+static bool validate(const int64_t n) {
+  const auto p = get_param();
+  const phase_field::mpi::BlockDecomposition2D decomp(MPI_COMM_WORLD, n, n);
+  const phase_field::mpi::DistributedPhaseField2D system(p, decomp);
+  phase_field::Field2D global({static_cast<std::size_t>(n), static_cast<std::size_t>(n)});
+  phase_field::set_nuclear_to_corner(global, n / 3);
+  auto phi = decomp.make_field();
+  auto phi_next = decomp.make_field();
+  decomp.scatter(global, phi);
+
+  const phase_field::PhaseField2D reference(p);
+  auto global_next = phase_field::Field2D::like(global);
+  for (int step = 0; step < 10; ++step) {
+    system.predict(phi, phi_next);
+    std::swap(phi, phi_next);
+    if (decomp.rank() == 0) {
+      reference.predict(global, global_next);
+      std::swap(global, global_next);
+    }
+  }
+
+  phase_field::Field2D gathered;
+  decomp.gather(phi, gathered);
+  int ok = 1;
+  if (decomp.rank() == 0) {
+    for (int64_t y = 0; y < n; ++y) {
+      for (int64_t x = 0; x < n; ++x) {
+        ok &= gathered[y][x] == global[y][x];
+      }
+    }
+  }
+  MPI_Bcast(&ok, 1, MPI_INT, 0, MPI_COMM_WORLD);
+  return ok;
+}
+
+class NullReporter : public benchmark::BenchmarkReporter {
+public:
+  bool ReportContext(const Context &) override { return true; }
+  void ReportRuns(const std::vector<Run> &) override {}
+};
+
+int main(int argc, char **argv) {
+  int provided;
+  MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &provided);
+  int rank;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  if (!validate(97)) {
+    if (rank == 0) {
+      std::cerr << "distributed predict differs from PhaseField2D::predict" << std::endl;
+    }
+    MPI_Abort(MPI_COMM_WORLD, EXIT_FAILURE);
+  }
+
+  benchmark::Initialize(&argc, argv);
+  if (rank == 0) {
+    benchmark::RunSpecifiedBenchmarks();
+  } else {
+    NullReporter null;
+    benchmark::RunSpecifiedBenchmarks(&null);
+  }
+  benchmark::Shutdown();
+  MPI_Finalize();
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2025 Materials Modelling Lab, The University of Tokyo
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <benchmark/benchmark.h>
+#include <phase_field/narrow_band.hh>
+#include <phase_field/phase_field.hh>
+#include <phase_field/util.hh>
+
+static phase_field::Param get_param() {
+  phase_field::Param p = phase_field::get_pure_ni_param();
+  p.lambda = 16.0;
+  p.u = -0.2;
+  p.setup();
+  return p;
+}
+
+/* A single nucleus in the corner of a range(0)^2 grid, stepped as a ping-pong pair */
+template <typename System> static void run(benchmark::State &state, const System &system) {
+  const auto n = static_cast<std::size_t>(state.range(0));
+  phase_field::Field2D phi({n, n});
+  phase_field::set_nuclear_to_corner(phi, 32);
+  auto phi_next = phase_field::Field2D::like(phi);
+  for (int i = 0; i < 20; ++i) {
+    system.predict(phi, phi_next);
+    std::swap(phi, phi_next);
+  }
+  for (auto _ : state) {
+    system.predict(phi, phi_next);
+    std::swap(phi, phi_next);
+  }
+  state.SetItemsProcessed(state.iterations() * n * n);
+}
+
+static void BM_predict_full(benchmark::State &state) {
+  const phase_field::PhaseField2D system(get_param());
+  run(state, system);
+}
+BENCHMARK(BM_predict_full)->RangeMultiplier(2)->Range(512, 4096)->Unit(benchmark::kMillisecond);
+
+static void BM_predict_narrow_band(benchmark::State &state) {
+  const phase_field::NarrowBandPhaseField2D system(get_param());
+  run(state, system);
+  state.counters["active"] = system.active_fraction();
+}
+BENCHMARK(BM_predict_narrow_band)
+    ->RangeMultiplier(2)
+    ->Range(512, 4096)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
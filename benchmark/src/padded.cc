@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2025 Materials Modelling Lab, The University of Tokyo
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <bench.hh>
+#include <phase_field/padded.hh>
+#include <phase_field/phase_field.hh>
+#include <phase_field/util.hh>
+
+/*
+ * Ghost cell padded fields on a range(0)^2 grid, for every boundary kind:
+ *   BM_fill:  filling the ghost layers alone, cells/s counting the cells of the interior
+ *   BM_step:  a step of PaddedPhaseField2D, fill included, next to the zero padded
+ *             PhaseField2D::advance as the baseline
+ * The boundaries themselves are checked by test-padded.
+ */
+namespace {
+using phase_field::Boundaries2D;
+using phase_field::Boundary;
+using phase_field::PaddedField2D;
+using phase_field::PaddedPhaseField2D;
+using phase_field::PaddedPingPong2D;
+
+constexpr std::size_t n_steps = 8;
+constexpr double liquid = phase_field::FieldState::liquid;
+
+enum Kind { mirror, periodic, dirichlet };
+
+Boundaries2D get_boundaries(const Kind kind) {
+  switch (kind) {
+  case mirror:
+    return Boundaries2D(Boundary::mirror());
+  case periodic:
+    return Boundaries2D(Boundary::periodic());
+  default:
+    return Boundaries2D(Boundary::dirichlet(liquid));
+  }
+}
+} // namespace
+
+static void BM_fill(benchmark::State &state, const Kind kind) {
+  const auto n = static_cast<std::size_t>(state.range(0));
+  const auto b = get_boundaries(kind);
+  PaddedField2D phi(bench::get_initial(n, n));
+  for (auto _ : state) {
+#pragma omp parallel
+    phi.fill(b);
+    benchmark::ClobberMemory();
+  }
+  const double ghost = static_cast<double>(4 * PaddedField2D::ghost * (n + PaddedField2D::ghost));
+  bench::set_counters(state, static_cast<double>(n * n), 0);
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * ghost * sizeof(bench::T)));
+}
+
+static void BM_step(benchmark::State &state, const Kind kind) {
+  const auto n = static_cast<std::size_t>(state.range(0));
+  const PaddedPhaseField2D system(bench::get_param(), get_boundaries(kind));
+  PaddedPingPong2D fields{PaddedField2D(bench::get_initial(n, n))};
+  for (auto _ : state) {
+    system.advance(fields, n_steps);
+  }
+  bench::set_counters(state, static_cast<double>(n * n * n_steps), 2);
+}
+
+static void BM_step_zero(benchmark::State &state) {
+  const auto n = static_cast<std::size_t>(state.range(0));
+  const phase_field::PhaseField2D system(bench::get_param());
+  phase_field::PingPong2D fields(bench::get_initial(n, n));
+  for (auto _ : state) {
+    system.advance(fields, n_steps);
+  }
+  bench::set_counters(state, static_cast<double>(n * n * n_steps), 2);
+}
+
+static void sizes(benchmark::internal::Benchmark *b) {
+  b->Arg(256)->Arg(1024)->Arg(4096)->UseRealTime();
+}
+
+BENCHMARK_CAPTURE(BM_fill, mirror, mirror)->Apply(sizes);
+BENCHMARK_CAPTURE(BM_fill, periodic, periodic)->Apply(sizes);
+BENCHMARK_CAPTURE(BM_fill, dirichlet, dirichlet)->Apply(sizes);
+BENCHMARK(BM_step_zero)->Apply(sizes)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_step, mirror, mirror)->Apply(sizes)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_step, periodic, periodic)->Apply(sizes)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_step, dirichlet, dirichlet)->Apply(sizes)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2025 Materials Modelling Lab, The University of Tokyo
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <bench.hh>
+#include <phase_field/padded.hh>
+#include <phase_field/polycrystal.hh>
+#include <phase_field/util.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+/*
+ * Polycrystals on a range(0)^2 grid:
+ *   BM_grains: range(1) grains of random orientation filling the grid as a Voronoi tessellation
+ *              of seeds jittered on a square lattice, so every grain boundary is there from the
+ *              start. Reports
+ *                bytes_per_cell:       grains and per step buffers of the solver
+ *                dense_bytes_per_cell: two dense fields per grain, what storing all would take
+ *                occupancy:            mean grains listed per cell
+ *                overflow:             relistings with more grains near than slots, per cell step
+ *   BM_single: one grain of orientation 0 from a corner nucleus. Before it is timed it checks
+ *              the solver against PaddedPhaseField2D with mirror boundaries and reports the
+ *              largest difference as max_diff, failing above 1e-3; the grains below the
+ *              threshold dropped by the solver make up the difference.
+ */
+namespace {
+using phase_field::GrainField2D;
+using phase_field::PolycrystalPhaseField2D;
+
+constexpr std::size_t n_steps = 8;
+constexpr std::size_t n_relax = 20;
+constexpr std::size_t n_check = 300;
+
+std::vector<double> get_orientations(const std::size_t grains) {
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<double> angle(0.0, M_PI / 2.0);
+  std::vector<double> ret(grains);
+  for (auto &theta : ret) {
+    theta = angle(rng);
+  }
+  return ret;
+}
+
+/* Voronoi tessellation of s x s seeds, s^2 = grains, each listing the grains within two cells */
+GrainField2D get_voronoi(const int64_t n, const int64_t grains) {
+  const auto s = static_cast<int64_t>(std::lround(std::sqrt(static_cast<double>(grains))));
+  const double pitch = static_cast<double>(n) / static_cast<double>(s);
+  std::mt19937 rng(2);
+  std::uniform_real_distribution<double> jitter(0.0, pitch);
+  std::vector<double> sy(static_cast<std::size_t>(s * s)), sx(sy.size());
+  for (int64_t i = 0; i < s * s; ++i) {
+    sy[static_cast<std::size_t>(i)] = static_cast<double>(i / s) * pitch + jitter(rng);
+    sx[static_cast<std::size_t>(i)] = static_cast<double>(i % s) * pitch + jitter(rng);
+  }
+  /* Nearest seed, searched in the 3 x 3 lattice cells around */
+  std::vector<int32_t> owner(static_cast<std::size_t>(n * n));
+#pragma omp parallel for
+  for (int64_t y = 0; y < n; ++y) {
+    for (int64_t x = 0; x < n; ++x) {
+      const auto ly = static_cast<int64_t>(static_cast<double>(y) / pitch);
+      const auto lx = static_cast<int64_t>(static_cast<double>(x) / pitch);
+      double best = HUGE_VAL;
+      for (int64_t iy = std::max<int64_t>(0, ly - 1); iy <= std::min(s - 1, ly + 1); ++iy) {
+        for (int64_t ix = std::max<int64_t>(0, lx - 1); ix <= std::min(s - 1, lx + 1); ++ix) {
+          const auto i = static_cast<std::size_t>(iy * s + ix);
+          const double dy = static_cast<double>(y) + 0.5 - sy[i];
+          const double dx = static_cast<double>(x) + 0.5 - sx[i];
+          if (dy * dy + dx * dx < best) {
+            best = dy * dy + dx * dx;
+            owner[static_cast<std::size_t>(y * n + x)] = static_cast<int32_t>(i);
+          }
+        }
+      }
+    }
+  }
+  GrainField2D ret(n, n);
+#pragma omp parallel for
+  for (int64_t y = 0; y < n; ++y) {
+    for (int64_t x = 0; x < n; ++x) {
+      const int32_t own = owner[static_cast<std::size_t>(y * n + x)];
+      ret.set(y, x, own, phase_field::FieldState::solid);
+      for (int64_t dy = -2; dy <= 2; ++dy) {
+        for (int64_t dx = std::abs(dy) - 2; dx <= 2 - std::abs(dy); ++dx) {
+          const int64_t py = std::clamp<int64_t>(y + dy, 0, n - 1);
+          const int64_t px = std::clamp<int64_t>(x + dx, 0, n - 1);
+          const int32_t g = owner[static_cast<std::size_t>(py * n + px)];
+          if (g != own) {
+            ret.set(y, x, g, ret.get(y, x, g)); // a full cell leaves it out
+          }
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+double check_single(const std::size_t n) {
+  const auto r = static_cast<int64_t>(n / 4);
+  const auto p = bench::get_param();
+  GrainField2D grains(static_cast<int64_t>(n), static_cast<int64_t>(n));
+  grains.set_nuclear(0, 0, r, 0);
+  PolycrystalPhaseField2D(p, {0.0}).advance(grains, n_check);
+  phase_field::Field2D a({n, n});
+  grains.to_field(a);
+
+  const phase_field::PaddedPhaseField2D ref(
+      p, phase_field::Boundaries2D(phase_field::Boundary::mirror()));
+  phase_field::PaddedPingPong2D fields{phase_field::PaddedField2D(bench::get_initial(n, n))};
+  ref.advance(fields, n_check);
+  phase_field::Field2D b = phase_field::Field2D::like(a);
+  fields.current().copy_to(b);
+
+  double ret = 0.0;
+  for (std::size_t y = 0; y < n; ++y) {
+    for (std::size_t x = 0; x < n; ++x) {
+      const double d = std::abs(a[y][x] - b[y][x]);
+      ret = std::isnan(d) ? HUGE_VAL : std::max(ret, d);
+    }
+  }
+  return ret;
+}
+
+void set_counters(benchmark::State &state, const PolycrystalPhaseField2D &system,
+                  const GrainField2D &grains, const std::size_t n_grains) {
+  const auto n = static_cast<double>(state.range(0));
+  const double bytes_per_cell = static_cast<double>(grains.bytes() + system.bytes()) / (n * n);
+  /* Grains and buffers are each read or written once per step */
+  bench::set_counters(state, n * n * n_steps, bytes_per_cell / sizeof(bench::T));
+  state.counters["bytes_per_cell"] = bytes_per_cell;
+  state.counters["dense_bytes_per_cell"] = static_cast<double>(2 * n_grains * sizeof(bench::T));
+  state.counters["occupancy"] = grains.occupancy();
+  state.counters["overflow"] = static_cast<double>(system.overflowed()) / (n * n * n_steps);
+}
+} // namespace
+
+static void BM_grains(benchmark::State &state) {
+  const auto n = state.range(0);
+  const auto n_grains = static_cast<std::size_t>(state.range(1));
+  const PolycrystalPhaseField2D system(bench::get_param(), get_orientations(n_grains));
+  GrainField2D grains = get_voronoi(n, state.range(1));
+  system.advance(grains, n_relax);
+  for (auto _ : state) {
+    system.advance(grains, n_steps);
+  }
+  set_counters(state, system, grains, n_grains);
+}
+
+static void BM_single(benchmark::State &state) {
+  const auto n = static_cast<std::size_t>(state.range(0));
+  const double max_diff = check_single(std::min<std::size_t>(n, 128));
+  state.counters["max_diff"] = max_diff;
+  if (!(max_diff <= 1e-3)) {
+    state.SkipWithError(
+        ("single grain check failed, max_diff " + std::to_string(max_diff)).c_str());
+    return;
+  }
+
+  const PolycrystalPhaseField2D system(bench::get_param(), {0.0});
+  GrainField2D grains(state.range(0), state.range(0));
+  grains.set_nuclear(0, 0, static_cast<int64_t>(n / 4), 0);
+  for (auto _ : state) {
+    system.advance(grains, n_steps);
+  }
+  set_counters(state, system, grains, 1);
+}
+
+BENCHMARK(BM_single)->Arg(256)->Arg(1024)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_grains)
+    ->ArgsProduct({{1024}, {1, 16, 256, 4096}})
+    ->ArgNames({"n", "grains"})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2025 Materials Modelling Lab, The University of Tokyo
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <bench.hh>
+#include <phase_field/phase_field.hh>
+#include <phase_field/util.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <vector>
+
+/*
+ * Validation of the float and mixed precision solvers against double. A dendrite grows from a
+ * nucleus in the centre of a range(0)^2 grid for n_steps steps, stopping before it meets the
+ * solid the zero padded boundary nucleates. Every precision reports
+ *   v_tip:    velocity of the tip along +x over the second half of the run [m/s]
+ *   dv_tip:   relative difference of v_tip to double
+ *   shape:    largest offset of the interface (phi = 0) from the double one along a row [cells]
+ *   max_dphi: largest difference of phi to double
+ * next to the throughput. The double case checks itself and reports zero differences.
+ */
+namespace {
+using phase_field::BasicField2D;
+using phase_field::Field2D;
+
+constexpr std::size_t n_steps = 3000;
+constexpr int64_t radius = 8;
+
+/*
+ * Position of phi = 0 along every row of the crystal, interpolated where phi first turns
+ * negative to the right of the centre column; NaN for rows outside the crystal
+ */
+template <typename S> std::vector<double> get_front(const BasicField2D<S> &phi) {
+  const auto ny = phi.shape()[0];
+  const auto nx = phi.shape()[1];
+  std::vector<double> ret(ny, std::nan(""));
+  for (std::size_t y = 0; y < ny; ++y) {
+    const auto &row = phi[y];
+    for (std::size_t x = nx / 2; x + 1 < nx && row[nx / 2] >= 0; ++x) {
+      const double a = row[x];
+      const double b = row[x + 1];
+      if (b < 0.0) {
+        ret[y] = static_cast<double>(x) + a / (a - b);
+        break;
+      }
+    }
+  }
+  return ret;
+}
+
+struct Outcome {
+  double v_tip = 0.0;
+  std::vector<double> front;
+  Field2D phi;
+};
+
+template <typename S, typename A> Outcome simulate(const std::size_t n) {
+  const auto p = bench::get_param();
+  const phase_field::BasicPhaseField2D<S, A> system(p);
+  Field2D initial({n, n});
+  phase_field::set_nuclear(initial, n / 2, n / 2, radius);
+  BasicField2D<S> phi;
+  phase_field::convert(initial, phi);
+  auto phi_next = BasicField2D<S>::like(phi);
+
+  double tip_half = 0.0;
+  for (std::size_t step = 0; step < n_steps; ++step) {
+    if (step == n_steps / 2) {
+      tip_half = get_front(phi)[n / 2];
+    }
+    system.predict(phi, phi_next);
+    std::swap(phi, phi_next);
+  }
+
+  Outcome ret;
+  ret.front = get_front(phi);
+  ret.v_tip = (ret.front[n / 2] - tip_half) * p.dx / (static_cast<double>(n_steps / 2) * p.dt);
+  phase_field::convert(phi, ret.phi);
+  return ret;
+}
+
+/* The double run of each size, computed once */
+const Outcome &reference(const std::size_t n) {
+  static std::map<std::size_t, Outcome> cache;
+  auto it = cache.find(n);
+  if (it == cache.end()) {
+    it = cache.emplace(n, simulate<double, double>(n)).first;
+  }
+  return it->second;
+}
+} // namespace
+
+template <typename S, typename A> static void BM_precision(benchmark::State &state) {
+  const auto n = static_cast<std::size_t>(state.range(0));
+  const auto &ref = reference(n);
+  Outcome out;
+  for (auto _ : state) {
+    out = simulate<S, A>(n);
+  }
+
+  double shape = 0.0;
+  for (std::size_t y = 0; y < n; ++y) {
+    if (std::isnan(ref.front[y]) != std::isnan(out.front[y])) {
+      shape = std::numeric_limits<double>::infinity();
+    } else if (!std::isnan(ref.front[y])) {
+      shape = std::max(shape, std::abs(out.front[y] - ref.front[y]));
+    }
+  }
+  double max_dphi = 0.0;
+  for (std::size_t y = 0; y < n; ++y) {
+    for (std::size_t x = 0; x < n; ++x) {
+      max_dphi = std::max(max_dphi, std::abs(out.phi[y][x] - ref.phi[y][x]));
+    }
+  }
+
+  const double cells = static_cast<double>(n * n);
+  state.counters["cells/s"] =
+      benchmark::Counter(cells * n_steps, benchmark::Counter::kIsIterationInvariantRate);
+  state.SetBytesProcessed(
+      static_cast<int64_t>(state.iterations() * n_steps * 2 * cells * sizeof(S)));
+  state.counters["v_tip"] = out.v_tip;
+  state.counters["dv_tip"] = std::abs(out.v_tip - ref.v_tip) / std::abs(ref.v_tip);
+  state.counters["shape"] = shape;
+  state.counters["max_dphi"] = max_dphi;
+}
+
+static void sizes(benchmark::internal::Benchmark *b) {
+  b->Arg(256)->Arg(512)->Iterations(1)->UseRealTime()->Unit(benchmark::kMillisecond);
+}
+
+BENCHMARK_TEMPLATE(BM_precision, double, double)->Name("BM_precision/double")->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_precision, float, float)->Name("BM_precision/float")->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_precision, float, double)->Name("BM_precision/mixed")->Apply(sizes);
+
+BENCHMARK_MAIN();
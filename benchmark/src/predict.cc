@@ -3,25 +3,103 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
-#include <benchmark/benchmark.h>
+#include <bench.hh>
 #include <phase_field/phase_field.hh>
 #include <phase_field/util.hh>
 
+/*
+ * One step of a range(0)^2 grid. The field is stepped as a ping-pong pair instead of being reset
+ * under PauseTiming, whose overhead swamps the step on small grids. predict reads phi and writes
+ * the next field: two arrays per cell.
+ */
+template <typename S = bench::T, typename Step>
+static void run(benchmark::State &state, Step &&step) {
+  const auto n = static_cast<std::size_t>(state.range(0));
+  phase_field::BasicField2D<S> phi;
+  phase_field::convert(bench::get_initial(n, n), phi);
+  auto phi_next = phase_field::BasicField2D<S>::like(phi);
+  step(phi, phi_next);
+  std::swap(phi, phi_next);
+  for (auto _ : state) {
+    step(phi, phi_next);
+    std::swap(phi, phi_next);
+  }
+  bench::set_counters(state, static_cast<double>(n * n), 2.0 * sizeof(S) / sizeof(bench::T));
+}
+
 static void BM_predict(benchmark::State &state) {
-  phase_field::Param p = phase_field::get_pure_ni_param();
-  p.lambda = 16.0;
-  p.u = -0.2;
-  p.setup();
-  phase_field::PhaseField2D system(p);
-  phase_field::Field2D phi({100, 100});
-  auto phi_next = phase_field::Field2D::like(phi);
+  const phase_field::PhaseField2D system(bench::get_param());
+  run(state, [&](const auto &phi, auto &ret) { system.predict(phi, ret); });
+}
+BENCHMARK(BM_predict)
+    ->Apply([](auto *b) { bench::sizes(b); })
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+/* predict looped by advance in a single parallel region; an iteration is n_steps steps */
+static void BM_advance(benchmark::State &state) {
+  constexpr std::size_t n_steps = 16;
+  const auto n = static_cast<std::size_t>(state.range(0));
+  const phase_field::PhaseField2D system(bench::get_param());
+  phase_field::PingPong2D fields(bench::get_initial(n, n));
   for (auto _ : state) {
-    state.PauseTiming();
-    phase_field::set_nuclear_to_corner(phi, 10);
-    state.ResumeTiming();
-    system.predict(phi, phi_next);
+    system.advance(fields, n_steps);
   }
+  bench::set_counters(state, static_cast<double>(n * n * n_steps), 2);
+}
+BENCHMARK(BM_advance)
+    ->Apply([](auto *b) { bench::sizes(b); })
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+/* phi in float, computed in float or in double; the bandwidth counts 4 byte cells */
+template <typename System> static void BM_predict_precision(benchmark::State &state) {
+  const System system(bench::get_param());
+  run<float>(state, [&](const auto &phi, auto &ret) { system.predict(phi, ret); });
+}
+BENCHMARK_TEMPLATE(BM_predict_precision, phase_field::FloatPhaseField2D)
+    ->Name("BM_predict_float")
+    ->Apply([](auto *b) { bench::sizes(b); })
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_predict_precision, phase_field::MixedPhaseField2D)
+    ->Name("BM_predict_mixed")
+    ->Apply([](auto *b) { bench::sizes(b); })
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+/* The term by term path keeps about twenty temporaries, hence the smaller largest grid */
+static void BM_predict_reference(benchmark::State &state) {
+  const phase_field::PhaseField2D system(bench::get_param());
+  run(state, [&](const auto &phi, auto &ret) { system.predict_reference(phi, ret); });
+}
+BENCHMARK(BM_predict_reference)
+    ->Apply([](auto *b) { bench::sizes(b, 2048); })
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+/* predict with the stability reduction used by AdaptiveStepper */
+static void BM_predict_adaptive(benchmark::State &state) {
+  const auto p = bench::get_param();
+  const phase_field::PhaseField2D system(p);
+  run(state, [&](const auto &phi, auto &ret) {
+    benchmark::DoNotOptimize(system.predict(phi, ret, p.dt));
+  });
+}
+BENCHMARK(BM_predict_adaptive)
+    ->Apply([](auto *b) { bench::sizes(b); })
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+/* OpenMP scaling of the fused step on a cache resident and a memory bound grid */
+static void BM_predict_threads(benchmark::State &state) {
+  const bench::Threads threads(state.range(1));
+  const phase_field::PhaseField2D system(bench::get_param());
+  run(state, [&](const auto &phi, auto &ret) { system.predict(phi, ret); });
 }
-BENCHMARK(BM_predict)->Iterations(1000);
+BENCHMARK(BM_predict_threads)
+    ->Apply([](auto *b) { bench::thread_scaling(b, {512, 4096}); })
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
 
-BENCHMARK_MAIN();
\ No newline at end of file
+BENCHMARK_MAIN();
@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) 2025 Materials Modelling Lab, The University of Tokyo
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <benchmark/benchmark.h>
+#include <phase_field/phase_field_3d.hh>
+#include <phase_field/util.hh>
+
+static void BM_predict3d(benchmark::State &state) {
+  phase_field::Param p = phase_field::get_pure_ni_param();
+  p.lambda = 16.0;
+  p.u = -0.2;
+  p.setup();
+  const phase_field::PhaseField3D system(p);
+  const auto n = static_cast<std::size_t>(state.range(0));
+  phase_field::Field3D phi({n, n, n});
+  phase_field::set_nuclear_to_corner(phi, n / 4);
+  auto phi_next = phase_field::Field3D::like(phi);
+  for (auto _ : state) {
+    system.predict(phi, phi_next);
+    benchmark::ClobberMemory();
+  }
+  const auto cells = static_cast<int64_t>(n * n * n);
+  state.SetItemsProcessed(state.iterations() * cells);
+  /* phi is read once and ret is written once per step */
+  state.SetBytesProcessed(state.iterations() * cells * 2 * sizeof(double));
+}
+BENCHMARK(BM_predict3d)->RangeMultiplier(2)->Range(32, 256)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
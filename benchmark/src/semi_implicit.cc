@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2025 Materials Modelling Lab, The University of Tokyo
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <bench.hh>
+#include <phase_field/padded.hh>
+#include <phase_field/phase_field.hh>
+#include <phase_field/semi_implicit.hh>
+#include <phase_field/util.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+
+/*
+ * Time to a fixed physical time, explicit against semi-implicit. A dendrite grows from a nucleus
+ * in the centre of a range(0)^2 grid up to t_end = n_base steps of the default dt, taken as
+ * n_base / range(1) steps of range(1) times the default dt. An iteration is the whole run, so
+ * the time of the case is the time to t_end. Every case reports
+ *   steps:    steps taken
+ *   d_tip:    offset of the tip along +x from the explicit run at the default dt [cells]
+ *   max_dphi: largest difference of phi to that run
+ * The explicit solver goes unstable somewhere above dt_scale 30, where d_tip turns inf. It runs
+ * as PaddedPhaseField2D with mirror boundaries, the boundaries of the semi-implicit solver.
+ */
+namespace {
+using phase_field::Field2D;
+
+constexpr std::size_t n_base = 3000;
+constexpr int64_t radius = 8;
+
+/* Position of phi = 0 to the right of the centre along the centre row, inf if none */
+double get_tip(const Field2D &phi) {
+  const auto n = phi.shape()[1];
+  const auto &row = phi[phi.shape()[0] / 2];
+  for (std::size_t x = n / 2; x + 1 < n; ++x) {
+    const double a = row[x];
+    const double b = row[x + 1];
+    if (a >= 0.0 && b < 0.0) {
+      return static_cast<double>(x) + a / (a - b);
+    }
+  }
+  return std::numeric_limits<double>::infinity();
+}
+
+struct Explicit {
+  static Field2D run(const phase_field::Param &p, Field2D &&initial, const std::size_t steps) {
+    const phase_field::PaddedPhaseField2D system(
+        p, phase_field::Boundaries2D(phase_field::Boundary::mirror()));
+    phase_field::PaddedPingPong2D fields{phase_field::PaddedField2D(initial)};
+    system.advance(fields, steps);
+    fields.current().copy_to(initial);
+    return std::move(initial);
+  }
+};
+
+struct SemiImplicit {
+  static Field2D run(const phase_field::Param &p, Field2D &&initial, const std::size_t steps) {
+    const phase_field::SemiImplicitPhaseField2D system(p);
+    phase_field::PingPong2D fields(std::move(initial));
+    system.advance(fields, steps);
+    return std::move(fields.current());
+  }
+};
+
+template <typename System> Field2D simulate(const std::size_t n, const int64_t scale) {
+  auto p = bench::get_param();
+  p.dt *= static_cast<double>(scale);
+  Field2D initial({n, n});
+  phase_field::set_nuclear(initial, n / 2, n / 2, radius);
+  return System::run(p, std::move(initial), n_base / static_cast<std::size_t>(scale));
+}
+
+/* The explicit run at the default dt of each size, computed once */
+const Field2D &reference(const std::size_t n) {
+  static std::map<std::size_t, Field2D> cache;
+  auto it = cache.find(n);
+  if (it == cache.end()) {
+    it = cache.emplace(n, simulate<Explicit>(n, 1)).first;
+  }
+  return it->second;
+}
+} // namespace
+
+template <typename System> static void BM_time_to_solution(benchmark::State &state) {
+  const auto n = static_cast<std::size_t>(state.range(0));
+  const auto scale = state.range(1);
+  const auto &ref = reference(n);
+  Field2D phi;
+  for (auto _ : state) {
+    phi = simulate<System>(n, scale);
+  }
+
+  double max_dphi = 0.0;
+  for (std::size_t y = 0; y < n; ++y) {
+    for (std::size_t x = 0; x < n; ++x) {
+      max_dphi = std::max(max_dphi, std::abs(phi[y][x] - ref[y][x]));
+    }
+  }
+  const auto steps = n_base / static_cast<std::size_t>(scale);
+  bench::set_counters(state, static_cast<double>(n * n * steps), 2);
+  state.counters["steps"] = static_cast<double>(steps);
+  state.counters["d_tip"] = std::abs(get_tip(phi) - get_tip(ref));
+  state.counters["max_dphi"] = std::isfinite(max_dphi) ? max_dphi : HUGE_VAL;
+}
+
+BENCHMARK_TEMPLATE(BM_time_to_solution, Explicit)
+    ->Name("BM_time_to_solution/explicit")
+    ->ArgsProduct({{256, 512}, {1, 5, 10, 20, 30}})
+    ->ArgNames({"n", "dt_scale"})
+    ->Iterations(1)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_time_to_solution, SemiImplicit)
+    ->Name("BM_time_to_solution/semi_implicit")
+    ->ArgsProduct({{256, 512}, {1, 5, 10, 20, 40, 80}})
+    ->ArgNames({"n", "dt_scale"})
+    ->Iterations(1)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
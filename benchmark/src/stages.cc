@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2025 Materials Modelling Lab, The University of Tokyo
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <bench.hh>
+#include <phase_field/impl/derivative.hh>
+#include <phase_field/impl/functor.hh>
+#include <phase_field/phase_field.hh>
+
+/*
+ * The stages of PhaseField2D::predict_reference on their own, on range(0)^2 grids, with the same
+ * split as the profile stages (phase_field/profile.hh). The row kernels of the fused path are
+ * measured by bench-functor. Bandwidth counts every array a stage reads or writes once.
+ */
+namespace {
+using phase_field::Field2D;
+
+/* Inputs and outputs of every stage, computed once from a corner nucleus */
+struct Terms {
+  const phase_field::Param p = bench::get_param();
+  const phase_field::Filter2D dx = phase_field::get_dx_filter(p.dx);
+  const phase_field::Filter2D dy = phase_field::get_dy_filter(p.dx);
+  const phase_field::Filter2D lap = phase_field::get_laplacian_filter(p.dx);
+  Field2D phi, dphi_dx, dphi_dy, abs_n4_inv, n4, ac, ak, W, tau_inv, flux, term, next;
+
+  explicit Terms(const std::size_t n) : phi(bench::get_initial(n, n)) {
+    const phase_field::PhaseField2D system(p);
+    next = Field2D::like(phi);
+    system.predict(phi, next);
+    std::swap(phi, next);
+    for (auto *f : {&dphi_dx, &dphi_dy, &abs_n4_inv, &n4, &ac, &ak, &W, &tau_inv, &flux, &term}) {
+      *f = Field2D::like(phi);
+    }
+    gradient();
+    anisotropy();
+  }
+
+  void gradient() {
+    phase_field::conv2d(phi, dx, dphi_dx);
+    phase_field::conv2d(phi, dy, dphi_dy);
+  }
+
+  void anisotropy() {
+    abs_n4_inv.map(phase_field::InvAbsN4Functor(), dphi_dx, dphi_dy);
+    n4.map(phase_field::N4Functor(), dphi_dx, dphi_dy, abs_n4_inv);
+    ac.map(phase_field::AcFunctor(p.epsilon_c), n4);
+    ak.map(phase_field::AkFunctor(p.epsilon_k), n4);
+    W.map([this](Field2D::scalar_type &ret, const Field2D::scalar_type &a) { ret = p.W0 * a; },
+          ac);
+    tau_inv.map(phase_field::TauInvFunctor(p.tau0), ac, ak);
+  }
+};
+
+template <typename Stage>
+void run(benchmark::State &state, const double arrays, Stage &&stage) {
+  const auto n = static_cast<std::size_t>(state.range(0));
+  Terms t(n);
+  for (auto _ : state) {
+    stage(t);
+    benchmark::ClobberMemory();
+  }
+  bench::set_counters(state, static_cast<double>(n * n), arrays);
+}
+
+void sizes(benchmark::internal::Benchmark *b) {
+  bench::sizes(b, 4096);
+  b->UseRealTime()->Unit(benchmark::kMillisecond);
+}
+} // namespace
+
+/* dphi/dx and dphi/dy: two 3x3 convolutions */
+static void BM_stage_gradient(benchmark::State &state) {
+  run(state, 4, [](Terms &t) { t.gradient(); });
+}
+BENCHMARK(BM_stage_gradient)->Apply(sizes);
+
+/* 1 / |n|^4, n4, a_c, a_k, W, 1 / tau and the four anisotropic fluxes */
+static void BM_stage_anisotropy(benchmark::State &state) {
+  run(state, 16 + 3 + 3 + 5 + 5, [](Terms &t) {
+    t.anisotropy();
+    const phase_field::Aniso2Functor aniso2(t.p.W0);
+    const phase_field::Aniso3Functor aniso3(t.p.W0, t.p.epsilon_c);
+    t.flux.map(aniso2, t.W, t.dphi_dx);
+    t.flux.map(aniso2, t.W, t.dphi_dy);
+    t.flux.map(aniso3, t.W, t.dphi_dx, t.dphi_dy, t.abs_n4_inv);
+    t.flux.map(aniso3, t.W, t.dphi_dy, t.dphi_dx, t.abs_n4_inv);
+  });
+}
+BENCHMARK(BM_stage_anisotropy)->Apply(sizes);
+
+/* Laplacian, scaled by W0^2, and the derivatives of the four fluxes */
+static void BM_stage_divergence(benchmark::State &state) {
+  run(state, 4 + 4 * 2, [](Terms &t) {
+    phase_field::conv2d(t.phi, t.lap, t.term);
+    const auto W0_sq = t.p.W0 * t.p.W0;
+    t.term.map([W0_sq](Field2D::scalar_type &ret) { ret *= W0_sq; });
+    phase_field::conv2d(t.flux, t.dx, t.term);
+    phase_field::conv2d(t.flux, t.dy, t.term);
+    phase_field::conv2d(t.flux, t.dx, t.term);
+    phase_field::conv2d(t.flux, t.dy, t.term);
+  });
+}
+BENCHMARK(BM_stage_divergence)->Apply(sizes);
+
+/*
+ * Chemical potential, sum of the six terms, explicit step and clamp. Fields of the other stages
+ * stand in for the terms of the sum; only their number matters here.
+ */
+static void BM_stage_update(benchmark::State &state) {
+  run(state, 2 + 7 + 4 + 2, [](Terms &t) {
+    t.flux.map(phase_field::ChemPotFunctor(t.p.u, t.p.lambda), t.phi);
+    t.term.map(libtensor::functor::SumFunctor<Field2D::scalar_type>(), t.dphi_dx, t.dphi_dy,
+               t.abs_n4_inv, t.n4, t.ac, t.flux);
+    t.next.map(phase_field::PredictFunctor(t.p.dt), t.tau_inv, t.term, t.phi)
+        .map(phase_field::FieldClampFunctor());
+  });
+}
+BENCHMARK(BM_stage_update)->Apply(sizes);
+
+BENCHMARK_MAIN();
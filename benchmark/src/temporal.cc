@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2025 Materials Modelling Lab, The University of Tokyo
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <bench.hh>
+#include <phase_field/phase_field.hh>
+#include <phase_field/profile.hh>
+#include <phase_field/temporal.hh>
+
+#include <memory>
+#include <vector>
+
+/*
+ * Temporal blocking: TemporalPhaseField2D on a range(0)^2 grid with a block depth of range(1)
+ * steps, an iteration being n_steps steps. Besides cells/s (cell updates), every case reports
+ *   bytes/update:  bytes of phi moved between memory and the caches per cell update, modelled
+ *                  by TemporalPhaseField2D::bytes_per_update
+ *   llc/update:    last level cache misses per cell update, measured on every thread through
+ *                  perf_event; only in builds with -DENABLE_PROFILE=ON where the kernel allows it
+ * Depth 1 is the plain fused sweep, so the first case of each size is the baseline.
+ */
+namespace {
+constexpr std::size_t n_steps = 8;
+
+/* Cache misses of every OpenMP thread */
+class ThreadMisses {
+  std::vector<std::unique_ptr<phase_field::profile::PerfCounters>> perf;
+
+public:
+  ThreadMisses() : perf(static_cast<std::size_t>(omp_get_max_threads())) {
+#pragma omp parallel
+    perf[static_cast<std::size_t>(omp_get_thread_num())] =
+        std::make_unique<phase_field::profile::PerfCounters>();
+  }
+
+  inline bool available() const {
+    for (const auto &p : perf) {
+      if (!p || !p->available()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  inline double read() const {
+    double ret = 0.0;
+    for (const auto &p : perf) {
+      ret += static_cast<double>(p->read()[1]);
+    }
+    return ret;
+  }
+};
+} // namespace
+
+static void BM_temporal(benchmark::State &state) {
+  const auto n = static_cast<std::size_t>(state.range(0));
+  const auto depth = static_cast<std::size_t>(state.range(1));
+  const phase_field::TemporalPhaseField2D system(bench::get_param(), depth);
+  phase_field::PingPong2D fields(bench::get_initial(n, n));
+  system.advance(fields, depth);
+
+  const ThreadMisses misses;
+  const double start = misses.read();
+  for (auto _ : state) {
+    system.advance(fields, n_steps);
+  }
+  const double updates = static_cast<double>(state.iterations() * n * n * n_steps);
+
+  bench::set_counters(state, static_cast<double>(n * n * n_steps), 2);
+  state.counters["bytes/update"] =
+      system.bytes_per_update(static_cast<int64_t>(n), static_cast<int64_t>(n));
+  if (misses.available()) {
+    state.counters["llc/update"] = (misses.read() - start) / updates;
+  }
+}
+BENCHMARK(BM_temporal)
+    ->ArgsProduct({{512, 1024, 2048, 4096}, {1, 2, 4, 8}})
+    ->ArgNames({"n", "depth"})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2025 Materials Modelling Lab, The University of Tokyo
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <benchmark/benchmark.h>
+#include <phase_field/phase_field.hh>
+#include <phase_field/thermal.hh>
+#include <phase_field/util.hh>
+
+static phase_field::Param get_param() {
+  phase_field::Param p = phase_field::get_pure_ni_param();
+  p.lambda = 16.0;
+  p.u = -0.2;
+  p.setup();
+  return p;
+}
+
+static void BM_predict_thermal(benchmark::State &state) {
+  const auto p = get_param();
+  const phase_field::PhaseFieldThermal2D system(p, phase_field::get_pure_ni_thermal_param());
+  const auto n = static_cast<std::size_t>(state.range(0));
+  phase_field::Field2D phi({n, n});
+  phase_field::set_nuclear_to_corner(phi, 10);
+  auto u = phase_field::Field2D::like(phi);
+  u.map([&p](phase_field::Field2D::scalar_type &v) { v = p.u; });
+  auto phi_next = phase_field::Field2D::like(phi);
+  auto u_next = phase_field::Field2D::like(phi);
+  for (auto _ : state) {
+    system.predict(phi, u, phi_next, u_next);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n * n);
+}
+BENCHMARK(BM_predict_thermal)->RangeMultiplier(4)->Range(64, 4096)->Unit(benchmark::kMicrosecond);
+
+static void BM_predict_isothermal(benchmark::State &state) {
+  const phase_field::PhaseField2D system(get_param());
+  const auto n = static_cast<std::size_t>(state.range(0));
+  phase_field::Field2D phi({n, n});
+  phase_field::set_nuclear_to_corner(phi, 10);
+  auto phi_next = phase_field::Field2D::like(phi);
+  for (auto _ : state) {
+    system.predict(phi, phi_next);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n * n);
+}
+BENCHMARK(BM_predict_isothermal)
+    ->RangeMultiplier(4)
+    ->Range(64, 4096)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,624 @@
+/*
+ * Copyright (c) 2025 Materials Modelling Lab, The University of Tokyo
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __PHASE_FIELD__AMR__
+#define __PHASE_FIELD__AMR__
+
+#include "impl/kernel.hh"
+#include "impl/type.hh"
+#include "impl/workspace.hh"
+#include "param.hh"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace phase_field {
+struct AMRParam {
+  int64_t patch = 32;                    // cells along each side of a patch, without ghosts
+  int64_t levels = 3;                    // refinement levels above the root grid
+  int64_t regrid_interval = 20;          // steps between two regrids
+  Field2D::scalar_type threshold = 1e-6; // cells with |phi| < 1 - threshold hold the interface
+
+  NLOHMANN_DEFINE_TYPE_INTRUSIVE(AMRParam, patch, levels, regrid_interval, threshold);
+};
+
+/**
+ * @brief Block-structured adaptive mesh of the 2D phase field
+ *  The domain is covered by a grid of root blocks, each the root of a quadtree. Every leaf owns
+ *  a patch of (patch x patch) cells plus a two cell ghost layer, the stencil radius of the
+ *  fused kernel. Level l has the cell size dx 2^(levels - l), so the finest level keeps the
+ *  resolution of Param::dx.
+ *
+ *  Leaves holding the interface or touching the domain boundary, and their neighbours, are
+ *  refined to the finest level; the boundary is kept fine because its zero padding drives the
+ *  field there just like in PhaseField2D. Other leaves are coarsened one level per regrid.
+ *  Neighbouring leaves differ by at most one level (2:1 balance).
+ *
+ *  Ghost cells are filled from the neighbours: copied from a leaf of the same level, injected
+ *  from a coarser one and averaged over 2 x 2 cells of a finer one. Refinement prolongs by
+ *  injection and coarsening restricts by averaging. Both are first order, which is exact in the
+ *  uniform bulk where coarse leaves live. All leaves advance with the same dt (no subcycling).
+ *
+ *  Leaves are kept in Morton order of their position and distributed over OpenMP threads in
+ *  small dynamic chunks, so a thread works on nearby patches and the load follows regrids.
+ */
+class AMRPhaseField2D {
+public:
+  using T = Field2D::scalar_type;
+  static constexpr int64_t ghost = 2;
+
+  struct Patch {
+    int64_t level, by, bx;
+    Field2D cur, next;
+  };
+
+private:
+  /* A ghost cell is the weighted sum of interior cells of other patches */
+  struct Source {
+    int32_t patch;
+    int32_t y, x;
+    T weight;
+  };
+  struct Ghost {
+    int32_t y, x;
+    int32_t first, count;
+  };
+
+  const Param param;
+  const AMRParam cfg;
+  std::vector<FusedPredictKernel> kernels; // one per level, with its grid spacing
+  int64_t n0y = 0, n0x = 0;
+
+  std::unordered_map<uint64_t, Patch> leaves;
+  std::unordered_set<uint64_t> internal;
+  std::vector<Patch *> order;
+  std::vector<std::vector<Ghost>> ghosts;
+  std::vector<std::vector<Source>> sources;
+  PredictWorkspace workspace;
+  std::size_t n_steps = 0;
+
+  static inline uint64_t key(const int64_t l, const int64_t by, const int64_t bx) {
+    return (static_cast<uint64_t>(l) << 58) | (static_cast<uint64_t>(by) << 29) |
+           static_cast<uint64_t>(bx);
+  }
+
+  static inline uint64_t morton(const uint64_t y, const uint64_t x) {
+    uint64_t ret = 0;
+    for (int i = 0; i < 29; ++i) {
+      ret |= ((x >> i) & 1) << (2 * i);
+      ret |= ((y >> i) & 1) << (2 * i + 1);
+    }
+    return ret;
+  }
+
+  inline int64_t blocks_y(const int64_t l) const { return n0y << l; }
+  inline int64_t blocks_x(const int64_t l) const { return n0x << l; }
+  inline bool inside(const int64_t l, const int64_t by, const int64_t bx) const {
+    return 0 <= by && by < blocks_y(l) && 0 <= bx && bx < blocks_x(l);
+  }
+
+  inline Patch make_patch(const int64_t l, const int64_t by, const int64_t bx) const {
+    const auto n = static_cast<std::size_t>(cfg.patch + 2 * ghost);
+    return {l, by, bx, Field2D({n, n}), Field2D({n, n})};
+  }
+
+  /* Local cells holding phi; ghosts outside the domain are zero padding */
+  inline Box2D valid(const Patch &p) const {
+    const int64_t n = cfg.patch + 2 * ghost;
+    return {p.by == 0 ? ghost : 0, p.by == blocks_y(p.level) - 1 ? n - ghost : n,
+            p.bx == 0 ? ghost : 0, p.bx == blocks_x(p.level) - 1 ? n - ghost : n};
+  }
+
+  inline bool has_interface(const Patch &p) const {
+    const T bound = 1.0 - cfg.threshold;
+    for (int64_t y = ghost; y < ghost + cfg.patch; ++y) {
+      const auto &row = p.cur[y];
+      for (int64_t x = ghost; x < ghost + cfg.patch; ++x) {
+        if (std::abs(row[x]) < bound) {
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  /* Fill the interior of p from a uniform field at the finest resolution */
+  inline void restrict_from(const Field2D &fine, Patch &p) const {
+    const int64_t r = int64_t(1) << (cfg.levels - p.level);
+    const T w = 1.0 / static_cast<T>(r * r);
+    for (int64_t cy = 0; cy < cfg.patch; ++cy) {
+      auto &&row = p.cur[ghost + cy];
+      for (int64_t cx = 0; cx < cfg.patch; ++cx) {
+        const int64_t fy = (p.by * cfg.patch + cy) * r;
+        const int64_t fx = (p.bx * cfg.patch + cx) * r;
+        T sum = 0.0;
+        for (int64_t y = fy; y < fy + r; ++y) {
+          const auto &src = fine[y];
+          for (int64_t x = fx; x < fx + r; ++x) {
+            sum += src[x];
+          }
+        }
+        row[ghost + cx] = sum * w;
+      }
+    }
+  }
+
+  inline void refine(const uint64_t k, const Field2D *fine) {
+    auto node = leaves.extract(k);
+    const auto &parent = node.mapped();
+    const int64_t l = parent.level + 1;
+    for (int64_t i = 0; i < 2; ++i) {
+      for (int64_t j = 0; j < 2; ++j) {
+        auto child = make_patch(l, 2 * parent.by + i, 2 * parent.bx + j);
+        if (fine) {
+          restrict_from(*fine, child);
+        } else {
+          for (int64_t cy = 0; cy < cfg.patch; ++cy) {
+            const auto &src = parent.cur[ghost + (i * cfg.patch + cy) / 2];
+            auto &&dst = child.cur[ghost + cy];
+            for (int64_t cx = 0; cx < cfg.patch; ++cx) {
+              dst[ghost + cx] = src[ghost + (j * cfg.patch + cx) / 2];
+            }
+          }
+        }
+        leaves.emplace(key(l, child.by, child.bx), std::move(child));
+      }
+    }
+    internal.insert(k);
+  }
+
+  inline void coarsen(const int64_t l, const int64_t by, const int64_t bx) {
+    auto parent = make_patch(l, by, bx);
+    for (int64_t i = 0; i < 2; ++i) {
+      for (int64_t j = 0; j < 2; ++j) {
+        const uint64_t ck = key(l + 1, 2 * by + i, 2 * bx + j);
+        const auto &child = leaves.at(ck);
+        for (int64_t cy = 0; cy < cfg.patch / 2; ++cy) {
+          const auto &s0 = child.cur[ghost + 2 * cy];
+          const auto &s1 = child.cur[ghost + 2 * cy + 1];
+          auto &&dst = parent.cur[ghost + i * cfg.patch / 2 + cy];
+          for (int64_t cx = 0; cx < cfg.patch / 2; ++cx) {
+            const int64_t x = ghost + 2 * cx;
+            dst[ghost + j * cfg.patch / 2 + cx] = 0.25 * (s0[x] + s0[x + 1] + s1[x] + s1[x + 1]);
+          }
+        }
+        leaves.erase(ck);
+      }
+    }
+    internal.erase(key(l, by, bx));
+    leaves.emplace(key(l, by, bx), std::move(parent));
+  }
+
+  /* Leaf covering the block (by, bx) of level l if it is at level l or coarser */
+  inline const Patch *covering(const int64_t l, const int64_t by, const int64_t bx) const {
+    for (int64_t k = 0; k <= l; ++k) {
+      const auto it = leaves.find(key(l - k, by >> k, bx >> k));
+      if (it != leaves.end()) {
+        return &it->second;
+      }
+    }
+    return nullptr;
+  }
+
+  /* Leaves that would break the 2:1 balance, i.e. coarser by two levels than a neighbour */
+  inline std::vector<uint64_t> unbalanced() const {
+    std::unordered_set<uint64_t> ret;
+    for (const auto &[k, p] : leaves) {
+      for (int64_t dy = -1; dy <= 1; ++dy) {
+        for (int64_t dx = -1; dx <= 1; ++dx) {
+          if (!inside(p.level, p.by + dy, p.bx + dx)) {
+            continue;
+          }
+          const Patch *n = covering(p.level, p.by + dy, p.bx + dx);
+          if (n && n->level < p.level - 1) {
+            ret.insert(key(n->level, n->by, n->bx));
+          }
+        }
+      }
+    }
+    return {ret.begin(), ret.end()};
+  }
+
+  inline void collect(const int64_t l, const int64_t cy, const int64_t cx, const T w,
+                      const std::unordered_map<uint64_t, int32_t> &index,
+                      std::vector<Source> &out) const {
+    const int64_t by = cy / cfg.patch;
+    const int64_t bx = cx / cfg.patch;
+    if (internal.count(key(l, by, bx))) {
+      for (int64_t i = 0; i < 2; ++i) {
+        for (int64_t j = 0; j < 2; ++j) {
+          collect(l + 1, 2 * cy + i, 2 * cx + j, 0.25 * w, index, out);
+        }
+      }
+      return;
+    }
+    const Patch *p = covering(l, by, bx);
+    if (!p) {
+      throw std::logic_error("AMR tree does not cover the domain");
+    }
+    const int64_t k = l - p->level;
+    out.push_back({index.at(key(p->level, p->by, p->bx)),
+                   static_cast<int32_t>(ghost + (cy >> k) % cfg.patch),
+                   static_cast<int32_t>(ghost + (cx >> k) % cfg.patch), w});
+  }
+
+  /* Sort the leaves in Morton order and plan the ghost fill of each */
+  inline void rebuild() {
+    order.clear();
+    for (auto &[k, p] : leaves) {
+      order.push_back(&p);
+    }
+    const int64_t L = cfg.levels;
+    std::sort(order.begin(), order.end(), [L](const Patch *a, const Patch *b) {
+      return morton(a->by << (L - a->level), a->bx << (L - a->level)) <
+             morton(b->by << (L - b->level), b->bx << (L - b->level));
+    });
+    std::unordered_map<uint64_t, int32_t> index;
+    for (std::size_t i = 0; i < order.size(); ++i) {
+      index.emplace(key(order[i]->level, order[i]->by, order[i]->bx), static_cast<int32_t>(i));
+    }
+
+    ghosts.assign(order.size(), {});
+    sources.assign(order.size(), {});
+    const int64_t n = cfg.patch + 2 * ghost;
+#pragma omp parallel for schedule(dynamic, 4)
+    for (std::size_t i = 0; i < order.size(); ++i) {
+      const auto &p = *order[i];
+      const int64_t ny_l = blocks_y(p.level) * cfg.patch;
+      const int64_t nx_l = blocks_x(p.level) * cfg.patch;
+      for (int64_t y = 0; y < n; ++y) {
+        for (int64_t x = 0; x < n; ++x) {
+          if (ghost <= y && y < n - ghost && ghost <= x && x < n - ghost) {
+            continue;
+          }
+          const int64_t cy = p.by * cfg.patch + y - ghost;
+          const int64_t cx = p.bx * cfg.patch + x - ghost;
+          if (cy < 0 || cy >= ny_l || cx < 0 || cx >= nx_l) {
+            continue;
+          }
+          const auto first = static_cast<int32_t>(sources[i].size());
+          collect(p.level, cy, cx, 1.0, index, sources[i]);
+          ghosts[i].push_back({static_cast<int32_t>(y), static_cast<int32_t>(x), first,
+                               static_cast<int32_t>(sources[i].size()) - first});
+        }
+      }
+    }
+  }
+
+  inline void fill_ghosts() {
+    const int64_t n_patches = order.size();
+#pragma omp parallel for schedule(dynamic, 4)
+    for (int64_t i = 0; i < n_patches; ++i) {
+      auto &field = order[i]->cur;
+      const auto &src = sources[i];
+      for (const auto &g : ghosts[i]) {
+        T sum = 0.0;
+        for (int32_t s = g.first; s < g.first + g.count; ++s) {
+          sum += src[s].weight * order[src[s].patch]->cur[src[s].y][src[s].x];
+        }
+        field[g.y][g.x] = sum;
+      }
+    }
+  }
+
+  /**
+   * @brief Adapt the tree to the current field
+   *
+   * @param fine values of refined leaves are restricted from this uniform field when given,
+   *  otherwise injected from their parent
+   */
+  inline void regrid(const Field2D *fine) {
+    const int64_t L = cfg.levels;
+    const int64_t fy = blocks_y(L);
+    const int64_t fx = blocks_x(L);
+
+    /* Tag in units of finest blocks, then dilate by one finest block */
+    std::vector<uint8_t> tag(fy * fx, 0);
+#pragma omp parallel for schedule(dynamic, 4)
+    for (std::size_t i = 0; i < order.size(); ++i) {
+      const auto &p = *order[i];
+      const bool boundary = p.by == 0 || p.bx == 0 || p.by == blocks_y(p.level) - 1 ||
+                            p.bx == blocks_x(p.level) - 1;
+      if (boundary || has_interface(p)) {
+        const int64_t r = int64_t(1) << (L - p.level);
+        for (int64_t y = p.by * r; y < (p.by + 1) * r; ++y) {
+          std::fill(tag.begin() + y * fx + p.bx * r, tag.begin() + y * fx + (p.bx + 1) * r, 1);
+        }
+      }
+    }
+    std::vector<uint8_t> want(fy * fx, 0);
+#pragma omp parallel for
+    for (int64_t y = 0; y < fy; ++y) {
+      for (int64_t x = 0; x < fx; ++x) {
+        bool w = false;
+        for (int64_t j = std::max<int64_t>(y - 1, 0); j <= std::min(y + 1, fy - 1); ++j) {
+          for (int64_t i = std::max<int64_t>(x - 1, 0); i <= std::min(x + 1, fx - 1); ++i) {
+            w |= tag[j * fx + i] != 0;
+          }
+        }
+        want[y * fx + x] = w;
+      }
+    }
+    const auto wanted = [&](const int64_t l, const int64_t by, const int64_t bx) {
+      const int64_t r = int64_t(1) << (L - l);
+      for (int64_t y = by * r; y < (by + 1) * r; ++y) {
+        for (int64_t x = bx * r; x < (bx + 1) * r; ++x) {
+          if (want[y * fx + x]) {
+            return true;
+          }
+        }
+      }
+      return false;
+    };
+
+    /* Refine the wanted regions down to the finest level */
+    while (true) {
+      std::vector<uint64_t> split;
+      for (const auto &[k, p] : leaves) {
+        if (p.level < L && wanted(p.level, p.by, p.bx)) {
+          split.push_back(k);
+        }
+      }
+      if (split.empty()) {
+        break;
+      }
+      for (const auto k : split) {
+        refine(k, fine);
+      }
+    }
+
+    /* Coarsen one level where nothing is wanted and the balance allows it */
+    if (!fine) {
+      std::vector<std::array<int64_t, 3>> merge;
+      for (const auto k : internal) {
+        const int64_t l = static_cast<int64_t>(k >> 58);
+        const int64_t by = static_cast<int64_t>((k >> 29) & ((uint64_t(1) << 29) - 1));
+        const int64_t bx = static_cast<int64_t>(k & ((uint64_t(1) << 29) - 1));
+        bool ok = !wanted(l, by, bx);
+        for (int64_t i = 0; i < 2 && ok; ++i) {
+          for (int64_t j = 0; j < 2 && ok; ++j) {
+            ok = !internal.count(key(l + 1, 2 * by + i, 2 * bx + j));
+          }
+        }
+        /* A merged leaf at level l must not touch a leaf finer than l + 1 */
+        for (int64_t dy = -1; dy <= 1 && ok; ++dy) {
+          for (int64_t dx = -1; dx <= 1 && ok; ++dx) {
+            if ((dy || dx) && inside(l, by + dy, bx + dx) &&
+                internal.count(key(l, by + dy, bx + dx))) {
+              for (int64_t i = 0; i < 2 && ok; ++i) {
+                for (int64_t j = 0; j < 2 && ok; ++j) {
+                  ok = !internal.count(key(l + 1, 2 * (by + dy) + i, 2 * (bx + dx) + j));
+                }
+              }
+            }
+          }
+        }
+        if (ok) {
+          merge.push_back({l, by, bx});
+        }
+      }
+      for (const auto &[l, by, bx] : merge) {
+        coarsen(l, by, bx);
+      }
+    }
+
+    /* Restore the 2:1 balance broken by refinement */
+    for (auto split = unbalanced(); !split.empty(); split = unbalanced()) {
+      for (const auto k : split) {
+        refine(k, fine);
+      }
+    }
+    rebuild();
+  }
+
+public:
+  AMRPhaseField2D(const Param &p, const AMRParam &c = {}) : param(p), cfg(c) {
+    if (c.patch < 2 * ghost || c.patch % 2 != 0 || c.levels < 0 || c.levels > 16 ||
+        c.regrid_interval < 1) {
+      throw std::invalid_argument("invalid AMR parameter given");
+    }
+    for (int64_t l = 0; l <= c.levels; ++l) {
+      Param q = p;
+      q.dx = p.dx * static_cast<T>(int64_t(1) << (c.levels - l));
+      kernels.emplace_back(q);
+    }
+  }
+  AMRPhaseField2D(const AMRPhaseField2D &) = delete;
+  AMRPhaseField2D &operator=(const AMRPhaseField2D &) = delete;
+
+  /**
+   * @brief Build the mesh from a field at the finest resolution
+   *  The extent of each axis must be a multiple of patch 2^levels.
+   */
+  inline void initialize(const Field2D &fine) {
+    const int64_t root = cfg.patch << cfg.levels;
+    const int64_t ny = fine.shape()[0];
+    const int64_t nx = fine.shape()[1];
+    if (ny % root != 0 || nx % root != 0) {
+      throw std::invalid_argument("shape must be a multiple of " + std::to_string(root));
+    }
+    n0y = ny / root;
+    n0x = nx / root;
+    leaves.clear();
+    internal.clear();
+    for (int64_t by = 0; by < n0y; ++by) {
+      for (int64_t bx = 0; bx < n0x; ++bx) {
+        auto p = make_patch(0, by, bx);
+        restrict_from(fine, p);
+        leaves.emplace(key(0, by, bx), std::move(p));
+      }
+    }
+    rebuild();
+    for (int64_t l = 0; l < cfg.levels; ++l) {
+      regrid(&fine);
+    }
+    n_steps = 0;
+  }
+
+  /**
+   * @brief Advance every leaf by param.dt, regridding every regrid_interval steps
+   */
+  inline void step() {
+    if (n_steps > 0 && n_steps % cfg.regrid_interval == 0) {
+      regrid(nullptr);
+    }
+    fill_ghosts();
+    workspace.reserve(order.front()->cur);
+    const int64_t n_patches = order.size();
+    const Box2D interior{ghost, ghost + cfg.patch, ghost, ghost + cfg.patch};
+#pragma omp parallel
+    {
+      auto &s = workspace.thread_scratch();
+#pragma omp for schedule(dynamic, 4)
+      for (int64_t i = 0; i < n_patches; ++i) {
+        auto &p = *order[i];
+        kernels[p.level].tile(p.cur, p.next, interior, valid(p), s);
+        std::swap(p.cur, p.next);
+      }
+    }
+    ++n_steps;
+  }
+
+  inline void advance(const std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+      step();
+    }
+  }
+
+  /**
+   * @brief Sample the mesh on the uniform grid of the finest level
+   */
+  inline void to_uniform(Field2D &fine) const {
+    const int64_t root = cfg.patch << cfg.levels;
+    fine.resize({static_cast<std::size_t>(n0y * root), static_cast<std::size_t>(n0x * root)});
+    const int64_t n_patches = order.size();
+#pragma omp parallel for schedule(dynamic, 4)
+    for (int64_t i = 0; i < n_patches; ++i) {
+      const auto &p = *order[i];
+      const int64_t r = int64_t(1) << (cfg.levels - p.level);
+      for (int64_t cy = 0; cy < cfg.patch; ++cy) {
+        const auto &src = p.cur[ghost + cy];
+        for (int64_t y = (p.by * cfg.patch + cy) * r; y < (p.by * cfg.patch + cy + 1) * r; ++y) {
+          auto &&dst = fine[y];
+          for (int64_t cx = 0; cx < cfg.patch; ++cx) {
+            const int64_t x0 = (p.bx * cfg.patch + cx) * r;
+            for (int64_t x = x0; x < x0 + r; ++x) {
+              dst[x] = src[ghost + cx];
+            }
+          }
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief Interiors of the leaves, one row each, and the tree to restore them with
+   *  Ghosts are refilled before every step, so the interiors and the step count are the
+   *  whole state of the mesh.
+   *
+   * @param data resized to (leaves, patch^2)
+   * @return level, position and order of the leaves and the step count
+   */
+  inline nlohmann::json checkpoint(Field2D &data) const {
+    const std::size_t n_patches = order.size();
+    data.resize({n_patches, static_cast<std::size_t>(cfg.patch * cfg.patch)});
+    std::vector<int64_t> level(n_patches), by(n_patches), bx(n_patches);
+#pragma omp parallel for schedule(dynamic, 4)
+    for (std::size_t i = 0; i < n_patches; ++i) {
+      const auto &p = *order[i];
+      level[i] = p.level;
+      by[i] = p.by;
+      bx[i] = p.bx;
+      auto &&dst = data[i];
+      for (int64_t y = 0; y < cfg.patch; ++y) {
+        const auto &src = p.cur[ghost + y];
+        for (int64_t x = 0; x < cfg.patch; ++x) {
+          dst[y * cfg.patch + x] = src[ghost + x];
+        }
+      }
+    }
+    return {{"roots", {n0y, n0x}}, {"level", level}, {"by", by}, {"bx", bx},
+            {"steps", n_steps}, {"config", cfg}};
+  }
+
+  /**
+   * @brief Rebuild the mesh saved by checkpoint, the next step continues bitwise identically
+   */
+  inline void restore(const Field2D &data, const nlohmann::json &state) {
+    if (state.at("config") != nlohmann::json(cfg)) {
+      throw std::invalid_argument("checkpoint was written with another AMR parameter");
+    }
+    const auto level = state.at("level").get<std::vector<int64_t>>();
+    const auto by = state.at("by").get<std::vector<int64_t>>();
+    const auto bx = state.at("bx").get<std::vector<int64_t>>();
+    const auto roots = state.at("roots").get<std::vector<int64_t>>();
+    if (roots.size() != 2 || level.size() != data.shape()[0] || by.size() != level.size() ||
+        bx.size() != level.size() ||
+        static_cast<int64_t>(data.shape()[1]) != cfg.patch * cfg.patch) {
+      throw std::invalid_argument("invalid AMR checkpoint given");
+    }
+    n0y = roots[0];
+    n0x = roots[1];
+    leaves.clear();
+    internal.clear();
+    for (std::size_t i = 0; i < level.size(); ++i) {
+      if (level[i] < 0 || level[i] > cfg.levels || !inside(level[i], by[i], bx[i])) {
+        throw std::invalid_argument("invalid AMR checkpoint given");
+      }
+      auto p = make_patch(level[i], by[i], bx[i]);
+      const auto &src = data[i];
+      for (int64_t y = 0; y < cfg.patch; ++y) {
+        auto &&dst = p.cur[ghost + y];
+        for (int64_t x = 0; x < cfg.patch; ++x) {
+          dst[ghost + x] = src[y * cfg.patch + x];
+        }
+      }
+      leaves.emplace(key(level[i], by[i], bx[i]), std::move(p));
+      for (int64_t l = 0; l < level[i]; ++l) {
+        const int64_t k = level[i] - l;
+        internal.insert(key(l, by[i] >> k, bx[i] >> k));
+      }
+    }
+    rebuild();
+    n_steps = state.at("steps").get<std::size_t>();
+  }
+
+  inline std::size_t steps() const { return n_steps; }
+  inline T time() const { return n_steps * param.dt; }
+  inline std::size_t patches() const { return order.size(); }
+
+  /**
+   * @brief Number of leaves on each level, from the root level up
+   */
+  inline std::vector<std::size_t> patches_per_level() const {
+    std::vector<std::size_t> ret(cfg.levels + 1, 0);
+    for (const auto *p : order) {
+      ++ret[p->level];
+    }
+    return ret;
+  }
+
+  /**
+   * @brief Cells updated by one step
+   */
+  inline std::size_t cells() const { return order.size() * cfg.patch * cfg.patch; }
+
+  /**
+   * @brief Bytes held by the patches, including ghosts and both time levels
+   */
+  inline std::size_t bytes() const {
+    const std::size_t n = cfg.patch + 2 * ghost;
+    return order.size() * 2 * n * n * sizeof(T);
+  }
+};
+} // namespace phase_field
+
+#endif // __PHASE_FIELD__AMR__
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2025 Materials Modelling Lab, The University of Tokyo
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __PHASE_FIELD__CHECKPOINT__
+#define __PHASE_FIELD__CHECKPOINT__
+
+#include "impl/type.hh"
+#include "io.hh"
+#include <cstdio>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <unistd.h>
+#include <vector>
+
+namespace phase_field::io {
+/**
+ * @brief Write the fields of a solver state to a checkpoint, atomically
+ *  The fields, which must share one shape, are stacked into a rank 3 snapshot (fields, ny, nx)
+ *  in float64, so they are restored bit for bit; info.meta carries the rest of the state. The
+ *  file is written next to filename, flushed to disk and renamed over it, so filename always
+ *  holds either the previous or the new checkpoint even if the process is killed meanwhile.
+ *
+ * @param filename checkpoint path, replaced if it exists
+ * @param fields phi and any auxiliary fields
+ * @param info step, time and the state of the solver in meta
+ */
+inline void write_checkpoint(const std::filesystem::path &filename,
+                             const std::vector<const Field2D *> &fields,
+                             const SnapshotInfo &info) {
+  if (fields.empty()) {
+    throw std::invalid_argument("checkpoint without a field");
+  }
+  const auto &shape = fields.front()->shape();
+  for (const auto *f : fields) {
+    if (f->shape() != shape) {
+      throw std::invalid_argument("checkpoint fields must have the same shape");
+    }
+  }
+
+  auto tmp = filename;
+  tmp += ".tmp";
+  {
+    std::ofstream fo{tmp, std::ios::binary | std::ios::trunc};
+    if (!fo) {
+      throw std::runtime_error("could not open '" + tmp.string() + "'");
+    }
+    const std::string meta = info.meta.dump();
+    const auto header = make_snapshot_header({fields.size(), shape[0], shape[1]}, info, meta);
+    const uint64_t end = sizeof(SnapshotHeader) + meta.size();
+    fo.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    fo.write(meta.data(), meta.size());
+    const std::vector<char> padding(header.data_offset - end, '\0');
+    fo.write(padding.data(), padding.size());
+
+    std::vector<double> row(shape[1]);
+    for (const auto *f : fields) {
+      for (std::size_t y = 0; y < shape[0]; ++y) {
+        const auto &src = (*f)[y];
+        for (std::size_t x = 0; x < row.size(); ++x) {
+          row[x] = src[x];
+        }
+        fo.write(reinterpret_cast<const char *>(row.data()), row.size() * sizeof(double));
+      }
+    }
+    fo.flush();
+    if (!fo) {
+      std::filesystem::remove(tmp);
+      throw std::runtime_error("failed to write '" + tmp.string() + "'");
+    }
+  }
+
+  /* The data must reach the disk before the rename makes it the checkpoint */
+  const auto sync = [](const std::filesystem::path &path, const int flags) {
+    const int fd = ::open(path.c_str(), flags);
+    if (fd < 0) {
+      return false;
+    }
+    const bool ok = ::fsync(fd) == 0;
+    ::close(fd);
+    return ok;
+  };
+  if (!sync(tmp, O_RDONLY)) {
+    std::filesystem::remove(tmp);
+    throw std::runtime_error("failed to sync '" + tmp.string() + "'");
+  }
+  if (std::rename(tmp.c_str(), filename.c_str()) != 0) {
+    std::filesystem::remove(tmp);
+    throw std::runtime_error("failed to rename '" + tmp.string() + "'");
+  }
+  const auto dir = filename.has_parent_path() ? filename.parent_path() : ".";
+  sync(dir, O_RDONLY | O_DIRECTORY);
+}
+
+/**
+ * @brief Read the fields of a checkpoint written by write_checkpoint
+ *
+ * @param filename checkpoint path
+ * @param fields resized to the shape of the checkpoint, one per stored field
+ * @return SnapshotInfo step, time and the state of the solver in meta
+ */
+inline SnapshotInfo read_checkpoint(const std::filesystem::path &filename,
+                                    const std::vector<Field2D *> &fields) {
+  const MappedSnapshot snap(filename);
+  if (snap.rank() != 3 || snap.shape(0) != fields.size()) {
+    throw std::runtime_error("checkpoint '" + filename.string() + "' does not hold " +
+                             std::to_string(fields.size()) + " fields");
+  }
+  const std::size_t y_size = snap.shape(1);
+  const std::size_t x_size = snap.shape(2);
+  for (std::size_t i = 0; i < fields.size(); ++i) {
+    auto &field = *fields[i];
+    field.resize({y_size, x_size});
+    const double *data = snap.data() + i * y_size * x_size;
+#pragma omp parallel for
+    for (std::size_t y = 0; y < y_size; ++y) {
+      const double *src = data + y * x_size;
+      auto &&dst = field[y];
+      for (std::size_t x = 0; x < x_size; ++x) {
+        dst[x] = src[x];
+      }
+    }
+  }
+  return snap.info();
+}
+} // namespace phase_field::io
+
+#endif // __PHASE_FIELD__CHECKPOINT__
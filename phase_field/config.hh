@@ -0,0 +1,479 @@
+/*
+ * Copyright (c) 2025 Materials Modelling Lab, The University of Tokyo
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __PHASE_FIELD__CONFIG__
+#define __PHASE_FIELD__CONFIG__
+
+#include "amr.hh"
+#include "impl/state.hh"
+#include "impl/type.hh"
+#include "io.hh"
+#include "param.hh"
+#include "stepper.hh"
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <initializer_list>
+#include <limits>
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace phase_field {
+/**
+ * @brief Description of a 2D run loaded from a JSON run file
+ *  Every key is optional and defaults to the case of the bundled driver (80 x 80 grid, pure Ni,
+ *  lambda 16, u -0.2, a nucleus of radius 10 in the corner, 5000 steps, output every 100):
+ *
+ *    {
+ *      "grid":     {"ny": 80, "nx": 80},
+ *      "steps":    5000,
+ *      "output":   {"interval": 100, "directory": "output", "format": "pfs"},
+ *      "material": {"preset": "pure_ni", "u": -0.2, "lambda": 16.0},
+ *      "initial":  {"type": "corner", "radius": 10},
+ *      "solver":   {"backend": "fused"}
+ *    }
+ *
+ *  "material" takes any key of Param on top of the preset. "initial" is one of
+ *    {"type": "corner", "radius": r}
+ *    {"type": "circle", "center": [y, x], "radius": r}
+ *    {"type": "snapshot", "file": "path.pfs"}
+ *  "solver.backend" is one of fused, reference, narrow_band, adaptive, amr, temporal,
+ *  semi_implicit or padded, with the options "tolerance" (narrow_band), "stepper"
+ *  (StepperParam), "amr" (AMRParam), "depth" (temporal, steps a block is advanced by at once),
+ *  "dt_scale" (semi_implicit, step as a multiple of the explicit one, applied by the driver) and
+ *  "boundary" (padded, mirror, periodic or dirichlet on every side, the last holding the ghost
+ *  cells at "boundary_value").
+ *  "checkpoint": {"interval": seconds, "file": "checkpoint.pfs"} saves the solver state every
+ *  interval seconds of wall-clock time into the output directory; 0 (the default) disables it.
+ *
+ *  Unknown keys are rejected, so a typo does not silently fall back to a default. Nothing is
+ *  allocated while loading: validate checks the whole run, including the shape of an initial
+ *  snapshot, before the driver creates any field.
+ */
+struct RunConfig {
+  using T = Field2D::scalar_type;
+
+  struct Grid {
+    int64_t ny = 80;
+    int64_t nx = 80;
+  };
+  struct Output {
+    std::size_t interval = 100;
+    std::filesystem::path directory = "output";
+    std::string format = "pfs";
+  };
+  struct Initial {
+    std::string type = "corner";
+    int64_t radius = 10;
+    int64_t center_y = 0;
+    int64_t center_x = 0;
+    std::filesystem::path file;
+  };
+  struct Solver {
+    std::string backend = "fused";
+    T tolerance = 0.0;
+    std::size_t depth = 4;
+    T dt_scale = 1.0;
+    std::string boundary = "mirror";
+    T boundary_value = FieldState::liquid;
+    StepperParam stepper;
+    AMRParam amr;
+  };
+  struct Checkpoint {
+    double interval = 0.0;                         // wall-clock seconds between two, 0 disables
+    std::filesystem::path file = "checkpoint.pfs"; // relative to output.directory
+  };
+
+  Grid grid;
+  std::size_t steps = 5000;
+  Output output;
+  std::string material = "pure_ni";
+  Param param;
+  Initial initial;
+  Solver solver;
+  Checkpoint checkpoint;
+
+  RunConfig() : param(get_pure_ni_param()) {
+    param.lambda = 16.0;
+    param.u = -0.2;
+    param.setup();
+  }
+
+private:
+  static inline void check_keys(const nlohmann::json &j, const std::string &path,
+                                std::initializer_list<const char *> keys) {
+    if (!j.is_object()) {
+      throw std::invalid_argument(path.empty() ? "run file must hold an object"
+                                               : "'" + path + "' must be an object");
+    }
+    for (const auto &item : j.items()) {
+      bool known = false;
+      for (const auto *k : keys) {
+        known |= item.key() == k;
+      }
+      if (!known) {
+        throw std::invalid_argument("unknown key '" + (path.empty() ? "" : path + ".") +
+                                    item.key() + "'");
+      }
+    }
+  }
+
+  template <typename U>
+  static inline void read(const nlohmann::json &j, const std::string &path, const char *key,
+                          U &dst) {
+    if (!j.contains(key)) {
+      return;
+    }
+    const auto &v = j.at(key);
+    const auto name = path.empty() ? std::string(key) : path + "." + key;
+    /* get<unsigned> accepts negative numbers and get<int> truncates 1.5 */
+    if constexpr (std::is_integral_v<U>) {
+      if (!v.is_number_integer() || (std::is_unsigned_v<U> && v.get<int64_t>() < 0)) {
+        throw std::invalid_argument("'" + name + "' must be " +
+                                    (std::is_unsigned_v<U> ? "a non-negative" : "an") + " integer");
+      }
+    }
+    try {
+      dst = v.get<U>();
+    } catch (const nlohmann::json::exception &) {
+      throw std::invalid_argument("'" + name + "' has an invalid type");
+    }
+  }
+
+  static inline Param preset(const std::string &name) {
+    if (name == "pure_ni") {
+      return get_pure_ni_param();
+    }
+    throw std::invalid_argument("unknown material preset '" + name + "'");
+  }
+
+public:
+  /**
+   * @brief Param with the keys of an object replaced, the key "preset" is skipped
+   *
+   * @param base values of the keys that are not given
+   * @param m object of Param keys and numbers
+   * @param path name of m in error messages
+   */
+  static inline Param with_overrides(const Param &base, const nlohmann::json &m,
+                                     const std::string &path) {
+    if (!m.is_object()) {
+      throw std::invalid_argument("'" + path + "' must be an object");
+    }
+    nlohmann::json p = base;
+    for (const auto &item : m.items()) {
+      if (item.key() == "preset") {
+        continue;
+      }
+      if (!p.contains(item.key())) {
+        throw std::invalid_argument("unknown key '" + path + "." + item.key() + "'");
+      }
+      if (!item.value().is_number()) {
+        throw std::invalid_argument("'" + path + "." + item.key() + "' must be a number");
+      }
+      p[item.key()] = item.value();
+    }
+    Param ret = p.get<Param>();
+    ret.setup();
+    return ret;
+  }
+
+  /**
+   * @brief Parse a run description, see RunConfig for the layout
+   */
+  static inline RunConfig from_json(const nlohmann::json &j) {
+    RunConfig ret;
+    check_keys(j, "",
+               {"grid", "steps", "output", "material", "initial", "solver", "checkpoint"});
+    read(j, "", "steps", ret.steps);
+    if (j.contains("grid")) {
+      const auto &g = j.at("grid");
+      check_keys(g, "grid", {"ny", "nx"});
+      read(g, "grid", "ny", ret.grid.ny);
+      read(g, "grid", "nx", ret.grid.nx);
+    }
+    if (j.contains("output")) {
+      const auto &o = j.at("output");
+      check_keys(o, "output", {"interval", "directory", "format"});
+      read(o, "output", "interval", ret.output.interval);
+      std::string dir = ret.output.directory.string();
+      read(o, "output", "directory", dir);
+      ret.output.directory = dir;
+      read(o, "output", "format", ret.output.format);
+    }
+    if (j.contains("material")) {
+      const auto &m = j.at("material");
+      if (!m.is_object()) {
+        throw std::invalid_argument("'material' must be an object");
+      }
+      read(m, "material", "preset", ret.material);
+      /* u and lambda are not part of a preset, the defaults stay unless overridden */
+      Param base = preset(ret.material);
+      base.u = ret.param.u;
+      base.lambda = ret.param.lambda;
+      ret.param = with_overrides(base, m, "material");
+    }
+    if (j.contains("initial")) {
+      const auto &i = j.at("initial");
+      check_keys(i, "initial", {"type", "radius", "center", "file"});
+      read(i, "initial", "type", ret.initial.type);
+      read(i, "initial", "radius", ret.initial.radius);
+      if (i.contains("center")) {
+        const auto &c = i.at("center");
+        if (!c.is_array() || c.size() != 2 || !c[0].is_number_integer() ||
+            !c[1].is_number_integer()) {
+          throw std::invalid_argument("'initial.center' must be [y, x] in grid index");
+        }
+        ret.initial.center_y = c[0].get<int64_t>();
+        ret.initial.center_x = c[1].get<int64_t>();
+      }
+      std::string file;
+      read(i, "initial", "file", file);
+      ret.initial.file = file;
+    }
+    if (j.contains("solver")) {
+      const auto &s = j.at("solver");
+      check_keys(s, "solver", {"backend", "tolerance", "depth", "dt_scale", "boundary",
+                                   "boundary_value", "stepper", "amr"});
+      read(s, "solver", "backend", ret.solver.backend);
+      read(s, "solver", "tolerance", ret.solver.tolerance);
+      read(s, "solver", "depth", ret.solver.depth);
+      read(s, "solver", "dt_scale", ret.solver.dt_scale);
+      read(s, "solver", "boundary", ret.solver.boundary);
+      read(s, "solver", "boundary_value", ret.solver.boundary_value);
+      if (s.contains("stepper")) {
+        const auto &st = s.at("stepper");
+        check_keys(st, "solver.stepper", {"safety", "max_dphi", "growth", "dt_min", "dt_max"});
+        read(st, "solver.stepper", "safety", ret.solver.stepper.safety);
+        read(st, "solver.stepper", "max_dphi", ret.solver.stepper.max_dphi);
+        read(st, "solver.stepper", "growth", ret.solver.stepper.growth);
+        read(st, "solver.stepper", "dt_min", ret.solver.stepper.dt_min);
+        read(st, "solver.stepper", "dt_max", ret.solver.stepper.dt_max);
+      }
+      if (s.contains("amr")) {
+        const auto &a = s.at("amr");
+        check_keys(a, "solver.amr", {"patch", "levels", "regrid_interval", "threshold"});
+        read(a, "solver.amr", "patch", ret.solver.amr.patch);
+        read(a, "solver.amr", "levels", ret.solver.amr.levels);
+        read(a, "solver.amr", "regrid_interval", ret.solver.amr.regrid_interval);
+        read(a, "solver.amr", "threshold", ret.solver.amr.threshold);
+      }
+    }
+    if (j.contains("checkpoint")) {
+      const auto &c = j.at("checkpoint");
+      check_keys(c, "checkpoint", {"interval", "file"});
+      read(c, "checkpoint", "interval", ret.checkpoint.interval);
+      std::string file = ret.checkpoint.file.string();
+      read(c, "checkpoint", "file", file);
+      ret.checkpoint.file = file;
+    }
+    return ret;
+  }
+
+  /**
+   * @brief Load and validate a JSON run file
+   */
+  static inline RunConfig load(const std::filesystem::path &filename) {
+    std::ifstream fi(filename);
+    if (!fi) {
+      throw std::runtime_error("could not open '" + filename.string() + "'");
+    }
+    nlohmann::json j;
+    try {
+      fi >> j;
+    } catch (const nlohmann::json::parse_error &e) {
+      throw std::invalid_argument("'" + filename.string() + "' is not valid JSON: " + e.what());
+    }
+    auto ret = from_json(j);
+    ret.validate();
+    return ret;
+  }
+
+  /**
+   * @brief Bytes of the fields held by the run, phi and its next step
+   */
+  inline std::size_t bytes() const {
+    return 2 * static_cast<std::size_t>(grid.ny) * static_cast<std::size_t>(grid.nx) * sizeof(T);
+  }
+
+  /**
+   * @brief Check the whole run, throws std::invalid_argument on the first problem
+   */
+  inline void validate() const {
+    const auto fail = [](const std::string &msg) { throw std::invalid_argument(msg); };
+
+    /* Grid: the extent times two fields must fit in memory addressing */
+    constexpr int64_t max_extent = int64_t(1) << 31;
+    if (grid.ny < 1 || grid.nx < 1 || grid.ny > max_extent || grid.nx > max_extent) {
+      fail("'grid' extents must be in [1, 2^31]");
+    }
+    if (static_cast<double>(grid.ny) * grid.nx * 2 * sizeof(T) >
+        static_cast<double>(std::numeric_limits<std::size_t>::max())) {
+      fail("'grid' is too large");
+    }
+    if (steps == 0) {
+      fail("'steps' must be positive");
+    }
+    if (output.interval == 0) {
+      fail("'output.interval' must be positive");
+    }
+    if (output.format != "pfs" && output.format != "dat") {
+      fail("'output.format' must be pfs or dat");
+    }
+    if (output.directory.empty()) {
+      fail("'output.directory' must not be empty");
+    }
+
+    /* Material: every input of Param::setup must be finite and the derived steps positive */
+    for (const auto v : {param.Tm, param.L, param.cp, param.d0, param.beta0, param.lambda}) {
+      if (!(std::isfinite(v) && v > 0.0)) {
+        fail("'material' Tm, L, cp, d0, beta0 and lambda must be positive");
+      }
+    }
+    if (!std::isfinite(param.u) || param.u == 0.0) {
+      fail("'material.u' must be finite and non-zero");
+    }
+    /* 1 + 15 epsilon_c cos(4 theta) loses convexity above 1/15 */
+    if (!(0.0 <= param.epsilon_c && param.epsilon_c < 1.0 / 15.0)) {
+      fail("'material.epsilon_c' must be in [0, 1/15)");
+    }
+    if (!(0.0 <= param.epsilon_k && param.epsilon_k < 1.0)) {
+      fail("'material.epsilon_k' must be in [0, 1)");
+    }
+    if (!(std::isfinite(param.dx) && param.dx > 0.0 && std::isfinite(param.dt) && param.dt > 0.0)) {
+      fail("'material' gives an invalid dx or dt");
+    }
+
+    /* Initial condition */
+    if (initial.type == "corner" || initial.type == "circle") {
+      if (initial.radius < 0 || initial.radius >= std::min(grid.ny, grid.nx)) {
+        fail("'initial.radius' must be in [0, min(ny, nx))");
+      }
+      if (initial.center_y < 0 || initial.center_y >= grid.ny || initial.center_x < 0 ||
+          initial.center_x >= grid.nx) {
+        fail("'initial.center' must be inside the grid");
+      }
+      if (!initial.file.empty()) {
+        fail("'initial.file' is only used by the snapshot type");
+      }
+    } else if (initial.type == "snapshot") {
+      if (initial.file.empty()) {
+        fail("'initial.file' is required by the snapshot type");
+      }
+      /* Only the header is read, the data stays unmapped until the field is loaded */
+      const io::MappedSnapshot snap(initial.file);
+      if (snap.rank() != 2 || static_cast<int64_t>(snap.shape(0)) != grid.ny ||
+          static_cast<int64_t>(snap.shape(1)) != grid.nx) {
+        fail("'initial.file' does not match the grid shape");
+      }
+    } else {
+      fail("'initial.type' must be corner, circle or snapshot");
+    }
+
+    /* Solver */
+    const auto &b = solver.backend;
+    if (b != "fused" && b != "reference" && b != "narrow_band" && b != "adaptive" && b != "amr" &&
+        b != "temporal" && b != "semi_implicit" && b != "padded") {
+      fail("'solver.backend' must be fused, reference, narrow_band, adaptive, amr, temporal, "
+           "semi_implicit or padded");
+    }
+    if (!(solver.tolerance >= 0.0)) {
+      fail("'solver.tolerance' must not be negative");
+    }
+    if (solver.depth < 1 || solver.depth > 64) {
+      fail("'solver.depth' must be between 1 and 64");
+    }
+    if (!(0.0 < solver.dt_scale && solver.dt_scale <= 1000.0)) {
+      fail("'solver.dt_scale' must be in (0, 1000]");
+    }
+    if (solver.dt_scale != 1.0 && b != "semi_implicit") {
+      fail("'solver.dt_scale' is only used by the semi_implicit backend");
+    }
+    if (solver.boundary != "mirror" && solver.boundary != "periodic" &&
+        solver.boundary != "dirichlet") {
+      fail("'solver.boundary' must be mirror, periodic or dirichlet");
+    }
+    if (!std::isfinite(solver.boundary_value)) {
+      fail("'solver.boundary_value' must be finite");
+    }
+    if ((solver.boundary != "mirror" || solver.boundary_value != FieldState::liquid) &&
+        b != "padded") {
+      fail("'solver.boundary' is only used by the padded backend");
+    }
+    const auto &st = solver.stepper;
+    if (!(0.0 < st.safety && st.safety <= 1.0) || !(st.max_dphi > 0.0) || !(st.growth >= 1.0) ||
+        !(st.dt_min > 0.0) || !(st.dt_max >= st.dt_min)) {
+      fail("'solver.stepper' is invalid");
+    }
+    const auto &a = solver.amr;
+    if (a.patch < 4 || a.patch % 2 != 0 || a.levels < 0 || a.levels > 16 ||
+        a.regrid_interval < 1 || !(a.threshold > 0.0 && a.threshold < 1.0)) {
+      fail("'solver.amr' is invalid");
+    }
+    if (b == "amr") {
+      const int64_t root = a.patch << a.levels;
+      if (grid.ny % root != 0 || grid.nx % root != 0) {
+        fail("'grid' must be a multiple of patch 2^levels = " + std::to_string(root) +
+             " with the amr backend");
+      }
+    }
+
+    /* Checkpoint */
+    if (!(std::isfinite(checkpoint.interval) && checkpoint.interval >= 0.0)) {
+      fail("'checkpoint.interval' must not be negative");
+    }
+    if (checkpoint.file.empty() || checkpoint.file.has_parent_path()) {
+      fail("'checkpoint.file' must be a file name inside the output directory");
+    }
+  }
+
+  /**
+   * @brief Resolved run, including every default, to be logged alongside the output
+   */
+  inline nlohmann::json to_json() const {
+    nlohmann::json j;
+    j["grid"] = {{"ny", grid.ny}, {"nx", grid.nx}};
+    j["steps"] = steps;
+    j["output"] = {{"interval", output.interval},
+                   {"directory", output.directory.string()},
+                   {"format", output.format}};
+    j["material"] = param;
+    j["material"]["preset"] = material;
+    j["initial"] = {{"type", initial.type}};
+    if (initial.type == "snapshot") {
+      j["initial"]["file"] = initial.file.string();
+    } else {
+      j["initial"]["radius"] = initial.radius;
+      if (initial.type == "circle") {
+        j["initial"]["center"] = {initial.center_y, initial.center_x};
+      }
+    }
+    j["solver"] = {{"backend", solver.backend}};
+    if (solver.backend == "narrow_band") {
+      j["solver"]["tolerance"] = solver.tolerance;
+    } else if (solver.backend == "temporal") {
+      j["solver"]["depth"] = solver.depth;
+    } else if (solver.backend == "semi_implicit") {
+      j["solver"]["dt_scale"] = solver.dt_scale;
+    } else if (solver.backend == "padded") {
+      j["solver"]["boundary"] = solver.boundary;
+      if (solver.boundary == "dirichlet") {
+        j["solver"]["boundary_value"] = solver.boundary_value;
+      }
+    } else if (solver.backend == "adaptive") {
+      j["solver"]["stepper"] = solver.stepper;
+    } else if (solver.backend == "amr") {
+      j["solver"]["amr"] = solver.amr;
+    }
+    j["checkpoint"] = {{"interval", checkpoint.interval}, {"file", checkpoint.file.string()}};
+    return j;
+  }
+};
+} // namespace phase_field
+
+#endif // __PHASE_FIELD__CONFIG__
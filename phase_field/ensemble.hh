@@ -0,0 +1,406 @@
+/*
+ * Copyright (c) 2025 Materials Modelling Lab, The University of Tokyo
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __PHASE_FIELD__ENSEMBLE__
+#define __PHASE_FIELD__ENSEMBLE__
+
+#include "impl/functor.hh"
+#include "impl/kernel.hh"
+#include "impl/simd.hh"
+#include "impl/state.hh"
+#include "impl/type.hh"
+#include "param.hh"
+#include <algorithm>
+#include <cstdint>
+#include <omp.h>
+#include <stdexcept>
+#include <vector>
+
+namespace phase_field {
+/**
+ * @brief Phase fields of an ensemble of runs on the same grid
+ *  Stored as (ny, nx, lanes) with the member innermost, so the members of one cell are
+ *  contiguous and a SIMD register covers several members. lanes is the member count rounded up
+ *  to lane_multiple; the padding lanes hold liquid and are advanced but never read back.
+ */
+class EnsembleField2D {
+public:
+  using T = Field2D::scalar_type;
+  static constexpr int64_t lane_multiple = 8;
+
+private:
+  int64_t ny = 0, nx = 0;
+  int64_t n_members = 0;
+  int64_t n_lanes = 0;
+  std::vector<T> buf;
+
+public:
+  EnsembleField2D() = default;
+  EnsembleField2D(const int64_t y, const int64_t x, const int64_t members)
+      : ny(y), nx(x), n_members(members),
+        n_lanes((members + lane_multiple - 1) / lane_multiple * lane_multiple),
+        buf(static_cast<std::size_t>(y * x * n_lanes), FieldState::liquid) {
+    if (y < 1 || x < 1 || members < 1) {
+      throw std::invalid_argument("invalid ensemble shape given");
+    }
+  }
+
+  inline int64_t rows() const { return ny; }
+  inline int64_t cols() const { return nx; }
+  inline int64_t members() const { return n_members; }
+  inline int64_t lanes() const { return n_lanes; }
+  inline bool same_shape(const EnsembleField2D &o) const {
+    return ny == o.ny && nx == o.nx && n_lanes == o.n_lanes;
+  }
+
+  /**
+   * @brief Lanes of the cell (y, x)
+   */
+  inline T *at(const int64_t y, const int64_t x) { return buf.data() + (y * nx + x) * n_lanes; }
+  inline const T *at(const int64_t y, const int64_t x) const {
+    return buf.data() + (y * nx + x) * n_lanes;
+  }
+
+  /**
+   * @brief Copy a field into member m
+   */
+  inline void set(const int64_t m, const Field2D &f) {
+    if (m < 0 || m >= n_members || static_cast<int64_t>(f.shape()[0]) != ny ||
+        static_cast<int64_t>(f.shape()[1]) != nx) {
+      throw std::invalid_argument("invalid member or shape given");
+    }
+#pragma omp parallel for
+    for (int64_t y = 0; y < ny; ++y) {
+      const auto &row = f[y];
+      for (int64_t x = 0; x < nx; ++x) {
+        at(y, x)[m] = row[x];
+      }
+    }
+  }
+
+  /**
+   * @brief Copy member m into a field of the same grid
+   */
+  inline void get(const int64_t m, Field2D &f) const {
+    if (m < 0 || m >= n_members || static_cast<int64_t>(f.shape()[0]) != ny ||
+        static_cast<int64_t>(f.shape()[1]) != nx) {
+      throw std::invalid_argument("invalid member or shape given");
+    }
+#pragma omp parallel for
+    for (int64_t y = 0; y < ny; ++y) {
+      auto &&row = f[y];
+      for (int64_t x = 0; x < nx; ++x) {
+        row[x] = at(y, x)[m];
+      }
+    }
+  }
+};
+
+/**
+ * @brief Explicit solver advancing an ensemble of 2D phase fields with their own Param
+ *  Every member takes one step of its own dt per call, so after n calls member m is at
+ *  n Param::dt of m. The step is the one of FusedPredictKernel, with each scalar replaced by
+ *  the lanes of a cell: coefficients are per-lane arrays and the innermost loops run over the
+ *  members, which the compiler vectorizes. Threads share (tile_y x tile_x) tiles of the grid,
+ *  each covering all members. Cells outside the grid are zero, the same as PhaseField2D.
+ *
+ *  Operations are applied in the same order as the fused kernel, so a member agrees with
+ *  PhaseField2D::predict of its Param to rounding, and bitwise where neither contracts FMA.
+ */
+class EnsemblePhaseField2D {
+public:
+  using T = Field2D::scalar_type;
+  static constexpr int64_t tile_y = 16;
+  /* Cells times lanes per tile row, so the flux ring of a tile stays in L2 */
+  static constexpr int64_t tile_lanes = 2048;
+
+  const std::vector<Param> params;
+
+private:
+  /* Per-lane coefficients, padding lanes repeat member 0 */
+  struct Coeff {
+    std::vector<T> ac_c1, ac_c2, ak_c1, ak_c2, W0, tau0, W0_sq, aniso3_c1;
+    std::vector<T> inv_2dx, inv_dx_sq, lambda_u, dt;
+  } c;
+  int64_t n_lanes;
+  mutable std::vector<std::vector<T>> scratch;
+
+  /* Flux quantities stored in the flux ring */
+  enum { fx2 = 0, fy2, fx3, fy3, tinv };
+
+  static inline int64_t ring(const int64_t i, const int64_t n) { return ((i % n) + n) % n; }
+
+  /* Offsets into a scratch of a tile of width w */
+  struct Layout {
+    int64_t phi_row, flux_row;
+    inline int64_t phi(const int64_t slot) const { return slot * phi_row; }
+    inline int64_t flux(const int64_t q, const int64_t slot) const {
+      return 4 * phi_row + (3 * q + slot) * flux_row;
+    }
+    inline int64_t size() const { return 4 * phi_row + 15 * flux_row; }
+  };
+
+  inline Layout layout(const int64_t w) const { return {(w + 4) * n_lanes, (w + 2) * n_lanes}; }
+
+  inline int64_t tile_x(const int64_t nx) const {
+    return std::min(nx, std::max<int64_t>(8, tile_lanes / n_lanes));
+  }
+
+  inline void load_row(const EnsembleField2D &phi, const int64_t y, const Box2D &out,
+                       T *dst) const {
+    const int64_t L = n_lanes;
+    const int64_t w = out.x1 - out.x0 + 4;
+    if (y < 0 || y >= phi.rows()) {
+      std::fill(dst, dst + w * L, 0.0);
+      return;
+    }
+    for (int64_t j = 0; j < w; ++j) {
+      const int64_t x = out.x0 - 2 + j;
+      if (x < 0 || x >= phi.cols()) {
+        std::fill(dst + j * L, dst + (j + 1) * L, 0.0);
+      } else {
+        std::copy(phi.at(y, x), phi.at(y, x) + L, dst + j * L);
+      }
+    }
+  }
+
+  __attribute__((always_inline)) inline void flux_row(const int64_t y, const Box2D &out,
+                                                      const int64_t ny, const int64_t nx,
+                                                      const Layout &lo, T *s) const {
+    const int64_t L = n_lanes;
+    const int64_t w = out.x1 - out.x0 + 2;
+    T *f[5];
+    for (int64_t q = 0; q < 5; ++q) {
+      f[q] = s + lo.flux(q, ring(y, 3));
+    }
+    if (y < 0 || y >= ny) {
+      for (int64_t q = 0; q < 5; ++q) {
+        std::fill(f[q], f[q] + w * L, 0.0);
+      }
+      return;
+    }
+
+    const T *p_n = s + lo.phi(ring(y - 1, 4));
+    const T *p_c = s + lo.phi(ring(y, 4));
+    const T *p_s = s + lo.phi(ring(y + 1, 4));
+    const T *ac_c1 = c.ac_c1.data(), *ac_c2 = c.ac_c2.data();
+    const T *ak_c1 = c.ak_c1.data(), *ak_c2 = c.ak_c2.data();
+    const T *W0 = c.W0.data(), *tau0 = c.tau0.data(), *W0_sq = c.W0_sq.data();
+    const T *a3 = c.aniso3_c1.data(), *inv_2dx = c.inv_2dx.data();
+    for (int64_t j = 0; j < w; ++j) {
+      const int64_t x = out.x0 - 1 + j;
+      const int64_t o = j * L;
+      if (x < 0 || x >= nx) {
+        for (int64_t q = 0; q < 5; ++q) {
+          std::fill(f[q] + o, f[q] + o + L, 0.0);
+        }
+        continue;
+      }
+      /* phi rows are offset by 2 cells, fluxes by 1 cell from out.x0 */
+      const T *pc = p_c + o + L;
+      const T *pn = p_n + o + L;
+      const T *ps = p_s + o + L;
+      T *f_tinv = f[tinv] + o;
+      T *f_x2 = f[fx2] + o, *f_y2 = f[fy2] + o;
+      T *f_x3 = f[fx3] + o, *f_y3 = f[fy3] + o;
+#pragma omp simd
+      for (int64_t m = 0; m < L; ++m) {
+        const T gx = (pc[m + L] - pc[m - L]) * inv_2dx[m];
+        const T gy = (ps[m] - pn[m]) * inv_2dx[m];
+        const T x_sq = gx * gx;
+        const T y_sq = gy * gy;
+        const T abs_sq = x_sq + y_sq;
+        const T tmp = abs_sq * abs_sq;
+        const T inv = tmp == 0.0 ? 0.0 : 1.0 / tmp;
+        const T n4 = (x_sq * x_sq + y_sq * y_sq) * inv;
+        const T ac = ac_c1[m] + ac_c2[m] * n4;
+        const T ak = ak_c1[m] - ak_c2[m] * n4;
+        const T W = W0[m] * ac;
+        const T tau = tau0[m] * ac * ak;
+        f_tinv[m] = tau == 0.0 ? 0.0 : 1.0 / tau;
+        const T w2 = W * W - W0_sq[m];
+        f_x2[m] = w2 * gx;
+        f_y2[m] = w2 * gy;
+        const T cw = a3[m] * W;
+        f_x3[m] = cw * (x_sq * gx * y_sq - gx * (y_sq * y_sq)) * inv;
+        f_y3[m] = cw * (y_sq * gy * x_sq - gy * (x_sq * x_sq)) * inv;
+      }
+    }
+  }
+
+  __attribute__((always_inline)) inline void predict_row(const int64_t y, const Box2D &out,
+                                                         const Layout &lo, const T *s,
+                                                         EnsembleField2D &ret) const {
+    const int64_t L = n_lanes;
+    const T *p_n = s + lo.phi(ring(y - 1, 4));
+    const T *p_c = s + lo.phi(ring(y, 4));
+    const T *p_s = s + lo.phi(ring(y + 1, 4));
+    const T *f_n[5], *f_c[5], *f_s[5];
+    for (int64_t q = 0; q < 5; ++q) {
+      f_n[q] = s + lo.flux(q, ring(y - 1, 3));
+      f_c[q] = s + lo.flux(q, ring(y, 3));
+      f_s[q] = s + lo.flux(q, ring(y + 1, 3));
+    }
+    const T *W0_sq = c.W0_sq.data(), *inv_2dx = c.inv_2dx.data();
+    const T *inv_dx_sq = c.inv_dx_sq.data(), *lambda_u = c.lambda_u.data();
+    const T *dt = c.dt.data();
+    for (int64_t j = 0; j < out.x1 - out.x0; ++j) {
+      const int64_t op = (j + 2) * L;
+      const int64_t of = (j + 1) * L;
+      const T *pc = p_c + op, *pn = p_n + op, *ps = p_s + op;
+      const T *cx2 = f_c[fx2] + of, *cx3 = f_c[fx3] + of;
+      const T *ny2 = f_n[fy2] + of, *sy2 = f_s[fy2] + of;
+      const T *ny3 = f_n[fy3] + of, *sy3 = f_s[fy3] + of;
+      const T *t = f_c[tinv] + of;
+      T *dst = ret.at(y, out.x0 + j);
+#pragma omp simd
+      for (int64_t m = 0; m < L; ++m) {
+        const T lap = (pn[m] + ps[m] + pc[m - L] + pc[m + L] - 4.0 * pc[m]) * inv_dx_sq[m];
+        const T term1 = lap * W0_sq[m];
+        const T term2_dx = (cx2[m + L] - cx2[m - L]) * inv_2dx[m];
+        const T term2_dy = (sy2[m] - ny2[m]) * inv_2dx[m];
+        const T term3_dx = (cx3[m + L] - cx3[m - L]) * inv_2dx[m];
+        const T term3_dy = (sy3[m] - ny3[m]) * inv_2dx[m];
+        const T div = term1 + term2_dx + term2_dy + term3_dx + term3_dy;
+        const T dw_pot = 1.0 - pc[m] * pc[m];
+        const T term4 = (pc[m] - lambda_u[m] * dw_pot) * dw_pot;
+        const T rhs = div + term4;
+        const T next = rhs * t[m] * dt[m] + pc[m];
+        dst[m] = std::clamp(next, FieldState::liquid, FieldState::solid);
+      }
+    }
+  }
+
+  __attribute__((always_inline)) inline void tile(const EnsembleField2D &phi,
+                                                  EnsembleField2D &ret, const Box2D &out,
+                                                  T *s) const {
+    const int64_t ny = phi.rows();
+    const int64_t nx = phi.cols();
+    const auto lo = layout(out.x1 - out.x0);
+    for (int64_t y = out.y0 - 2; y < out.y0 + 2; ++y) {
+      load_row(phi, y, out, s + lo.phi(ring(y, 4)));
+    }
+    flux_row(out.y0 - 1, out, ny, nx, lo, s);
+    flux_row(out.y0, out, ny, nx, lo, s);
+    for (int64_t y = out.y0; y < out.y1; ++y) {
+      load_row(phi, y + 2, out, s + lo.phi(ring(y + 2, 4)));
+      flux_row(y + 1, out, ny, nx, lo, s);
+      predict_row(y, out, lo, s, ret);
+    }
+  }
+
+  /*
+   * The lane loops are inlined into one copy of the tile per instruction set, so they are
+   * vectorized as wide as the running CPU allows without building for it.
+   */
+  using TileFn = void (EnsemblePhaseField2D::*)(const EnsembleField2D &, EnsembleField2D &,
+                                                const Box2D &, T *) const;
+
+  inline void tile_default(const EnsembleField2D &phi, EnsembleField2D &ret, const Box2D &out,
+                           T *s) const {
+    tile(phi, ret, out, s);
+  }
+#if defined(__x86_64__) || defined(__i386__)
+  __attribute__((target("avx2"))) inline void
+  tile_avx2(const EnsembleField2D &phi, EnsembleField2D &ret, const Box2D &out, T *s) const {
+    tile(phi, ret, out, s);
+  }
+  __attribute__((target("avx512f"))) inline void
+  tile_avx512(const EnsembleField2D &phi, EnsembleField2D &ret, const Box2D &out, T *s) const {
+    tile(phi, ret, out, s);
+  }
+#endif
+
+  static inline TileFn select_tile() {
+    switch (simd::isa()) {
+#if defined(__x86_64__) || defined(__i386__)
+    case simd::Isa::avx512:
+      return &EnsemblePhaseField2D::tile_avx512;
+    case simd::Isa::avx2:
+      return &EnsemblePhaseField2D::tile_avx2;
+#endif
+    default:
+      return &EnsemblePhaseField2D::tile_default;
+    }
+  }
+
+public:
+  EnsemblePhaseField2D(const std::vector<Param> &p)
+      : params(p), n_lanes((static_cast<int64_t>(p.size()) + EnsembleField2D::lane_multiple - 1) /
+                           EnsembleField2D::lane_multiple * EnsembleField2D::lane_multiple) {
+    if (p.empty()) {
+      throw std::invalid_argument("ensemble must have a member");
+    }
+    for (auto *v : {&c.ac_c1, &c.ac_c2, &c.ak_c1, &c.ak_c2, &c.W0, &c.tau0, &c.W0_sq,
+                    &c.aniso3_c1, &c.inv_2dx, &c.inv_dx_sq, &c.lambda_u, &c.dt}) {
+      v->resize(n_lanes);
+    }
+    for (int64_t m = 0; m < n_lanes; ++m) {
+      const auto &q = p[m < static_cast<int64_t>(p.size()) ? m : 0];
+      const auto a = FusedPredictKernel::get_aniso_coeff(q);
+      c.ac_c1[m] = a.ac_c1;
+      c.ac_c2[m] = a.ac_c2;
+      c.ak_c1[m] = a.ak_c1;
+      c.ak_c2[m] = a.ak_c2;
+      c.W0[m] = a.W0;
+      c.tau0[m] = a.tau0;
+      c.W0_sq[m] = a.aniso2_c1;
+      c.aniso3_c1[m] = a.aniso3_c1;
+      c.inv_2dx[m] = 1.0 / (2.0 * q.dx);
+      c.inv_dx_sq[m] = 1.0 / (q.dx * q.dx);
+      c.lambda_u[m] = q.u * q.lambda;
+      c.dt[m] = q.dt;
+    }
+  }
+
+  inline int64_t members() const { return static_cast<int64_t>(params.size()); }
+
+  /**
+   * @brief Field for the ensemble on a (ny x nx) grid, every member liquid
+   */
+  inline EnsembleField2D make_field(const int64_t ny, const int64_t nx) const {
+    return EnsembleField2D(ny, nx, members());
+  }
+
+  /**
+   * @brief Advance every member by one step of its own dt
+   *
+   * @param phi current phase fields
+   * @param ret next phase fields
+   */
+  inline void predict(const EnsembleField2D &phi, EnsembleField2D &ret) const {
+    if (!phi.same_shape(ret) || phi.lanes() != n_lanes) {
+      throw std::runtime_error("invalid shape of ensemble given");
+    }
+    const int64_t ny = phi.rows();
+    const int64_t nx = phi.cols();
+    const int64_t tx = tile_x(nx);
+    const int64_t n_ty = (ny + tile_y - 1) / tile_y;
+    const int64_t n_tx = (nx + tx - 1) / tx;
+    const auto size = static_cast<std::size_t>(layout(tx).size());
+    static const TileFn tile_fn = select_tile();
+    scratch.resize(std::max<std::size_t>(scratch.size(), omp_get_max_threads()));
+    for (auto &s : scratch) {
+      if (s.size() < size) {
+        s.assign(size, 0.0);
+      }
+    }
+#pragma omp parallel
+    {
+      T *s = scratch[omp_get_thread_num()].data();
+#pragma omp for collapse(2) schedule(static)
+      for (int64_t ty = 0; ty < n_ty; ++ty) {
+        for (int64_t i = 0; i < n_tx; ++i) {
+          const Box2D out{ty * tile_y, std::min(ny, (ty + 1) * tile_y), i * tx,
+                          std::min(nx, (i + 1) * tx)};
+          (this->*tile_fn)(phi, ret, out, s);
+        }
+      }
+    }
+  }
+};
+} // namespace phase_field
+
+#endif // __PHASE_FIELD__ENSEMBLE__
@@ -0,0 +1,576 @@
+/*
+ * Copyright (c) 2025 Materials Modelling Lab, The University of Tokyo
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __PHASE_FIELD__FFT__
+#define __PHASE_FIELD__FFT__
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <omp.h>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#ifdef PHASE_FIELD_FFTW
+#include <fftw3.h>
+#endif
+
+namespace phase_field::fft {
+using T = double;
+using Complex = std::complex<T>;
+
+/**
+ * @brief Complex discrete Fourier transforms of one length, batch at a time, unnormalized
+ *  Mixed radix Stockham autosort: the length is split into factors 4, 2, 3 and 5, which have
+ *  dedicated butterflies, and any other prime, done as a direct DFT of that factor. The
+ *  twiddle factors of every pass are computed once by the plan.
+ *
+ *  The batch transforms are interleaved with real and imaginary parts apart, re[i batch + b]
+ *  being the sample i of the transform b, so every butterfly is a loop over the batch that the
+ *  compiler vectorizes whatever the length.
+ */
+class Plan {
+public:
+  static constexpr int64_t batch = 8;
+
+private:
+  struct Pass {
+    int64_t radix;
+    int64_t stride; // product of the radices of the previous passes
+    std::vector<Complex> twiddle;
+    std::vector<Complex> root; // roots of unity of a generic radix
+  };
+  int64_t len = 0;
+  std::vector<Pass> passes;
+
+  static inline Complex unit(const T turns) {
+    const T a = T(2) * T(M_PI) * turns;
+    return {std::cos(a), std::sin(a)};
+  }
+
+  /*
+   * One pass, j = q s + k: the P inputs x[j + r len / P] times the twiddles of k, transformed
+   * and stored in y[q s P + k + r s]. sign is -1 forward and +1 inverse.
+   */
+  template <int64_t P>
+  inline void pass(const Pass &ps, const T *xr, const T *xi, T *yr, T *yi, const T sign) const {
+    constexpr int64_t B = batch;
+    const int64_t n_p = len / P;
+    const int64_t s = ps.stride;
+    T vr[P][B], vi[P][B];
+    for (int64_t q = 0; q < n_p / s; ++q) {
+      for (int64_t k = 0; k < s; ++k) {
+        const int64_t j = q * s + k;
+        const Complex *w = ps.twiddle.data() + k * P;
+        for (int64_t r = 0; r < P; ++r) {
+          const T wr = w[r].real();
+          const T wi = sign * -w[r].imag();
+          const T *ar = xr + (j + r * n_p) * B;
+          const T *ai = xi + (j + r * n_p) * B;
+          for (int64_t b = 0; b < B; ++b) {
+            vr[r][b] = ar[b] * wr - ai[b] * wi;
+            vi[r][b] = ar[b] * wi + ai[b] * wr;
+          }
+        }
+        T *or_ = yr + (q * s * P + k) * B;
+        T *oi = yi + (q * s * P + k) * B;
+        const int64_t os = s * B;
+        if constexpr (P == 2) {
+          for (int64_t b = 0; b < B; ++b) {
+            or_[b] = vr[0][b] + vr[1][b];
+            oi[b] = vi[0][b] + vi[1][b];
+            or_[os + b] = vr[0][b] - vr[1][b];
+            oi[os + b] = vi[0][b] - vi[1][b];
+          }
+        } else if constexpr (P == 3) {
+          const T s3 = sign * T(0.86602540378443864676);
+          for (int64_t b = 0; b < B; ++b) {
+            const T sr = vr[1][b] + vr[2][b], si = vi[1][b] + vi[2][b];
+            const T dr = vr[1][b] - vr[2][b], di = vi[1][b] - vi[2][b];
+            const T mr = vr[0][b] - T(0.5) * sr, mi = vi[0][b] - T(0.5) * si;
+            or_[b] = vr[0][b] + sr;
+            oi[b] = vi[0][b] + si;
+            or_[os + b] = mr - s3 * di;
+            oi[os + b] = mi + s3 * dr;
+            or_[2 * os + b] = mr + s3 * di;
+            oi[2 * os + b] = mi - s3 * dr;
+          }
+        } else if constexpr (P == 4) {
+          for (int64_t b = 0; b < B; ++b) {
+            const T ar = vr[0][b] + vr[2][b], ai = vi[0][b] + vi[2][b];
+            const T br = vr[0][b] - vr[2][b], bi = vi[0][b] - vi[2][b];
+            const T cr = vr[1][b] + vr[3][b], ci = vi[1][b] + vi[3][b];
+            const T dr = vr[1][b] - vr[3][b], di = vi[1][b] - vi[3][b];
+            or_[b] = ar + cr;
+            oi[b] = ai + ci;
+            or_[os + b] = br - sign * di;
+            oi[os + b] = bi + sign * dr;
+            or_[2 * os + b] = ar - cr;
+            oi[2 * os + b] = ai - ci;
+            or_[3 * os + b] = br + sign * di;
+            oi[3 * os + b] = bi - sign * dr;
+          }
+        } else if constexpr (P == 5) {
+          const T c1 = T(0.30901699437494742410), c2 = T(-0.80901699437494742410);
+          const T s1 = sign * T(0.95105651629515357212), s2 = sign * T(0.58778525229247312917);
+          for (int64_t b = 0; b < B; ++b) {
+            const T ar = vr[1][b] + vr[4][b], ai = vi[1][b] + vi[4][b];
+            const T br = vr[1][b] - vr[4][b], bi = vi[1][b] - vi[4][b];
+            const T cr = vr[2][b] + vr[3][b], ci = vi[2][b] + vi[3][b];
+            const T dr = vr[2][b] - vr[3][b], di = vi[2][b] - vi[3][b];
+            const T m1r = vr[0][b] + c1 * ar + c2 * cr, m1i = vi[0][b] + c1 * ai + c2 * ci;
+            const T m2r = vr[0][b] + c2 * ar + c1 * cr, m2i = vi[0][b] + c2 * ai + c1 * ci;
+            const T n1r = s1 * br + s2 * dr, n1i = s1 * bi + s2 * di;
+            const T n2r = s2 * br - s1 * dr, n2i = s2 * bi - s1 * di;
+            or_[b] = vr[0][b] + ar + cr;
+            oi[b] = vi[0][b] + ai + ci;
+            or_[os + b] = m1r - n1i;
+            oi[os + b] = m1i + n1r;
+            or_[4 * os + b] = m1r + n1i;
+            oi[4 * os + b] = m1i - n1r;
+            or_[2 * os + b] = m2r - n2i;
+            oi[2 * os + b] = m2i + n2r;
+            or_[3 * os + b] = m2r + n2i;
+            oi[3 * os + b] = m2i - n2r;
+          }
+        }
+      }
+    }
+  }
+
+  /* Pass of any radix p as a direct DFT, v holds 2 p batch values */
+  inline void pass_generic(const Pass &ps, const T *xr, const T *xi, T *yr, T *yi, const T sign,
+                           T *v) const {
+    constexpr int64_t B = batch;
+    const int64_t p = ps.radix;
+    const int64_t n_p = len / p;
+    const int64_t s = ps.stride;
+    T *vr = v;
+    T *vi = v + p * B;
+    for (int64_t q = 0; q < n_p / s; ++q) {
+      for (int64_t k = 0; k < s; ++k) {
+        const int64_t j = q * s + k;
+        const Complex *w = ps.twiddle.data() + k * p;
+        for (int64_t r = 0; r < p; ++r) {
+          const T wr = w[r].real();
+          const T wi = sign * -w[r].imag();
+          const T *ar = xr + (j + r * n_p) * B;
+          const T *ai = xi + (j + r * n_p) * B;
+          for (int64_t b = 0; b < B; ++b) {
+            vr[r * B + b] = ar[b] * wr - ai[b] * wi;
+            vi[r * B + b] = ar[b] * wi + ai[b] * wr;
+          }
+        }
+        for (int64_t m = 0; m < p; ++m) {
+          T *or_ = yr + (q * s * p + k + m * s) * B;
+          T *oi = yi + (q * s * p + k + m * s) * B;
+          std::fill(or_, or_ + B, T(0));
+          std::fill(oi, oi + B, T(0));
+          for (int64_t r = 0, i = 0; r < p; ++r, i = (i + m) % p) {
+            const T wr = ps.root[i].real();
+            const T wi = sign * -ps.root[i].imag();
+            for (int64_t b = 0; b < B; ++b) {
+              or_[b] += vr[r * B + b] * wr - vi[r * B + b] * wi;
+              oi[b] += vr[r * B + b] * wi + vi[r * B + b] * wr;
+            }
+          }
+        }
+      }
+    }
+  }
+
+public:
+  Plan() = default;
+
+  /**
+   * @param n length of the transform
+   */
+  explicit Plan(const int64_t n) : len(n) {
+    if (n < 1) {
+      throw std::invalid_argument("transform length must be positive");
+    }
+    std::vector<int64_t> radices;
+    int64_t m = n;
+    for (const int64_t p : {4, 2, 3, 5}) {
+      while (m % p == 0) {
+        radices.push_back(p);
+        m /= p;
+      }
+    }
+    for (int64_t p = 7; p * p <= m; p += 2) {
+      while (m % p == 0) {
+        radices.push_back(p);
+        m /= p;
+      }
+    }
+    if (m > 1) {
+      radices.push_back(m);
+    }
+
+    int64_t stride = 1;
+    for (const auto p : radices) {
+      Pass ps{p, stride, std::vector<Complex>(stride * p), {}};
+      for (int64_t k = 0; k < stride; ++k) {
+        for (int64_t r = 0; r < p; ++r) {
+          ps.twiddle[k * p + r] = unit(-static_cast<T>(k * r) / static_cast<T>(stride * p));
+        }
+      }
+      if (p > 5) {
+        for (int64_t r = 0; r < p; ++r) {
+          ps.root.push_back(unit(-static_cast<T>(r) / static_cast<T>(p)));
+        }
+      }
+      passes.push_back(std::move(ps));
+      stride *= p;
+    }
+  }
+
+  inline int64_t size() const { return len; }
+
+  /**
+   * @brief Values of scratch execute needs: two batches of size() complex values and the
+   *  operands of a generic radix
+   */
+  inline int64_t scratch_size() const {
+    int64_t radix = 1;
+    for (const auto &ps : passes) {
+      radix = std::max(radix, ps.radix);
+    }
+    return 2 * batch * (len + radix);
+  }
+
+  /**
+   * @brief Transform the batch in place
+   *
+   * @param re real parts, len x batch
+   * @param im imaginary parts, len x batch
+   * @param work scratch of scratch_size() values
+   * @param sign -1 for the forward and +1 for the inverse transform
+   */
+  inline void execute(T *re, T *im, T *work, const T sign) const {
+    T *src[2] = {re, im};
+    T *dst[2] = {work, work + len * batch};
+    T *v = work + 2 * len * batch;
+    for (const auto &ps : passes) {
+      switch (ps.radix) {
+      case 2:
+        pass<2>(ps, src[0], src[1], dst[0], dst[1], sign);
+        break;
+      case 3:
+        pass<3>(ps, src[0], src[1], dst[0], dst[1], sign);
+        break;
+      case 4:
+        pass<4>(ps, src[0], src[1], dst[0], dst[1], sign);
+        break;
+      case 5:
+        pass<5>(ps, src[0], src[1], dst[0], dst[1], sign);
+        break;
+      default:
+        pass_generic(ps, src[0], src[1], dst[0], dst[1], sign, v);
+      }
+      std::swap(src, dst);
+    }
+    if (src[0] != re) {
+      std::copy(src[0], src[0] + len * batch, re);
+      std::copy(src[1], src[1] + len * batch, im);
+    }
+  }
+};
+
+/**
+ * @brief Cosine transform (DCT-II) of real rows of one length and its inverse (DCT-III)
+ *  The DCT-II diagonalizes the 5-point Laplacian with reflecting (zero flux) boundaries, with
+ *  eigenvalue -4 sin^2(pi k / 2n) / dx^2 for the cosine k. Rows are transformed rows_per_call
+ *  at a time: two rows share a complex transform of Plan, one as its real and one as its
+ *  imaginary part, after the even samples are put forward and the odd ones backward (Makhoul).
+ *  With PHASE_FIELD_FFTW defined, every row is transformed by FFTW instead.
+ *  inverse(forward(x)) is x.
+ */
+class Dct {
+public:
+  static constexpr int64_t rows_per_call = 2 * Plan::batch;
+
+  /**
+   * @brief Per-thread buffers of a transform
+   */
+  struct Scratch {
+    std::vector<T> re, im, work;
+  };
+
+private:
+  int64_t len = 0;
+#ifdef PHASE_FIELD_FFTW
+  fftw_plan fwd = nullptr, inv = nullptr;
+#else
+  Plan plan;
+  std::vector<int64_t> perm;  // sample of the row put at i
+  std::vector<Complex> shift; // exp(-i pi k / 2n)
+#endif
+
+public:
+  Dct() = default;
+  explicit Dct(const int64_t n) : len(n) {
+#ifdef PHASE_FIELD_FFTW
+    /* Planned once for unaligned rows, so each thread may execute it on its own rows */
+    std::vector<T> a(n), b(n);
+    const unsigned flags = FFTW_MEASURE | FFTW_UNALIGNED;
+    fwd = fftw_plan_r2r_1d(static_cast<int>(n), a.data(), b.data(), FFTW_REDFT10, flags);
+    inv = fftw_plan_r2r_1d(static_cast<int>(n), a.data(), b.data(), FFTW_REDFT01, flags);
+    if (!fwd || !inv) {
+      throw std::runtime_error("failed to plan the cosine transform");
+    }
+#else
+    plan = Plan(n);
+    perm.resize(n);
+    shift.resize(n);
+    for (int64_t i = 0; 2 * i < n; ++i) {
+      perm[i] = 2 * i;
+    }
+    for (int64_t i = 0; 2 * i + 1 < n; ++i) {
+      perm[n - 1 - i] = 2 * i + 1;
+    }
+    for (int64_t k = 0; k < n; ++k) {
+      const T a = -T(M_PI) * static_cast<T>(k) / static_cast<T>(2 * n);
+      shift[k] = {std::cos(a), std::sin(a)};
+    }
+#endif
+  }
+  Dct(const Dct &) = delete;
+  Dct &operator=(const Dct &) = delete;
+  Dct(Dct &&o) noexcept { *this = std::move(o); }
+  Dct &operator=(Dct &&o) noexcept {
+    std::swap(len, o.len);
+#ifdef PHASE_FIELD_FFTW
+    std::swap(fwd, o.fwd);
+    std::swap(inv, o.inv);
+#else
+    std::swap(plan, o.plan);
+    std::swap(perm, o.perm);
+    std::swap(shift, o.shift);
+#endif
+    return *this;
+  }
+  ~Dct() {
+#ifdef PHASE_FIELD_FFTW
+    if (fwd) {
+      fftw_destroy_plan(fwd);
+    }
+    if (inv) {
+      fftw_destroy_plan(inv);
+    }
+#endif
+  }
+
+  inline int64_t size() const { return len; }
+
+  inline void reserve(Scratch &s) const {
+#ifdef PHASE_FIELD_FFTW
+    if (static_cast<int64_t>(s.work.size()) < len) {
+      s.work.resize(len);
+    }
+#else
+    const auto n = static_cast<std::size_t>(len * Plan::batch);
+    if (s.re.size() < n) {
+      s.re.resize(n);
+      s.im.resize(n);
+    }
+    if (static_cast<int64_t>(s.work.size()) < plan.scratch_size()) {
+      s.work.resize(plan.scratch_size());
+    }
+#endif
+  }
+
+  /**
+   * @brief X[k] = sum_i x[i] cos(pi k (2 i + 1) / 2n) of count rows, in place
+   *
+   * @param x first row
+   * @param stride distance between two rows
+   * @param count rows, at most rows_per_call
+   * @param s scratch of the calling thread
+   */
+  inline void forward(T *x, const int64_t stride, const int64_t count, Scratch &s) const {
+    reserve(s);
+#ifdef PHASE_FIELD_FFTW
+    for (int64_t c = 0; c < count; ++c) {
+      T *row = x + c * stride;
+      fftw_execute_r2r(fwd, row, s.work.data());
+      for (int64_t k = 0; k < len; ++k) {
+        row[k] = T(0.5) * s.work[k];
+      }
+    }
+#else
+    constexpr int64_t B = Plan::batch;
+    T *re = s.re.data();
+    T *im = s.im.data();
+    for (int64_t b = 0; b < B; ++b) {
+      const T *ra = b < count ? x + b * stride : nullptr;
+      const T *rb = B + b < count ? x + (B + b) * stride : nullptr;
+      for (int64_t i = 0; i < len; ++i) {
+        re[i * B + b] = ra ? ra[perm[i]] : T(0);
+        im[i * B + b] = rb ? rb[perm[i]] : T(0);
+      }
+    }
+    plan.execute(re, im, s.work.data(), -1);
+    /* Z = V_a + i V_b: V_a[k] = (Z[k] + conj Z[n - k]) / 2, V_b[k] = (Z[k] - conj Z[n - k]) / 2i */
+    for (int64_t b = 0; b < B; ++b) {
+      T *ra = b < count ? x + b * stride : nullptr;
+      T *rb = B + b < count ? x + (B + b) * stride : nullptr;
+      for (int64_t k = 0; k < len; ++k) {
+        const int64_t m = k == 0 ? 0 : len - k;
+        const T zr = re[k * B + b], zi = im[k * B + b];
+        const T mr = re[m * B + b], mi = im[m * B + b];
+        const T cr = shift[k].real(), ci = shift[k].imag();
+        if (ra) {
+          ra[k] = T(0.5) * ((zr + mr) * cr - (zi - mi) * ci);
+        }
+        if (rb) {
+          rb[k] = T(0.5) * ((zi + mi) * cr + (zr - mr) * ci);
+        }
+      }
+    }
+#endif
+  }
+
+  /**
+   * @brief Inverse of forward of count rows, in place
+   */
+  inline void inverse(T *x, const int64_t stride, const int64_t count, Scratch &s) const {
+    reserve(s);
+#ifdef PHASE_FIELD_FFTW
+    const T scale = T(1) / static_cast<T>(len);
+    for (int64_t c = 0; c < count; ++c) {
+      T *row = x + c * stride;
+      fftw_execute_r2r(inv, row, s.work.data());
+      for (int64_t i = 0; i < len; ++i) {
+        row[i] = scale * s.work[i];
+      }
+    }
+#else
+    constexpr int64_t B = Plan::batch;
+    T *re = s.re.data();
+    T *im = s.im.data();
+    /* V[k] = conj(shift[k]) (X[k] - i X[n - k]) of both rows, packed as Z = V_a + i V_b */
+    for (int64_t b = 0; b < B; ++b) {
+      const T *ra = b < count ? x + b * stride : nullptr;
+      const T *rb = B + b < count ? x + (B + b) * stride : nullptr;
+      for (int64_t k = 0; k < len; ++k) {
+        const T cr = shift[k].real(), ci = shift[k].imag();
+        const T ar = ra ? ra[k] : T(0);
+        const T ai = ra && k > 0 ? -ra[len - k] : T(0);
+        const T br = rb ? rb[k] : T(0);
+        const T bi = rb && k > 0 ? -rb[len - k] : T(0);
+        const T var = ar * cr + ai * ci, vai = ai * cr - ar * ci;
+        const T vbr = br * cr + bi * ci, vbi = bi * cr - br * ci;
+        re[k * B + b] = var - vbi;
+        im[k * B + b] = vai + vbr;
+      }
+    }
+    plan.execute(re, im, s.work.data(), +1);
+    const T scale = T(1) / static_cast<T>(len);
+    for (int64_t b = 0; b < B; ++b) {
+      T *ra = b < count ? x + b * stride : nullptr;
+      T *rb = B + b < count ? x + (B + b) * stride : nullptr;
+      for (int64_t i = 0; i < len; ++i) {
+        if (ra) {
+          ra[perm[i]] = scale * re[i * B + b];
+        }
+        if (rb) {
+          rb[perm[i]] = scale * im[i * B + b];
+        }
+      }
+    }
+#endif
+  }
+};
+
+/**
+ * @brief Cosine transform of a row-major ny x nx array, a scaling of every mode and the inverse
+ *  Rows are transformed in place, the array is transposed into a buffer so the columns become
+ *  rows, and transposed back; every step is work-shared over the threads of a parallel region.
+ */
+class Dct2D {
+  static constexpr int64_t block = 32; // edge of the tiles of the transpose
+  static constexpr int64_t rows = Dct::rows_per_call;
+
+  int64_t ny = 0, nx = 0;
+  Dct dct_x, dct_y;
+  std::vector<T> buf;
+  std::vector<Dct::Scratch> scratch;
+
+  /* dst (m x n) = transpose of src (n x m), tile by tile */
+  static inline void transpose(const T *src, T *dst, const int64_t n, const int64_t m) {
+    const int64_t n_tn = (n + block - 1) / block;
+    const int64_t n_tm = (m + block - 1) / block;
+#pragma omp for collapse(2) schedule(static)
+    for (int64_t tn = 0; tn < n_tn; ++tn) {
+      for (int64_t tm = 0; tm < n_tm; ++tm) {
+        for (int64_t i = tn * block; i < std::min(n, (tn + 1) * block); ++i) {
+          for (int64_t j = tm * block; j < std::min(m, (tm + 1) * block); ++j) {
+            dst[j * n + i] = src[i * m + j];
+          }
+        }
+      }
+    }
+  }
+
+public:
+  Dct2D() = default;
+
+  /**
+   * @brief Plan the transforms of a ny x nx array, nothing is done when the shape is the same
+   *  Must be called outside of the parallel region.
+   */
+  inline void reserve(const int64_t n_y, const int64_t n_x) {
+    if (n_y != ny || n_x != nx) {
+      ny = n_y;
+      nx = n_x;
+      dct_x = Dct(nx);
+      dct_y = Dct(ny);
+      buf.assign(static_cast<std::size_t>(ny * nx), T(0));
+    }
+    const auto n_threads = static_cast<std::size_t>(omp_get_max_threads());
+    if (scratch.size() < n_threads) {
+      scratch.resize(n_threads);
+    }
+  }
+
+  /**
+   * @brief a = inverse(scale * forward(a)), scale(ky, kx) being the factor of the mode (ky, kx)
+   *  Must be called from inside an OpenMP parallel region, by every thread of it.
+   *
+   * @param a row-major ny x nx array of the shape given to reserve
+   * @param scale factor of a mode
+   */
+  template <typename Scale> inline void filter(T *a, Scale &&scale) {
+    auto &s = scratch[static_cast<std::size_t>(omp_get_thread_num())];
+#pragma omp for schedule(static)
+    for (int64_t y = 0; y < ny; y += rows) {
+      dct_x.forward(a + y * nx, nx, std::min(rows, ny - y), s);
+    }
+    transpose(a, buf.data(), ny, nx);
+#pragma omp for schedule(static)
+    for (int64_t kx = 0; kx < nx; kx += rows) {
+      const int64_t count = std::min(rows, nx - kx);
+      T *col = buf.data() + kx * ny;
+      dct_y.forward(col, ny, count, s);
+      for (int64_t c = 0; c < count; ++c) {
+        for (int64_t ky = 0; ky < ny; ++ky) {
+          col[c * ny + ky] *= scale(ky, kx + c);
+        }
+      }
+      dct_y.inverse(col, ny, count, s);
+    }
+    transpose(buf.data(), a, nx, ny);
+#pragma omp for schedule(static)
+    for (int64_t y = 0; y < ny; y += rows) {
+      dct_x.inverse(a + y * nx, nx, std::min(rows, ny - y), s);
+    }
+  }
+};
+} // namespace phase_field::fft
+
+#endif // __PHASE_FIELD__FFT__
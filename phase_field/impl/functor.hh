@@ -10,89 +10,103 @@
 #include "type.hh"
 #include <algorithm>
 
+/*
+ * Every functor is templated on the scalar type it computes in. Coefficients are given in
+ * double (Param) and rounded once to T on construction.
+ */
 namespace phase_field {
-struct FieldClampFunctor {
-  using T = Field2D::scalar_type;
+template <typename T = Field2D::scalar_type> struct FieldClampFunctor {
   inline void operator()(T &ret) const {
-    ret = std::clamp(ret, FieldState::liquid, FieldState::solid);
+    ret = std::clamp(ret, static_cast<T>(FieldState::liquid), static_cast<T>(FieldState::solid));
   }
 };
 
-struct InvAbsN4Functor {
-  using T = Field2D::scalar_type;
+template <typename T = Field2D::scalar_type> struct InvAbsN4Functor {
   inline void operator()(T &ret, const T &dphi_dx, const T &dphi_dy) const {
-    const T tmp = std::pow((std::pow(dphi_dx, 2.0) + std::pow(dphi_dy, 2.0)), 2.0);
-    ret = tmp == 0.0 ? 0.0 : 1.0 / tmp;
+    const T abs_sq = dphi_dx * dphi_dx + dphi_dy * dphi_dy;
+    const T tmp = abs_sq * abs_sq;
+    ret = tmp == T(0) ? T(0) : T(1) / tmp;
   }
 };
 
-struct N4Functor {
-  using T = Field2D::scalar_type;
+template <typename T = Field2D::scalar_type> struct N4Functor {
   inline void operator()(T &ret, const T &dphi_dx, const T &dphi_dy, const T &inv_abs_n4) const {
-    ret = (std::pow(dphi_dx, 4.0) + std::pow(dphi_dy, 4.0)) * inv_abs_n4;
+    const T dx_sq = dphi_dx * dphi_dx;
+    const T dy_sq = dphi_dy * dphi_dy;
+    ret = (dx_sq * dx_sq + dy_sq * dy_sq) * inv_abs_n4;
   }
 };
 
-struct AcFunctor {
-  using T = Field2D::scalar_type;
+template <typename T = Field2D::scalar_type> struct AcFunctor {
   const T c1, c2;
-  AcFunctor(const T &epsilon_c) : c1(1.0 - 3.0 * epsilon_c), c2(4.0 * epsilon_c) {}
+  AcFunctor(const double epsilon_c) : c1(1.0 - 3.0 * epsilon_c), c2(4.0 * epsilon_c) {}
   inline void operator()(T &ret, const T &n4) const { ret = c1 + c2 * n4; }
 };
 
-struct AkFunctor {
-  using T = Field2D::scalar_type;
+template <typename T = Field2D::scalar_type> struct AkFunctor {
   const T c1, c2;
-  AkFunctor(const T &epsilon_k) : c1(1.0 + 3.0 * epsilon_k), c2(4.0 * epsilon_k) {}
+  AkFunctor(const double epsilon_k) : c1(1.0 + 3.0 * epsilon_k), c2(4.0 * epsilon_k) {}
   inline void operator()(T &ret, const T &n4) const { ret = c1 - c2 * n4; }
 };
 
-struct Aniso2Functor {
-  using T = Field2D::scalar_type;
+template <typename T = Field2D::scalar_type> struct Aniso2Functor {
   const T c1;
-  Aniso2Functor(const T &W0) : c1(std::pow(W0, 2.0)) {}
+  Aniso2Functor(const double W0) : c1(W0 * W0) {}
   inline void operator()(T &ret, const T &W, const T &dphi_dw) const {
-    ret = (std::pow(W, 2.0) - c1) * dphi_dw;
+    ret = (W * W - c1) * dphi_dw;
   }
 };
 
-struct Aniso3Functor {
-  using T = Field2D::scalar_type;
+template <typename T = Field2D::scalar_type> struct Aniso3Functor {
   const T c1;
-  Aniso3Functor(const T &W0, const T &epsilon_c) : c1(16.0 * W0 * epsilon_c) {}
+  Aniso3Functor(const double W0, const double epsilon_c) : c1(16.0 * W0 * epsilon_c) {}
   inline void operator()(T &ret, const T &W, const T &dphi_dx, const T &dphi_dy,
                          const T &abs_n4_inv) const {
-    ret = c1 * W *
-          (std::pow(dphi_dx, 3.0) * std::pow(dphi_dy, 2.0) - (dphi_dx * std::pow(dphi_dy, 4.0))) *
-          abs_n4_inv;
+    const T dx_sq = dphi_dx * dphi_dx;
+    const T dy_sq = dphi_dy * dphi_dy;
+    ret = c1 * W * (dx_sq * dphi_dx * dy_sq - dphi_dx * (dy_sq * dy_sq)) * abs_n4_inv;
   }
 };
 
-struct TauInvFunctor {
-  using T = Field2D::scalar_type;
-  const T &tau0;
-  TauInvFunctor(const T &t) : tau0(t) {}
+template <typename T = Field2D::scalar_type> struct TauInvFunctor {
+  const T tau0;
+  TauInvFunctor(const double t) : tau0(t) {}
   inline void operator()(T &ret, const T &ac, const T &ak) const {
     const T tmp = tau0 * ac * ak;
-    ret = tmp == 0.0 ? 0.0 : 1.0 / tmp;
+    ret = tmp == T(0) ? T(0) : T(1) / tmp;
   }
 };
 
-struct ChemPotFunctor {
-  using T = Field2D::scalar_type;
-  const T &u;
-  const T &lambda;
-  ChemPotFunctor(const T &_u, const T &l) : u(_u), lambda(l) {}
+template <typename T = Field2D::scalar_type> struct ChemPotFunctor {
+  const T u;
+  const T lambda;
+  ChemPotFunctor(const double _u, const double l) : u(_u), lambda(l) {}
   inline void operator()(T &ret, const T &phi) const {
-    const T dw_pot = 1.0 - std::pow(phi, 2.0);
+    const T dw_pot = T(1) - phi * phi;
+    ret = (phi - u * lambda * dw_pot) * dw_pot;
+  }
+};
+
+template <typename T = Field2D::scalar_type> struct ChemPotFieldFunctor {
+  const T lambda;
+  ChemPotFieldFunctor(const double l) : lambda(l) {}
+  inline void operator()(T &ret, const T &phi, const T &u) const {
+    const T dw_pot = T(1) - phi * phi;
     ret = (phi - u * lambda * dw_pot) * dw_pot;
   }
 };
 
-struct PredictFunctor {
-  using T = Field2D::scalar_type;
-  const T &dt;
-  PredictFunctor(const T &d) : dt(d) {}
+template <typename T = Field2D::scalar_type> struct HeatFunctor {
+  const T c1;
+  HeatFunctor(const double D, const double dt, const double dx) : c1(D * dt / (dx * dx)) {}
+  inline void operator()(T &next, const T &lap, const T &u, const T &dphi) const {
+    next = u + c1 * lap + T(0.5) * dphi;
+  }
+};
+
+template <typename T = Field2D::scalar_type> struct PredictFunctor {
+  const T dt;
+  PredictFunctor(const double d) : dt(d) {}
   inline void operator()(T &next, const T &lhs_inv, const T &rhs, const T &prev) const {
     next = rhs * lhs_inv * dt + prev;
   }
@@ -0,0 +1,435 @@
+/*
+ * Copyright (c) 2025 Materials Modelling Lab, The University of Tokyo
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __PHASE_FIELD__KERNEL__
+#define __PHASE_FIELD__KERNEL__
+
+#include "../param.hh"
+#include "../profile.hh"
+#include "functor.hh"
+#include "simd.hh"
+#include "type.hh"
+#include <algorithm>
+#include <cmath>
+#include <omp.h>
+#include <type_traits>
+#include <vector>
+
+namespace phase_field {
+/**
+ * @brief Half open rectangle [y0, y1) x [x0, x1) in grid index
+ */
+struct Box2D {
+  int64_t y0, y1, x0, x1;
+
+  inline bool contains(const int64_t y, const int64_t x) const {
+    return y0 <= y && y < y1 && x0 <= x && x < x1;
+  }
+  inline bool empty() const { return y1 <= y0 || x1 <= x0; }
+  inline Box2D intersect(const Box2D &b) const {
+    return {std::max(y0, b.y0), std::min(y1, b.y1), std::max(x0, b.x0), std::min(x1, b.x1)};
+  }
+};
+
+/**
+ * @brief Per-step reduction used to choose the next time step
+ *  max_rate is the largest explicit stability rate, so forward Euler is stable for
+ *  dt <= 1 / max_rate. Per cell it is tau_inv (4 W^2 / dx^2 + |df/dphi| / 2), following from
+ *  the 5-point Laplacian (eigenvalues down to -8 / dx^2) and the linearized chemical potential.
+ *  max_dphi is the largest change of phi over the step.
+ */
+template <typename T> struct BasicStepStats {
+  T max_rate = 0.0;
+  T max_dphi = 0.0;
+
+  inline void merge(const BasicStepStats &o) {
+    max_rate = std::max(max_rate, o.max_rate);
+    max_dphi = std::max(max_dphi, o.max_dphi);
+  }
+  inline T dt_stable() const { return max_rate == T(0) ? T(0) : T(1) / max_rate; }
+};
+
+using StepStats = BasicStepStats<Field2D::scalar_type>;
+
+/**
+ * @brief Parameters the right hand side is evaluated with in the scalar type T
+ *  In float, lengths are measured in grid spacings (dx = 1 and W0 / dx). The equation is the
+ *  same, but the fifth power of |grad phi| in the anisotropic flux, about 1e40 across a sharp
+ *  interface in metres, would overflow.
+ */
+template <typename T> inline Param compute_param(const Param &p) {
+  if constexpr (std::is_same_v<T, float>) {
+    Param ret = p;
+    ret.W0 = p.W0 / p.dx;
+    ret.dx = 1.0;
+    return ret;
+  } else {
+    return p;
+  }
+}
+
+/**
+ * @brief Single pass version of PhaseField2D::predict_reference
+ *  The gradient, the anisotropy functors and the divergence terms are evaluated tile by tile.
+ *  The anisotropy functors run as the SIMD row kernel picked for the running CPU.
+ *  Only four rows of phi and three rows of face fluxes per tile are kept, so the working set
+ *  stays in cache and each step streams phi and ret exactly once.
+ *
+ *  Cells outside the valid box are treated as zero, the same as the zero padding of conv2d.
+ *  The result is not bitwise identical to the reference path since the stencil weights are
+ *  applied in a different order; the difference is a few ULP per step (|dphi| < 1e-12).
+ *
+ *  phi is stored in S and the right hand side is computed in A: rows are converted to A when
+ *  loaded and the update is rounded to S when stored, so float storage with double arithmetic
+ *  halves the traffic while the step is still accumulated in double.
+ */
+template <typename S, typename A = S> class BasicFusedPredictKernel {
+public:
+  using T = A;
+  using Field = BasicField2D<S>;
+  using Stats = BasicStepStats<T>;
+  static constexpr int64_t tile_y = 32;
+  static constexpr int64_t tile_x = 256;
+
+  /**
+   * @brief Per-thread row buffers of one tile
+   */
+  class Scratch {
+    std::vector<T> buf;
+    int64_t width = 0;
+
+  public:
+    /* phi ring:  4 rows of (width + 4) */
+    /* flux ring: 5 quantities x 3 rows of (width + 2) */
+    /* gradient:  2 rows of (width + 2) */
+    /* div:       1 row of (width + 2) */
+    inline void reserve(const int64_t w) {
+      if (w > width) {
+        width = w;
+        buf.assign(4 * (w + 4) + 18 * (w + 2), T(0));
+      }
+    }
+    inline T *phi(const int64_t slot) { return buf.data() + slot * (width + 4); }
+    inline T *flux(const int64_t q, const int64_t slot) {
+      return buf.data() + 4 * (width + 4) + (3 * q + slot) * (width + 2);
+    }
+    inline T *grad(const int64_t q) { return flux(5, q); }
+    inline T *div() { return flux(5, 2); }
+  };
+
+private:
+  const T W0_sq;
+  const T inv_2dx;
+  const T inv_dx_sq;
+  const simd::BasicAnisoCoeff<T> aniso_coeff;
+  const simd::BasicAnisoRowFn<T> aniso_row;
+  const T lambda_u;
+  const T diffusion_rate;
+  ChemPotFunctor<T> chem_func;
+  FieldClampFunctor<T> clamp_func;
+  PredictFunctor<T> predict_func;
+
+  /* Flux quantities stored in the flux ring */
+  enum { fx2 = 0, fy2, fx3, fy3, tinv };
+
+  static inline int64_t ring(const int64_t i, const int64_t n) { return ((i % n) + n) % n; }
+
+  template <typename In>
+  inline void load_row(const In &phi, const int64_t y, const Box2D &cols, const Box2D &valid,
+                       T *dst) const {
+    PHASE_FIELD_PROFILE_SCOPE(load, (cols.x1 - cols.x0) * (sizeof(S) + sizeof(T)));
+    if (y < valid.y0 || y >= valid.y1) {
+      std::fill(dst, dst + (cols.x1 - cols.x0), T(0));
+      return;
+    }
+    /* Split into the zero columns left and right of valid and the copy in between */
+    const auto &row = phi[y];
+    const int64_t lo = std::clamp(valid.x0, cols.x0, cols.x1);
+    const int64_t hi = std::clamp(valid.x1, lo, cols.x1);
+    std::fill(dst, dst + (lo - cols.x0), T(0));
+    for (int64_t x = lo; x < hi; ++x) {
+      dst[x - cols.x0] = static_cast<T>(row[x]);
+    }
+    std::fill(dst + (hi - cols.x0), dst + (cols.x1 - cols.x0), T(0));
+  }
+
+  inline void flux_row(const int64_t y, const Box2D &out, const Box2D &valid, Scratch &s) const {
+    const int64_t w = out.x1 - out.x0 + 2;
+    T *f[5];
+    for (int64_t q = 0; q < 5; ++q) {
+      f[q] = s.flux(q, ring(y, 3));
+    }
+    if (y < valid.y0 || y >= valid.y1) {
+      for (int64_t q = 0; q < 5; ++q) {
+        std::fill(f[q], f[q] + w, T(0));
+      }
+      return;
+    }
+
+    /* phi rows are offset by 2 columns, fluxes by 1 column from out.x0 */
+    const T *p_n = s.phi(ring(y - 1, 4)) + 1;
+    const T *p_c = s.phi(ring(y, 4)) + 1;
+    const T *p_s = s.phi(ring(y + 1, 4)) + 1;
+    T *gx = s.grad(0);
+    T *gy = s.grad(1);
+    {
+      PHASE_FIELD_PROFILE_SCOPE(gradient, 5 * w * sizeof(T));
+      for (int64_t i = 0; i < w; ++i) {
+        gx[i] = (p_c[i + 1] - p_c[i - 1]) * inv_2dx;
+        gy[i] = (p_s[i] - p_n[i]) * inv_2dx;
+      }
+    }
+    PHASE_FIELD_PROFILE_SCOPE(anisotropy, 7 * w * sizeof(T));
+    aniso_row(aniso_coeff, {gx, gy, f[tinv], f[fx2], f[fy2], f[fx3], f[fy3]}, 0, w);
+
+    /* Fluxes outside the valid box are zero padded like conv2d */
+    const int64_t lo = std::clamp(valid.x0 - (out.x0 - 1), int64_t(0), w);
+    const int64_t hi = std::clamp(valid.x1 - (out.x0 - 1), lo, w);
+    for (int64_t q = 0; q < 5; ++q) {
+      std::fill(f[q], f[q] + lo, T(0));
+      std::fill(f[q] + hi, f[q] + w, T(0));
+    }
+  }
+
+  /* Sum of every term of the right hand side except the chemical potential */
+  inline void divergence_row(const int64_t y, const Box2D &out, Scratch &s) const {
+    PHASE_FIELD_PROFILE_SCOPE(divergence, 10 * (out.x1 - out.x0) * sizeof(T));
+    const T *p_n = s.phi(ring(y - 1, 4)) + 2;
+    const T *p_c = s.phi(ring(y, 4)) + 2;
+    const T *p_s = s.phi(ring(y + 1, 4)) + 2;
+    const T *f_n[5], *f_c[5], *f_s[5];
+    for (int64_t q = 0; q < 5; ++q) {
+      f_n[q] = s.flux(q, ring(y - 1, 3)) + 1;
+      f_c[q] = s.flux(q, ring(y, 3)) + 1;
+      f_s[q] = s.flux(q, ring(y + 1, 3)) + 1;
+    }
+
+    T *div = s.div();
+    for (int64_t i = 0; i < out.x1 - out.x0; ++i) {
+      const T lap = (p_n[i] + p_s[i] + p_c[i - 1] + p_c[i + 1] - T(4) * p_c[i]) * inv_dx_sq;
+      const T term1 = lap * W0_sq;
+      const T term2_dx = (f_c[fx2][i + 1] - f_c[fx2][i - 1]) * inv_2dx;
+      const T term2_dy = (f_s[fy2][i] - f_n[fy2][i]) * inv_2dx;
+      const T term3_dx = (f_c[fx3][i + 1] - f_c[fx3][i - 1]) * inv_2dx;
+      const T term3_dy = (f_s[fy3][i] - f_n[fy3][i]) * inv_2dx;
+      div[i] = term1 + term2_dx + term2_dy + term3_dx + term3_dy;
+    }
+  }
+
+  template <typename Out>
+  inline void predict_row(const int64_t y, const Box2D &out, const T *phi, const T *div,
+                          const T *tau_inv, Out &ret) const {
+    PHASE_FIELD_PROFILE_SCOPE(update, (out.x1 - out.x0) * (3 * sizeof(T) + sizeof(S)));
+    auto &&row = ret[y];
+    for (int64_t i = 0; i < out.x1 - out.x0; ++i) {
+      T term4;
+      chem_func(term4, phi[i]);
+      const T rhs = div[i] + term4;
+
+      T next;
+      predict_func(next, tau_inv[i], rhs, phi[i]);
+      clamp_func(next);
+      row[out.x0 + i] = static_cast<S>(next);
+    }
+  }
+
+  /* Same as predict_row with a time step given at call time, reducing the step statistics */
+  inline void predict_row(const int64_t y, const Box2D &out, const T *phi, const T *div,
+                          const T *tau_inv, const T dt, Field &ret, Stats &stats) const {
+    PHASE_FIELD_PROFILE_SCOPE(update, (out.x1 - out.x0) * (3 * sizeof(T) + sizeof(S)));
+    const PredictFunctor<T> step_func(dt);
+    auto &&row = ret[y];
+    T max_rate = stats.max_rate;
+    T max_dphi = stats.max_dphi;
+    for (int64_t i = 0; i < out.x1 - out.x0; ++i) {
+      T term4;
+      chem_func(term4, phi[i]);
+      const T rhs = div[i] + term4;
+
+      T next;
+      step_func(next, tau_inv[i], rhs, phi[i]);
+      clamp_func(next);
+      row[out.x0 + i] = static_cast<S>(next);
+
+      const T phi_sq = phi[i] * phi[i];
+      const T dchem = T(1) - T(3) * phi_sq + T(4) * lambda_u * phi[i] * (T(1) - phi_sq);
+      max_rate = std::max(max_rate, tau_inv[i] * (diffusion_rate + T(0.5) * std::abs(dchem)));
+      max_dphi = std::max(max_dphi, std::abs(next - phi[i]));
+    }
+    stats.max_rate = max_rate;
+    stats.max_dphi = max_dphi;
+  }
+
+  /* q is p in the units of the right hand side, see compute_param */
+  BasicFusedPredictKernel(const Param &p, const Param &q)
+      : W0_sq(q.W0 * q.W0), inv_2dx(1.0 / (2.0 * q.dx)), inv_dx_sq(1.0 / (q.dx * q.dx)),
+        aniso_coeff(get_aniso_coeff(q)), aniso_row(simd::aniso_row<T>()),
+        lambda_u(p.lambda * p.u),
+        diffusion_rate(4.0 * W0_sq * (1.0 + 15.0 * p.epsilon_c) * inv_dx_sq),
+        chem_func(p.u, p.lambda), predict_func(p.dt) {}
+
+public:
+  /*
+   * W^2 (1 + 15 epsilon_c) bounds the stiffness of the anisotropic operator, W^2 a (a + a'')
+   * with a = 1 + epsilon_c cos(4 theta); only tau_inv is reduced per cell.
+   *
+   * @param p parameters, taken through compute_param<A>
+   */
+  BasicFusedPredictKernel(const Param &p) : BasicFusedPredictKernel(p, compute_param<T>(p)) {}
+
+  static inline simd::BasicAnisoCoeff<T> get_aniso_coeff(const Param &p) {
+    const AcFunctor<T> ac(p.epsilon_c);
+    const AkFunctor<T> ak(p.epsilon_k);
+    return {ac.c1, ac.c2, ak.c1, ak.c2, static_cast<T>(p.W0), static_cast<T>(p.tau0),
+            Aniso2Functor<T>(p.W0).c1, Aniso3Functor<T>(p.W0, p.epsilon_c).c1};
+  }
+
+  /**
+   * @brief Evaluate the right hand side over the cells in the out box
+   *  For every row y of out, update(y, out, phi, div, tau_inv) receives rows starting at
+   *  column out.x0: the current phi, the right hand side without the chemical potential, and
+   *  1 / tau. The update decides how the row is advanced and where it is stored.
+   *  phi is a Field or any type whose phi[y][x] reads the cells of valid in grid index.
+   *
+   * @param phi current phase field
+   * @param out cells to be updated, must be inside valid
+   * @param valid cells holding phi, everything outside is zero
+   * @param s scratch of the calling thread
+   * @param update row update
+   */
+  template <typename In, typename Update>
+  inline void tile(const In &phi, const Box2D &out, const Box2D &valid, Scratch &s,
+                   Update &&update) const {
+    if (out.empty()) {
+      return;
+    }
+    s.reserve(out.x1 - out.x0);
+    const Box2D cols{0, 0, out.x0 - 2, out.x1 + 2};
+    for (int64_t y = out.y0 - 2; y < out.y0 + 2; ++y) {
+      load_row(phi, y, cols, valid, s.phi(ring(y, 4)));
+    }
+    flux_row(out.y0 - 1, out, valid, s);
+    flux_row(out.y0, out, valid, s);
+    for (int64_t y = out.y0; y < out.y1; ++y) {
+      load_row(phi, y + 2, cols, valid, s.phi(ring(y + 2, 4)));
+      flux_row(y + 1, out, valid, s);
+      divergence_row(y, out, s);
+      const T *p = s.phi(ring(y, 4)) + 2;
+      const T *div = s.div();
+      const T *tau_inv = s.flux(tinv, ring(y, 3)) + 1;
+      update(y, out, p, div, tau_inv);
+    }
+  }
+
+  /**
+   * @brief Advance the cells in the out box by one step
+   *  Like phi, ret may be any type whose ret[y][x] writes the cells of out in grid index.
+   *
+   * @param phi current phase field
+   * @param ret next phase field, only the cells in out are written
+   * @param out cells to be updated, must be inside valid
+   * @param valid cells holding phi, everything outside is zero
+   * @param s scratch of the calling thread
+   */
+  template <typename In, typename Out>
+  inline void tile(const In &phi, Out &ret, const Box2D &out, const Box2D &valid,
+                   Scratch &s) const {
+    tile(phi, out, valid, s,
+         [this, &ret](const int64_t y, const Box2D &o, const T *p, const T *div, const T *tau_inv) {
+           predict_row(y, o, p, div, tau_inv, ret);
+         });
+  }
+
+  /**
+   * @brief Work-shared evaluation of all tiles with a custom row update
+   *  Must be called from inside an OpenMP parallel region.
+   */
+  template <typename Update>
+  inline void sweep(const Field &phi, Scratch &s, Update &&update) const {
+    const int64_t ny = phi.shape()[0];
+    const int64_t nx = phi.shape()[1];
+    const Box2D domain{0, ny, 0, nx};
+    const int64_t n_ty = (ny + tile_y - 1) / tile_y;
+    const int64_t n_tx = (nx + tile_x - 1) / tile_x;
+#pragma omp for collapse(2) schedule(static)
+    for (int64_t ty = 0; ty < n_ty; ++ty) {
+      for (int64_t tx = 0; tx < n_tx; ++tx) {
+        const Box2D out{ty * tile_y, std::min(ny, (ty + 1) * tile_y), tx * tile_x,
+                        std::min(nx, (tx + 1) * tile_x)};
+        tile(phi, out, domain, s, update);
+      }
+    }
+  }
+
+  /**
+   * @brief Work-shared evaluation of the tiles covering a sub-region
+   *  Must be called from inside an OpenMP parallel region. Tiles are handed out dynamically and
+   *  there is no barrier at the end, so a thread busy with other work (e.g. communication) can
+   *  join late; the caller synchronizes before reading the result.
+   *
+   * @param phi current phase field
+   * @param region cells to be updated, must be inside valid
+   * @param valid cells holding phi, everything outside is zero
+   * @param s scratch of the calling thread
+   * @param update row update
+   */
+  template <typename Update>
+  inline void sweep(const Field &phi, const Box2D &region, const Box2D &valid, Scratch &s,
+                    Update &&update) const {
+    if (region.empty()) {
+      return;
+    }
+    const int64_t n_ty = (region.y1 - region.y0 + tile_y - 1) / tile_y;
+    const int64_t n_tx = (region.x1 - region.x0 + tile_x - 1) / tile_x;
+#pragma omp for collapse(2) schedule(dynamic) nowait
+    for (int64_t ty = 0; ty < n_ty; ++ty) {
+      for (int64_t tx = 0; tx < n_tx; ++tx) {
+        const int64_t y0 = region.y0 + ty * tile_y;
+        const int64_t x0 = region.x0 + tx * tile_x;
+        const Box2D out{y0, std::min(region.y1, y0 + tile_y), x0, std::min(region.x1, x0 + tile_x)};
+        tile(phi, out, valid, s, update);
+      }
+    }
+  }
+
+  /**
+   * @brief Work-shared one step of the tiles covering a sub-region, without a final barrier
+   */
+  inline void sweep(const Field &phi, Field &ret, const Box2D &region, const Box2D &valid,
+                    Scratch &s) const {
+    sweep(phi, region, valid, s,
+          [this, &ret](const int64_t y, const Box2D &o, const T *p, const T *div, const T *tau_inv) {
+            predict_row(y, o, p, div, tau_inv, ret);
+          });
+  }
+
+  /**
+   * @brief Work-shared one step of all tiles
+   *  Must be called from inside an OpenMP parallel region.
+   */
+  inline void sweep(const Field &phi, Field &ret, Scratch &s) const {
+    sweep(phi, s,
+          [this, &ret](const int64_t y, const Box2D &o, const T *p, const T *div, const T *tau_inv) {
+            predict_row(y, o, p, div, tau_inv, ret);
+          });
+  }
+
+  /**
+   * @brief Work-shared step of all tiles by dt, reducing into the statistics of the thread
+   *  Must be called from inside an OpenMP parallel region; stats must be private to the thread.
+   */
+  inline void sweep(const Field &phi, Field &ret, const T dt, Scratch &s, Stats &stats) const {
+    sweep(phi, s,
+          [this, &ret, dt, &stats](const int64_t y, const Box2D &o, const T *p, const T *div,
+                                   const T *tau_inv) {
+            predict_row(y, o, p, div, tau_inv, dt, ret, stats);
+          });
+  }
+};
+
+using FusedPredictKernel = BasicFusedPredictKernel<Field2D::scalar_type>;
+} // namespace phase_field
+
+#endif // __PHASE_FIELD__KERNEL__
@@ -0,0 +1,265 @@
+/*
+ * Copyright (c) 2025 Materials Modelling Lab, The University of Tokyo
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __PHASE_FIELD__KERNEL_3D__
+#define __PHASE_FIELD__KERNEL_3D__
+
+#include "../param.hh"
+#include "functor.hh"
+#include "type.hh"
+#include <algorithm>
+#include <omp.h>
+#include <vector>
+
+namespace phase_field {
+/**
+ * @brief Half open box [z0, z1) x [y0, y1) x [x0, x1) in grid index
+ */
+struct Box3D {
+  int64_t z0, z1, y0, y1, x0, x1;
+
+  inline bool empty() const { return z1 <= z0 || y1 <= y0 || x1 <= x0; }
+};
+
+/**
+ * @brief Single pass 3D phase field step with cubic anisotropy
+ *  a(n) = 1 - 3 epsilon + 4 epsilon (nx^4 + ny^4 + nz^4), 7-point Laplacian and central
+ *  gradients. A (tile_y x tile_x) column is streamed plane by plane along z, keeping four
+ *  planes of phi and three planes of face fluxes, so phi and ret cross memory once per step.
+ *  Work is shared across z-slabs and (y, x) tiles. Cells outside the domain are zero, the same
+ *  as PhaseField2D.
+ */
+class FusedPredictKernel3D {
+public:
+  using T = Field3D::scalar_type;
+  static constexpr int64_t tile_z = 16;
+  static constexpr int64_t tile_y = 16;
+  static constexpr int64_t tile_x = 64;
+
+  /**
+   * @brief Per-thread plane buffers of one column
+   */
+  class Scratch {
+    std::vector<T> buf;
+
+  public:
+    static constexpr int64_t phi_stride = tile_x + 4;
+    static constexpr int64_t phi_plane = (tile_y + 4) * phi_stride;
+    static constexpr int64_t flux_stride = tile_x + 2;
+    static constexpr int64_t flux_plane = (tile_y + 2) * flux_stride;
+
+    /* phi ring:  4 planes of (tile_y + 4) x (tile_x + 4) */
+    /* flux ring: 4 quantities x 3 planes of (tile_y + 2) x (tile_x + 2) */
+    inline void reserve() {
+      if (buf.empty()) {
+        buf.assign(4 * phi_plane + 12 * flux_plane, 0.0);
+      }
+    }
+    inline T *phi(const int64_t slot) { return buf.data() + slot * phi_plane; }
+    inline T *flux(const int64_t q, const int64_t slot) {
+      return buf.data() + 4 * phi_plane + (3 * q + slot) * flux_plane;
+    }
+  };
+
+private:
+  const T W0_sq;
+  const T inv_2dx;
+  const T inv_dx_sq;
+  const AcFunctor<> ac_func;
+  const AkFunctor<> ak_func;
+  const T W0;
+  const T tau0;
+  const T aniso3_c1;
+  ChemPotFunctor<> chem_func;
+  FieldClampFunctor<> clamp_func;
+  PredictFunctor<> predict_func;
+
+  /* Flux quantities stored in the flux ring */
+  enum { fx = 0, fy, fz, tinv };
+
+  static inline int64_t ring(const int64_t i, const int64_t n) { return ((i % n) + n) % n; }
+
+  inline void load_plane(const Field3D &phi, const int64_t z, const Box3D &out,
+                         const Box3D &valid, T *dst) const {
+    const int64_t h = out.y1 - out.y0 + 4;
+    const int64_t w = out.x1 - out.x0 + 4;
+    const bool z_valid = valid.z0 <= z && z < valid.z1;
+    for (int64_t j = 0; j < h; ++j) {
+      T *d = dst + j * Scratch::phi_stride;
+      const int64_t y = out.y0 - 2 + j;
+      if (!z_valid || y < valid.y0 || y >= valid.y1) {
+        std::fill(d, d + w, 0.0);
+        continue;
+      }
+      const auto &row = phi[z][y];
+      for (int64_t i = 0; i < w; ++i) {
+        const int64_t x = out.x0 - 2 + i;
+        d[i] = (x < valid.x0 || x >= valid.x1) ? 0.0 : row[x];
+      }
+    }
+  }
+
+  inline void flux_plane(const int64_t z, const Box3D &out, const Box3D &valid, Scratch &s) const {
+    const int64_t h = out.y1 - out.y0 + 2;
+    const int64_t w = out.x1 - out.x0 + 2;
+    T *f[4];
+    for (int64_t q = 0; q < 4; ++q) {
+      f[q] = s.flux(q, ring(z, 3));
+    }
+    if (z < valid.z0 || z >= valid.z1) {
+      for (int64_t q = 0; q < 4; ++q) {
+        std::fill(f[q], f[q] + Scratch::flux_plane, 0.0);
+      }
+      return;
+    }
+
+    const T *p_b = s.phi(ring(z - 1, 4));
+    const T *p_c = s.phi(ring(z, 4));
+    const T *p_f = s.phi(ring(z + 1, 4));
+    constexpr int64_t ps = Scratch::phi_stride;
+    for (int64_t j = 0; j < h; ++j) {
+      const int64_t y = out.y0 - 1 + j;
+      const bool y_valid = valid.y0 <= y && y < valid.y1;
+      /* phi planes are offset by 2 cells, fluxes by 1 cell from out */
+      const T *c = p_c + (j + 1) * ps + 1;
+      const T *b = p_b + (j + 1) * ps + 1;
+      const T *fw = p_f + (j + 1) * ps + 1;
+      T *r[4];
+      for (int64_t q = 0; q < 4; ++q) {
+        r[q] = f[q] + j * Scratch::flux_stride;
+      }
+      for (int64_t i = 0; i < w; ++i) {
+        const T gx = (c[i + 1] - c[i - 1]) * inv_2dx;
+        const T gy = (c[i + ps] - c[i - ps]) * inv_2dx;
+        const T gz = (fw[i] - b[i]) * inv_2dx;
+        const T x_sq = gx * gx;
+        const T y_sq = gy * gy;
+        const T z_sq = gz * gz;
+        const T abs_sq = x_sq + y_sq + z_sq;
+        const T tmp = abs_sq * abs_sq;
+        const T inv = tmp == 0.0 ? 0.0 : 1.0 / tmp;
+        const T sum4 = x_sq * x_sq + y_sq * y_sq + z_sq * z_sq;
+        const T n4 = sum4 * inv;
+        T ac, ak;
+        ac_func(ac, n4);
+        ak_func(ak, n4);
+        const T W = W0 * ac;
+        const T tau = tau0 * ac * ak;
+        const T w2 = W * W - W0_sq;
+        const T cw = aniso3_c1 * W * inv;
+        const int64_t x = out.x0 - 1 + i;
+        const T mask = (y_valid && valid.x0 <= x && x < valid.x1) ? 1.0 : 0.0;
+        r[tinv][i] = tau == 0.0 ? 0.0 : 1.0 / tau;
+        r[fx][i] = mask * (w2 * gx + cw * gx * (x_sq * abs_sq - sum4));
+        r[fy][i] = mask * (w2 * gy + cw * gy * (y_sq * abs_sq - sum4));
+        r[fz][i] = mask * (w2 * gz + cw * gz * (z_sq * abs_sq - sum4));
+      }
+    }
+  }
+
+  inline void predict_plane(const int64_t z, const Box3D &out, Scratch &s, Field3D &ret) const {
+    const int64_t h = out.y1 - out.y0;
+    const int64_t w = out.x1 - out.x0;
+    constexpr int64_t ps = Scratch::phi_stride;
+    constexpr int64_t fs = Scratch::flux_stride;
+    const T *p_b = s.phi(ring(z - 1, 4));
+    const T *p_c = s.phi(ring(z, 4));
+    const T *p_f = s.phi(ring(z + 1, 4));
+    const T *f_b = s.flux(fz, ring(z - 1, 3));
+    const T *f_f = s.flux(fz, ring(z + 1, 3));
+    const T *f_x = s.flux(fx, ring(z, 3));
+    const T *f_y = s.flux(fy, ring(z, 3));
+    const T *f_t = s.flux(tinv, ring(z, 3));
+
+    auto &&plane = ret[z];
+    for (int64_t j = 0; j < h; ++j) {
+      const T *c = p_c + (j + 2) * ps + 2;
+      const T *b = p_b + (j + 2) * ps + 2;
+      const T *fw = p_f + (j + 2) * ps + 2;
+      const T *gx = f_x + (j + 1) * fs + 1;
+      const T *gy = f_y + (j + 1) * fs + 1;
+      const T *gb = f_b + (j + 1) * fs + 1;
+      const T *gf = f_f + (j + 1) * fs + 1;
+      const T *t = f_t + (j + 1) * fs + 1;
+      auto &&row = plane[out.y0 + j];
+      for (int64_t i = 0; i < w; ++i) {
+        const T lap =
+            (c[i - 1] + c[i + 1] + c[i - ps] + c[i + ps] + b[i] + fw[i] - 6.0 * c[i]) * inv_dx_sq;
+        const T div = ((gx[i + 1] - gx[i - 1]) + (gy[i + fs] - gy[i - fs]) + (gf[i] - gb[i])) *
+                      inv_2dx;
+        T term4;
+        chem_func(term4, c[i]);
+        const T rhs = lap * W0_sq + div + term4;
+
+        T next;
+        predict_func(next, t[i], rhs, c[i]);
+        clamp_func(next);
+        row[out.x0 + i] = next;
+      }
+    }
+  }
+
+public:
+  FusedPredictKernel3D(const Param &p)
+      : W0_sq(p.W0 * p.W0), inv_2dx(1.0 / (2.0 * p.dx)), inv_dx_sq(1.0 / (p.dx * p.dx)),
+        ac_func(p.epsilon_c), ak_func(p.epsilon_k), W0(p.W0), tau0(p.tau0),
+        aniso3_c1(Aniso3Functor(p.W0, p.epsilon_c).c1), chem_func(p.u, p.lambda),
+        predict_func(p.dt) {}
+
+  /**
+   * @brief Advance the cells in the out box by one step
+   *
+   * @param phi current phase field
+   * @param ret next phase field, only the cells in out are written
+   * @param out cells to be updated, at most tile_y x tile_x in y and x
+   * @param valid cells holding phi, everything outside is zero
+   * @param s scratch of the calling thread
+   */
+  inline void tile(const Field3D &phi, Field3D &ret, const Box3D &out, const Box3D &valid,
+                   Scratch &s) const {
+    if (out.empty()) {
+      return;
+    }
+    s.reserve();
+    for (int64_t z = out.z0 - 2; z < out.z0 + 2; ++z) {
+      load_plane(phi, z, out, valid, s.phi(ring(z, 4)));
+    }
+    flux_plane(out.z0 - 1, out, valid, s);
+    flux_plane(out.z0, out, valid, s);
+    for (int64_t z = out.z0; z < out.z1; ++z) {
+      load_plane(phi, z + 2, out, valid, s.phi(ring(z + 2, 4)));
+      flux_plane(z + 1, out, valid, s);
+      predict_plane(z, out, s, ret);
+    }
+  }
+
+  /**
+   * @brief Work-shared one step over z-slabs and (y, x) tiles
+   *  Must be called from inside an OpenMP parallel region.
+   */
+  inline void sweep(const Field3D &phi, Field3D &ret, Scratch &s) const {
+    const int64_t nz = phi.shape()[0];
+    const int64_t ny = phi.shape()[1];
+    const int64_t nx = phi.shape()[2];
+    const Box3D domain{0, nz, 0, ny, 0, nx};
+    const int64_t n_tz = (nz + tile_z - 1) / tile_z;
+    const int64_t n_ty = (ny + tile_y - 1) / tile_y;
+    const int64_t n_tx = (nx + tile_x - 1) / tile_x;
+#pragma omp for collapse(3) schedule(static)
+    for (int64_t tz = 0; tz < n_tz; ++tz) {
+      for (int64_t ty = 0; ty < n_ty; ++ty) {
+        for (int64_t tx = 0; tx < n_tx; ++tx) {
+          const Box3D out{tz * tile_z, std::min(nz, (tz + 1) * tile_z),
+                          ty * tile_y, std::min(ny, (ty + 1) * tile_y),
+                          tx * tile_x, std::min(nx, (tx + 1) * tile_x)};
+          tile(phi, ret, out, domain, s);
+        }
+      }
+    }
+  }
+};
+} // namespace phase_field
+
+#endif // __PHASE_FIELD__KERNEL_3D__
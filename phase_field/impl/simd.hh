@@ -0,0 +1,477 @@
+/*
+ * Copyright (c) 2025 Materials Modelling Lab, The University of Tokyo
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __PHASE_FIELD__SIMD__
+#define __PHASE_FIELD__SIMD__
+
+#include "type.hh"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#if defined(__ARM_FEATURE_SVE)
+#include <arm_sve.h>
+#endif
+#if defined(__linux__)
+#include <sys/auxv.h>
+#endif
+#endif
+
+namespace phase_field::simd {
+using T = Field2D::scalar_type;
+
+/**
+ * @brief Coefficients of the anisotropy functors
+ */
+template <typename U> struct BasicAnisoCoeff {
+  U ac_c1, ac_c2; // AcFunctor
+  U ak_c1, ak_c2; // AkFunctor
+  U W0;           // W = W0 * ac
+  U tau0;         // TauInvFunctor
+  U aniso2_c1;    // Aniso2Functor
+  U aniso3_c1;    // Aniso3Functor
+};
+
+/**
+ * @brief Contiguous rows consumed and produced by the anisotropy row kernel
+ */
+template <typename U> struct BasicAnisoRow {
+  const U *dphi_dx;
+  const U *dphi_dy;
+  U *tau_inv;
+  U *aniso2_dx, *aniso2_dy;
+  U *aniso3_dx, *aniso3_dy;
+};
+
+/**
+ * @brief Evaluate InvAbsN4, N4, Ac, Ak, W, TauInv, Aniso2 and Aniso3 over a row
+ *  All variants apply the operations of the scalar functors in the same order. Compilers may
+ *  still contract a multiply and an add into FMA on targets that have it, so the variants agree
+ *  with the scalar path to rounding (a few ULP), and bitwise with -ffp-contract=off.
+ *  Every vector extension has a double and a float variant.
+ */
+template <typename U>
+using BasicAnisoRowFn = void (*)(const BasicAnisoCoeff<U> &, const BasicAnisoRow<U> &, int64_t,
+                                 int64_t);
+
+using AnisoCoeff = BasicAnisoCoeff<T>;
+using AnisoRow = BasicAnisoRow<T>;
+using AnisoRowFn = BasicAnisoRowFn<T>;
+
+template <typename U>
+inline void aniso_row_scalar(const BasicAnisoCoeff<U> &c, const BasicAnisoRow<U> &r,
+                             const int64_t begin, const int64_t end) {
+  for (int64_t i = begin; i < end; ++i) {
+    const U gx = r.dphi_dx[i];
+    const U gy = r.dphi_dy[i];
+    const U x_sq = gx * gx;
+    const U y_sq = gy * gy;
+    const U abs_sq = x_sq + y_sq;
+    const U tmp = abs_sq * abs_sq;
+    const U inv = tmp == U(0) ? U(0) : U(1) / tmp;
+    const U n4 = (x_sq * x_sq + y_sq * y_sq) * inv;
+    const U ac = c.ac_c1 + c.ac_c2 * n4;
+    const U ak = c.ak_c1 - c.ak_c2 * n4;
+    const U W = c.W0 * ac;
+    const U tau = c.tau0 * ac * ak;
+    r.tau_inv[i] = tau == U(0) ? U(0) : U(1) / tau;
+    const U w2 = W * W - c.aniso2_c1;
+    r.aniso2_dx[i] = w2 * gx;
+    r.aniso2_dy[i] = w2 * gy;
+    const U cw = c.aniso3_c1 * W;
+    r.aniso3_dx[i] = cw * (x_sq * gx * y_sq - gx * (y_sq * y_sq)) * inv;
+    r.aniso3_dy[i] = cw * (y_sq * gy * x_sq - gy * (x_sq * x_sq)) * inv;
+  }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+__attribute__((target("avx2"))) inline void
+aniso_row_avx2(const AnisoCoeff &c, const AnisoRow &r, const int64_t begin, const int64_t end) {
+  const __m256d zero = _mm256_setzero_pd();
+  const __m256d one = _mm256_set1_pd(1.0);
+  const __m256d ac_c1 = _mm256_set1_pd(c.ac_c1), ac_c2 = _mm256_set1_pd(c.ac_c2);
+  const __m256d ak_c1 = _mm256_set1_pd(c.ak_c1), ak_c2 = _mm256_set1_pd(c.ak_c2);
+  const __m256d W0 = _mm256_set1_pd(c.W0), tau0 = _mm256_set1_pd(c.tau0);
+  const __m256d a2 = _mm256_set1_pd(c.aniso2_c1), a3 = _mm256_set1_pd(c.aniso3_c1);
+  int64_t i = begin;
+  for (; i + 4 <= end; i += 4) {
+    const __m256d gx = _mm256_loadu_pd(r.dphi_dx + i);
+    const __m256d gy = _mm256_loadu_pd(r.dphi_dy + i);
+    const __m256d x_sq = _mm256_mul_pd(gx, gx);
+    const __m256d y_sq = _mm256_mul_pd(gy, gy);
+    const __m256d abs_sq = _mm256_add_pd(x_sq, y_sq);
+    const __m256d tmp = _mm256_mul_pd(abs_sq, abs_sq);
+    const __m256d inv = _mm256_blendv_pd(_mm256_div_pd(one, tmp), zero,
+                                         _mm256_cmp_pd(tmp, zero, _CMP_EQ_OQ));
+    const __m256d n4 = _mm256_mul_pd(
+        _mm256_add_pd(_mm256_mul_pd(x_sq, x_sq), _mm256_mul_pd(y_sq, y_sq)), inv);
+    const __m256d ac = _mm256_add_pd(ac_c1, _mm256_mul_pd(ac_c2, n4));
+    const __m256d ak = _mm256_sub_pd(ak_c1, _mm256_mul_pd(ak_c2, n4));
+    const __m256d W = _mm256_mul_pd(W0, ac);
+    const __m256d tau = _mm256_mul_pd(_mm256_mul_pd(tau0, ac), ak);
+    _mm256_storeu_pd(r.tau_inv + i, _mm256_blendv_pd(_mm256_div_pd(one, tau), zero,
+                                                     _mm256_cmp_pd(tau, zero, _CMP_EQ_OQ)));
+    const __m256d w2 = _mm256_sub_pd(_mm256_mul_pd(W, W), a2);
+    _mm256_storeu_pd(r.aniso2_dx + i, _mm256_mul_pd(w2, gx));
+    _mm256_storeu_pd(r.aniso2_dy + i, _mm256_mul_pd(w2, gy));
+    const __m256d cw = _mm256_mul_pd(a3, W);
+    const __m256d t3x = _mm256_sub_pd(_mm256_mul_pd(_mm256_mul_pd(x_sq, gx), y_sq),
+                                      _mm256_mul_pd(gx, _mm256_mul_pd(y_sq, y_sq)));
+    const __m256d t3y = _mm256_sub_pd(_mm256_mul_pd(_mm256_mul_pd(y_sq, gy), x_sq),
+                                      _mm256_mul_pd(gy, _mm256_mul_pd(x_sq, x_sq)));
+    _mm256_storeu_pd(r.aniso3_dx + i, _mm256_mul_pd(_mm256_mul_pd(cw, t3x), inv));
+    _mm256_storeu_pd(r.aniso3_dy + i, _mm256_mul_pd(_mm256_mul_pd(cw, t3y), inv));
+  }
+  aniso_row_scalar(c, r, i, end);
+}
+
+__attribute__((target("avx2"))) inline void
+aniso_row_avx2(const BasicAnisoCoeff<float> &c, const BasicAnisoRow<float> &r, const int64_t begin,
+               const int64_t end) {
+  const __m256 zero = _mm256_setzero_ps();
+  const __m256 one = _mm256_set1_ps(1.0f);
+  const __m256 ac_c1 = _mm256_set1_ps(c.ac_c1), ac_c2 = _mm256_set1_ps(c.ac_c2);
+  const __m256 ak_c1 = _mm256_set1_ps(c.ak_c1), ak_c2 = _mm256_set1_ps(c.ak_c2);
+  const __m256 W0 = _mm256_set1_ps(c.W0), tau0 = _mm256_set1_ps(c.tau0);
+  const __m256 a2 = _mm256_set1_ps(c.aniso2_c1), a3 = _mm256_set1_ps(c.aniso3_c1);
+  int64_t i = begin;
+  for (; i + 8 <= end; i += 8) {
+    const __m256 gx = _mm256_loadu_ps(r.dphi_dx + i);
+    const __m256 gy = _mm256_loadu_ps(r.dphi_dy + i);
+    const __m256 x_sq = _mm256_mul_ps(gx, gx);
+    const __m256 y_sq = _mm256_mul_ps(gy, gy);
+    const __m256 abs_sq = _mm256_add_ps(x_sq, y_sq);
+    const __m256 tmp = _mm256_mul_ps(abs_sq, abs_sq);
+    const __m256 inv = _mm256_blendv_ps(_mm256_div_ps(one, tmp), zero,
+                                        _mm256_cmp_ps(tmp, zero, _CMP_EQ_OQ));
+    const __m256 n4 = _mm256_mul_ps(
+        _mm256_add_ps(_mm256_mul_ps(x_sq, x_sq), _mm256_mul_ps(y_sq, y_sq)), inv);
+    const __m256 ac = _mm256_add_ps(ac_c1, _mm256_mul_ps(ac_c2, n4));
+    const __m256 ak = _mm256_sub_ps(ak_c1, _mm256_mul_ps(ak_c2, n4));
+    const __m256 W = _mm256_mul_ps(W0, ac);
+    const __m256 tau = _mm256_mul_ps(_mm256_mul_ps(tau0, ac), ak);
+    _mm256_storeu_ps(r.tau_inv + i, _mm256_blendv_ps(_mm256_div_ps(one, tau), zero,
+                                                    _mm256_cmp_ps(tau, zero, _CMP_EQ_OQ)));
+    const __m256 w2 = _mm256_sub_ps(_mm256_mul_ps(W, W), a2);
+    _mm256_storeu_ps(r.aniso2_dx + i, _mm256_mul_ps(w2, gx));
+    _mm256_storeu_ps(r.aniso2_dy + i, _mm256_mul_ps(w2, gy));
+    const __m256 cw = _mm256_mul_ps(a3, W);
+    const __m256 t3x = _mm256_sub_ps(_mm256_mul_ps(_mm256_mul_ps(x_sq, gx), y_sq),
+                                     _mm256_mul_ps(gx, _mm256_mul_ps(y_sq, y_sq)));
+    const __m256 t3y = _mm256_sub_ps(_mm256_mul_ps(_mm256_mul_ps(y_sq, gy), x_sq),
+                                     _mm256_mul_ps(gy, _mm256_mul_ps(x_sq, x_sq)));
+    _mm256_storeu_ps(r.aniso3_dx + i, _mm256_mul_ps(_mm256_mul_ps(cw, t3x), inv));
+    _mm256_storeu_ps(r.aniso3_dy + i, _mm256_mul_ps(_mm256_mul_ps(cw, t3y), inv));
+  }
+  aniso_row_scalar(c, r, i, end);
+}
+
+__attribute__((target("avx512f"))) inline void
+aniso_row_avx512(const AnisoCoeff &c, const AnisoRow &r, const int64_t begin, const int64_t end) {
+  const __m512d zero = _mm512_setzero_pd();
+  const __m512d one = _mm512_set1_pd(1.0);
+  const __m512d ac_c1 = _mm512_set1_pd(c.ac_c1), ac_c2 = _mm512_set1_pd(c.ac_c2);
+  const __m512d ak_c1 = _mm512_set1_pd(c.ak_c1), ak_c2 = _mm512_set1_pd(c.ak_c2);
+  const __m512d W0 = _mm512_set1_pd(c.W0), tau0 = _mm512_set1_pd(c.tau0);
+  const __m512d a2 = _mm512_set1_pd(c.aniso2_c1), a3 = _mm512_set1_pd(c.aniso3_c1);
+  int64_t i = begin;
+  for (; i + 8 <= end; i += 8) {
+    const __m512d gx = _mm512_loadu_pd(r.dphi_dx + i);
+    const __m512d gy = _mm512_loadu_pd(r.dphi_dy + i);
+    const __m512d x_sq = _mm512_mul_pd(gx, gx);
+    const __m512d y_sq = _mm512_mul_pd(gy, gy);
+    const __m512d abs_sq = _mm512_add_pd(x_sq, y_sq);
+    const __m512d tmp = _mm512_mul_pd(abs_sq, abs_sq);
+    const __m512d inv = _mm512_mask_blend_pd(_mm512_cmp_pd_mask(tmp, zero, _CMP_EQ_OQ),
+                                             _mm512_div_pd(one, tmp), zero);
+    const __m512d n4 = _mm512_mul_pd(
+        _mm512_add_pd(_mm512_mul_pd(x_sq, x_sq), _mm512_mul_pd(y_sq, y_sq)), inv);
+    const __m512d ac = _mm512_add_pd(ac_c1, _mm512_mul_pd(ac_c2, n4));
+    const __m512d ak = _mm512_sub_pd(ak_c1, _mm512_mul_pd(ak_c2, n4));
+    const __m512d W = _mm512_mul_pd(W0, ac);
+    const __m512d tau = _mm512_mul_pd(_mm512_mul_pd(tau0, ac), ak);
+    _mm512_storeu_pd(r.tau_inv + i,
+                     _mm512_mask_blend_pd(_mm512_cmp_pd_mask(tau, zero, _CMP_EQ_OQ),
+                                          _mm512_div_pd(one, tau), zero));
+    const __m512d w2 = _mm512_sub_pd(_mm512_mul_pd(W, W), a2);
+    _mm512_storeu_pd(r.aniso2_dx + i, _mm512_mul_pd(w2, gx));
+    _mm512_storeu_pd(r.aniso2_dy + i, _mm512_mul_pd(w2, gy));
+    const __m512d cw = _mm512_mul_pd(a3, W);
+    const __m512d t3x = _mm512_sub_pd(_mm512_mul_pd(_mm512_mul_pd(x_sq, gx), y_sq),
+                                      _mm512_mul_pd(gx, _mm512_mul_pd(y_sq, y_sq)));
+    const __m512d t3y = _mm512_sub_pd(_mm512_mul_pd(_mm512_mul_pd(y_sq, gy), x_sq),
+                                      _mm512_mul_pd(gy, _mm512_mul_pd(x_sq, x_sq)));
+    _mm512_storeu_pd(r.aniso3_dx + i, _mm512_mul_pd(_mm512_mul_pd(cw, t3x), inv));
+    _mm512_storeu_pd(r.aniso3_dy + i, _mm512_mul_pd(_mm512_mul_pd(cw, t3y), inv));
+  }
+  aniso_row_scalar(c, r, i, end);
+}
+
+__attribute__((target("avx512f"))) inline void
+aniso_row_avx512(const BasicAnisoCoeff<float> &c, const BasicAnisoRow<float> &r,
+                 const int64_t begin, const int64_t end) {
+  const __m512 zero = _mm512_setzero_ps();
+  const __m512 one = _mm512_set1_ps(1.0f);
+  const __m512 ac_c1 = _mm512_set1_ps(c.ac_c1), ac_c2 = _mm512_set1_ps(c.ac_c2);
+  const __m512 ak_c1 = _mm512_set1_ps(c.ak_c1), ak_c2 = _mm512_set1_ps(c.ak_c2);
+  const __m512 W0 = _mm512_set1_ps(c.W0), tau0 = _mm512_set1_ps(c.tau0);
+  const __m512 a2 = _mm512_set1_ps(c.aniso2_c1), a3 = _mm512_set1_ps(c.aniso3_c1);
+  int64_t i = begin;
+  for (; i + 16 <= end; i += 16) {
+    const __m512 gx = _mm512_loadu_ps(r.dphi_dx + i);
+    const __m512 gy = _mm512_loadu_ps(r.dphi_dy + i);
+    const __m512 x_sq = _mm512_mul_ps(gx, gx);
+    const __m512 y_sq = _mm512_mul_ps(gy, gy);
+    const __m512 abs_sq = _mm512_add_ps(x_sq, y_sq);
+    const __m512 tmp = _mm512_mul_ps(abs_sq, abs_sq);
+    const __m512 inv = _mm512_mask_blend_ps(_mm512_cmp_ps_mask(tmp, zero, _CMP_EQ_OQ),
+                                            _mm512_div_ps(one, tmp), zero);
+    const __m512 n4 = _mm512_mul_ps(
+        _mm512_add_ps(_mm512_mul_ps(x_sq, x_sq), _mm512_mul_ps(y_sq, y_sq)), inv);
+    const __m512 ac = _mm512_add_ps(ac_c1, _mm512_mul_ps(ac_c2, n4));
+    const __m512 ak = _mm512_sub_ps(ak_c1, _mm512_mul_ps(ak_c2, n4));
+    const __m512 W = _mm512_mul_ps(W0, ac);
+    const __m512 tau = _mm512_mul_ps(_mm512_mul_ps(tau0, ac), ak);
+    _mm512_storeu_ps(r.tau_inv + i,
+                     _mm512_mask_blend_ps(_mm512_cmp_ps_mask(tau, zero, _CMP_EQ_OQ),
+                                          _mm512_div_ps(one, tau), zero));
+    const __m512 w2 = _mm512_sub_ps(_mm512_mul_ps(W, W), a2);
+    _mm512_storeu_ps(r.aniso2_dx + i, _mm512_mul_ps(w2, gx));
+    _mm512_storeu_ps(r.aniso2_dy + i, _mm512_mul_ps(w2, gy));
+    const __m512 cw = _mm512_mul_ps(a3, W);
+    const __m512 t3x = _mm512_sub_ps(_mm512_mul_ps(_mm512_mul_ps(x_sq, gx), y_sq),
+                                     _mm512_mul_ps(gx, _mm512_mul_ps(y_sq, y_sq)));
+    const __m512 t3y = _mm512_sub_ps(_mm512_mul_ps(_mm512_mul_ps(y_sq, gy), x_sq),
+                                     _mm512_mul_ps(gy, _mm512_mul_ps(x_sq, x_sq)));
+    _mm512_storeu_ps(r.aniso3_dx + i, _mm512_mul_ps(_mm512_mul_ps(cw, t3x), inv));
+    _mm512_storeu_ps(r.aniso3_dy + i, _mm512_mul_ps(_mm512_mul_ps(cw, t3y), inv));
+  }
+  aniso_row_scalar(c, r, i, end);
+}
+#endif
+
+#if defined(__aarch64__)
+inline void aniso_row_neon(const AnisoCoeff &c, const AnisoRow &r, const int64_t begin,
+                           const int64_t end) {
+  const float64x2_t zero = vdupq_n_f64(0.0);
+  const float64x2_t one = vdupq_n_f64(1.0);
+  const float64x2_t ac_c1 = vdupq_n_f64(c.ac_c1), ac_c2 = vdupq_n_f64(c.ac_c2);
+  const float64x2_t ak_c1 = vdupq_n_f64(c.ak_c1), ak_c2 = vdupq_n_f64(c.ak_c2);
+  const float64x2_t W0 = vdupq_n_f64(c.W0), tau0 = vdupq_n_f64(c.tau0);
+  const float64x2_t a2 = vdupq_n_f64(c.aniso2_c1), a3 = vdupq_n_f64(c.aniso3_c1);
+  int64_t i = begin;
+  for (; i + 2 <= end; i += 2) {
+    const float64x2_t gx = vld1q_f64(r.dphi_dx + i);
+    const float64x2_t gy = vld1q_f64(r.dphi_dy + i);
+    const float64x2_t x_sq = vmulq_f64(gx, gx);
+    const float64x2_t y_sq = vmulq_f64(gy, gy);
+    const float64x2_t abs_sq = vaddq_f64(x_sq, y_sq);
+    const float64x2_t tmp = vmulq_f64(abs_sq, abs_sq);
+    const float64x2_t inv = vbslq_f64(vceqq_f64(tmp, zero), zero, vdivq_f64(one, tmp));
+    const float64x2_t n4 = vmulq_f64(vaddq_f64(vmulq_f64(x_sq, x_sq), vmulq_f64(y_sq, y_sq)), inv);
+    const float64x2_t ac = vaddq_f64(ac_c1, vmulq_f64(ac_c2, n4));
+    const float64x2_t ak = vsubq_f64(ak_c1, vmulq_f64(ak_c2, n4));
+    const float64x2_t W = vmulq_f64(W0, ac);
+    const float64x2_t tau = vmulq_f64(vmulq_f64(tau0, ac), ak);
+    vst1q_f64(r.tau_inv + i, vbslq_f64(vceqq_f64(tau, zero), zero, vdivq_f64(one, tau)));
+    const float64x2_t w2 = vsubq_f64(vmulq_f64(W, W), a2);
+    vst1q_f64(r.aniso2_dx + i, vmulq_f64(w2, gx));
+    vst1q_f64(r.aniso2_dy + i, vmulq_f64(w2, gy));
+    const float64x2_t cw = vmulq_f64(a3, W);
+    const float64x2_t t3x =
+        vsubq_f64(vmulq_f64(vmulq_f64(x_sq, gx), y_sq), vmulq_f64(gx, vmulq_f64(y_sq, y_sq)));
+    const float64x2_t t3y =
+        vsubq_f64(vmulq_f64(vmulq_f64(y_sq, gy), x_sq), vmulq_f64(gy, vmulq_f64(x_sq, x_sq)));
+    vst1q_f64(r.aniso3_dx + i, vmulq_f64(vmulq_f64(cw, t3x), inv));
+    vst1q_f64(r.aniso3_dy + i, vmulq_f64(vmulq_f64(cw, t3y), inv));
+  }
+  aniso_row_scalar(c, r, i, end);
+}
+
+inline void aniso_row_neon(const BasicAnisoCoeff<float> &c, const BasicAnisoRow<float> &r,
+                           const int64_t begin, const int64_t end) {
+  const float32x4_t zero = vdupq_n_f32(0.0f);
+  const float32x4_t one = vdupq_n_f32(1.0f);
+  const float32x4_t ac_c1 = vdupq_n_f32(c.ac_c1), ac_c2 = vdupq_n_f32(c.ac_c2);
+  const float32x4_t ak_c1 = vdupq_n_f32(c.ak_c1), ak_c2 = vdupq_n_f32(c.ak_c2);
+  const float32x4_t W0 = vdupq_n_f32(c.W0), tau0 = vdupq_n_f32(c.tau0);
+  const float32x4_t a2 = vdupq_n_f32(c.aniso2_c1), a3 = vdupq_n_f32(c.aniso3_c1);
+  int64_t i = begin;
+  for (; i + 4 <= end; i += 4) {
+    const float32x4_t gx = vld1q_f32(r.dphi_dx + i);
+    const float32x4_t gy = vld1q_f32(r.dphi_dy + i);
+    const float32x4_t x_sq = vmulq_f32(gx, gx);
+    const float32x4_t y_sq = vmulq_f32(gy, gy);
+    const float32x4_t abs_sq = vaddq_f32(x_sq, y_sq);
+    const float32x4_t tmp = vmulq_f32(abs_sq, abs_sq);
+    const float32x4_t inv = vbslq_f32(vceqq_f32(tmp, zero), zero, vdivq_f32(one, tmp));
+    const float32x4_t n4 = vmulq_f32(vaddq_f32(vmulq_f32(x_sq, x_sq), vmulq_f32(y_sq, y_sq)), inv);
+    const float32x4_t ac = vaddq_f32(ac_c1, vmulq_f32(ac_c2, n4));
+    const float32x4_t ak = vsubq_f32(ak_c1, vmulq_f32(ak_c2, n4));
+    const float32x4_t W = vmulq_f32(W0, ac);
+    const float32x4_t tau = vmulq_f32(vmulq_f32(tau0, ac), ak);
+    vst1q_f32(r.tau_inv + i, vbslq_f32(vceqq_f32(tau, zero), zero, vdivq_f32(one, tau)));
+    const float32x4_t w2 = vsubq_f32(vmulq_f32(W, W), a2);
+    vst1q_f32(r.aniso2_dx + i, vmulq_f32(w2, gx));
+    vst1q_f32(r.aniso2_dy + i, vmulq_f32(w2, gy));
+    const float32x4_t cw = vmulq_f32(a3, W);
+    const float32x4_t t3x =
+        vsubq_f32(vmulq_f32(vmulq_f32(x_sq, gx), y_sq), vmulq_f32(gx, vmulq_f32(y_sq, y_sq)));
+    const float32x4_t t3y =
+        vsubq_f32(vmulq_f32(vmulq_f32(y_sq, gy), x_sq), vmulq_f32(gy, vmulq_f32(x_sq, x_sq)));
+    vst1q_f32(r.aniso3_dx + i, vmulq_f32(vmulq_f32(cw, t3x), inv));
+    vst1q_f32(r.aniso3_dy + i, vmulq_f32(vmulq_f32(cw, t3y), inv));
+  }
+  aniso_row_scalar(c, r, i, end);
+}
+
+#if defined(__ARM_FEATURE_SVE)
+inline void aniso_row_sve(const AnisoCoeff &c, const AnisoRow &r, const int64_t begin,
+                          const int64_t end) {
+  const svbool_t all = svptrue_b64();
+  const svfloat64_t zero = svdup_f64(0.0);
+  const svfloat64_t one = svdup_f64(1.0);
+  for (int64_t i = begin; i < end; i += static_cast<int64_t>(svcntd())) {
+    const svbool_t pg = svwhilelt_b64(i, end);
+    const svfloat64_t gx = svld1_f64(pg, r.dphi_dx + i);
+    const svfloat64_t gy = svld1_f64(pg, r.dphi_dy + i);
+    const svfloat64_t x_sq = svmul_f64_x(all, gx, gx);
+    const svfloat64_t y_sq = svmul_f64_x(all, gy, gy);
+    const svfloat64_t abs_sq = svadd_f64_x(all, x_sq, y_sq);
+    const svfloat64_t tmp = svmul_f64_x(all, abs_sq, abs_sq);
+    const svfloat64_t inv =
+        svsel_f64(svcmpeq_f64(all, tmp, zero), zero, svdiv_f64_x(all, one, tmp));
+    const svfloat64_t n4 = svmul_f64_x(
+        all, svadd_f64_x(all, svmul_f64_x(all, x_sq, x_sq), svmul_f64_x(all, y_sq, y_sq)), inv);
+    const svfloat64_t ac = svadd_f64_x(all, svdup_f64(c.ac_c1), svmul_n_f64_x(all, n4, c.ac_c2));
+    const svfloat64_t ak = svsub_f64_x(all, svdup_f64(c.ak_c1), svmul_n_f64_x(all, n4, c.ak_c2));
+    const svfloat64_t W = svmul_f64_x(all, svdup_f64(c.W0), ac);
+    const svfloat64_t tau = svmul_f64_x(all, svmul_f64_x(all, svdup_f64(c.tau0), ac), ak);
+    svst1_f64(pg, r.tau_inv + i,
+              svsel_f64(svcmpeq_f64(all, tau, zero), zero, svdiv_f64_x(all, one, tau)));
+    const svfloat64_t w2 = svsub_n_f64_x(all, svmul_f64_x(all, W, W), c.aniso2_c1);
+    svst1_f64(pg, r.aniso2_dx + i, svmul_f64_x(all, w2, gx));
+    svst1_f64(pg, r.aniso2_dy + i, svmul_f64_x(all, w2, gy));
+    const svfloat64_t cw = svmul_f64_x(all, svdup_f64(c.aniso3_c1), W);
+    const svfloat64_t t3x = svsub_f64_x(all, svmul_f64_x(all, svmul_f64_x(all, x_sq, gx), y_sq),
+                                        svmul_f64_x(all, gx, svmul_f64_x(all, y_sq, y_sq)));
+    const svfloat64_t t3y = svsub_f64_x(all, svmul_f64_x(all, svmul_f64_x(all, y_sq, gy), x_sq),
+                                        svmul_f64_x(all, gy, svmul_f64_x(all, x_sq, x_sq)));
+    svst1_f64(pg, r.aniso3_dx + i, svmul_f64_x(all, svmul_f64_x(all, cw, t3x), inv));
+    svst1_f64(pg, r.aniso3_dy + i, svmul_f64_x(all, svmul_f64_x(all, cw, t3y), inv));
+  }
+}
+
+inline void aniso_row_sve(const BasicAnisoCoeff<float> &c, const BasicAnisoRow<float> &r,
+                          const int64_t begin, const int64_t end) {
+  const svbool_t all = svptrue_b32();
+  const svfloat32_t zero = svdup_f32(0.0f);
+  const svfloat32_t one = svdup_f32(1.0f);
+  for (int64_t i = begin; i < end; i += static_cast<int64_t>(svcntw())) {
+    const svbool_t pg = svwhilelt_b32(i, end);
+    const svfloat32_t gx = svld1_f32(pg, r.dphi_dx + i);
+    const svfloat32_t gy = svld1_f32(pg, r.dphi_dy + i);
+    const svfloat32_t x_sq = svmul_f32_x(all, gx, gx);
+    const svfloat32_t y_sq = svmul_f32_x(all, gy, gy);
+    const svfloat32_t abs_sq = svadd_f32_x(all, x_sq, y_sq);
+    const svfloat32_t tmp = svmul_f32_x(all, abs_sq, abs_sq);
+    const svfloat32_t inv =
+        svsel_f32(svcmpeq_f32(all, tmp, zero), zero, svdiv_f32_x(all, one, tmp));
+    const svfloat32_t n4 = svmul_f32_x(
+        all, svadd_f32_x(all, svmul_f32_x(all, x_sq, x_sq), svmul_f32_x(all, y_sq, y_sq)), inv);
+    const svfloat32_t ac = svadd_f32_x(all, svdup_f32(c.ac_c1), svmul_n_f32_x(all, n4, c.ac_c2));
+    const svfloat32_t ak = svsub_f32_x(all, svdup_f32(c.ak_c1), svmul_n_f32_x(all, n4, c.ak_c2));
+    const svfloat32_t W = svmul_f32_x(all, svdup_f32(c.W0), ac);
+    const svfloat32_t tau = svmul_f32_x(all, svmul_f32_x(all, svdup_f32(c.tau0), ac), ak);
+    svst1_f32(pg, r.tau_inv + i,
+              svsel_f32(svcmpeq_f32(all, tau, zero), zero, svdiv_f32_x(all, one, tau)));
+    const svfloat32_t w2 = svsub_n_f32_x(all, svmul_f32_x(all, W, W), c.aniso2_c1);
+    svst1_f32(pg, r.aniso2_dx + i, svmul_f32_x(all, w2, gx));
+    svst1_f32(pg, r.aniso2_dy + i, svmul_f32_x(all, w2, gy));
+    const svfloat32_t cw = svmul_f32_x(all, svdup_f32(c.aniso3_c1), W);
+    const svfloat32_t t3x = svsub_f32_x(all, svmul_f32_x(all, svmul_f32_x(all, x_sq, gx), y_sq),
+                                        svmul_f32_x(all, gx, svmul_f32_x(all, y_sq, y_sq)));
+    const svfloat32_t t3y = svsub_f32_x(all, svmul_f32_x(all, svmul_f32_x(all, y_sq, gy), x_sq),
+                                        svmul_f32_x(all, gy, svmul_f32_x(all, x_sq, x_sq)));
+    svst1_f32(pg, r.aniso3_dx + i, svmul_f32_x(all, svmul_f32_x(all, cw, t3x), inv));
+    svst1_f32(pg, r.aniso3_dy + i, svmul_f32_x(all, svmul_f32_x(all, cw, t3y), inv));
+  }
+}
+#endif
+#endif
+
+/**
+ * @brief Widest vector extension usable by the running CPU
+ */
+enum class Isa {
+  scalar = 0,
+  avx2,
+  avx512,
+  neon,
+  sve,
+};
+
+inline Isa detect_isa() {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) {
+    return Isa::avx512;
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    return Isa::avx2;
+  }
+#elif defined(__aarch64__)
+#if defined(__ARM_FEATURE_SVE) && defined(__linux__) && defined(HWCAP_SVE)
+  if (getauxval(AT_HWCAP) & HWCAP_SVE) {
+    return Isa::sve;
+  }
+#endif
+  return Isa::neon;
+#endif
+  return Isa::scalar;
+}
+
+/**
+ * @brief Extension detected once per process
+ */
+inline Isa isa() {
+  static const Isa ret = detect_isa();
+  return ret;
+}
+
+/**
+ * @brief Pick the widest row kernel supported by the running CPU
+ */
+template <typename U = T> inline BasicAnisoRowFn<U> select_aniso_row() {
+  switch (isa()) {
+#if defined(__x86_64__) || defined(__i386__)
+  case Isa::avx512:
+    return aniso_row_avx512;
+  case Isa::avx2:
+    return aniso_row_avx2;
+#elif defined(__aarch64__)
+#if defined(__ARM_FEATURE_SVE)
+  case Isa::sve:
+    return aniso_row_sve;
+#endif
+  case Isa::neon:
+    return aniso_row_neon;
+#endif
+  default:
+    return aniso_row_scalar<U>;
+  }
+}
+
+/**
+ * @brief Row kernel selected once per process
+ */
+template <typename U = T> inline BasicAnisoRowFn<U> aniso_row() {
+  static const BasicAnisoRowFn<U> fn = select_aniso_row<U>();
+  return fn;
+}
+} // namespace phase_field::simd
+
+#endif // __PHASE_FIELD__SIMD__
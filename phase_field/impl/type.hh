@@ -9,10 +9,13 @@
 #include <libtensor/libtensor.hh>
 
 namespace phase_field {
-using Field2D = libtensor::Tensor<double, 2>;
+template <typename T> using BasicField2D = libtensor::Tensor<T, 2>;
+template <typename T> using BasicFilter2D = libtensor::Tensor<T, 2>;
+
+using Field2D = BasicField2D<double>;
 using Field3D = libtensor::Tensor<double, 3>;
 
-using Filter2D = libtensor::Tensor<double, 2>;
+using Filter2D = BasicFilter2D<double>;
 using Filter3D = libtensor::Tensor<double, 3>;
 } // namespace phase_field
 
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2025 Materials Modelling Lab, The University of Tokyo
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __PHASE_FIELD__WORKSPACE__
+#define __PHASE_FIELD__WORKSPACE__
+
+#include "../util.hh"
+#include "kernel.hh"
+#include "type.hh"
+#include <omp.h>
+#include <type_traits>
+#include <vector>
+
+namespace phase_field {
+/**
+ * @brief Scratch memory of PhaseField2D::predict
+ *  Buffers are allocated on the first call for a given shape and reused afterwards, so a step
+ *  never allocates. A workspace must not be shared by solvers running at the same time; give
+ *  each thread (or each solver) its own. S and A are the storage and compute types of the
+ *  solver, see BasicFusedPredictKernel.
+ */
+template <typename S, typename A = S> class BasicPredictWorkspace {
+  using Kernel = BasicFusedPredictKernel<S, A>;
+  using Field = BasicField2D<A>;
+
+  std::size_t ny = 0;
+  std::size_t nx = 0;
+  std::vector<typename Kernel::Scratch> scratch;
+
+public:
+  /* Temporaries of the term by term reference path, in the compute type */
+  Field phi;
+  Field dphi_dx, dphi_dy;
+  Field abs_n4_inv, n4, ac, ak, W, tau_inv;
+  Field term1, term2_dx, term2_dy, term3_dx, term3_dy, term4;
+  Field cache;
+
+  BasicPredictWorkspace() = default;
+
+  /**
+   * @brief Prepare the per-thread scratch of the fused kernel
+   *  Must be called outside of the parallel region.
+   *
+   * @param phi field to be predicted, a BasicField2D<S> or any type with its shape()
+   */
+  template <typename F> inline void reserve(const F &phi) {
+    const auto n_threads = static_cast<std::size_t>(omp_get_max_threads());
+    if (scratch.size() < n_threads) {
+      scratch.resize(n_threads);
+    }
+    const auto width = std::min<int64_t>(phi.shape()[1], Kernel::tile_x);
+    for (auto &s : scratch) {
+      s.reserve(width);
+    }
+  }
+
+  /**
+   * @brief Prepare the full size temporaries of the reference path
+   *  The copy of phi in the compute type is only allocated when it differs from the storage type.
+   *
+   * @param field field to be predicted
+   */
+  inline void reserve_reference(const BasicField2D<S> &field) {
+    if (ny == field.shape()[0] && nx == field.shape()[1]) {
+      return;
+    }
+    ny = field.shape()[0];
+    nx = field.shape()[1];
+    for (auto *f : {&dphi_dx, &dphi_dy, &abs_n4_inv, &n4, &ac, &ak, &W, &tau_inv, &term1,
+                    &term2_dx, &term2_dy, &term3_dx, &term3_dy, &term4, &cache}) {
+      *f = Field({ny, nx});
+    }
+    if constexpr (!std::is_same_v<S, A>) {
+      phi = Field({ny, nx});
+    }
+  }
+
+  /**
+   * @brief phi in the compute type: field itself, or its copy when the types differ
+   *  reserve_reference must have been called for the shape of field.
+   */
+  inline const Field &promote(const BasicField2D<S> &field) {
+    if constexpr (std::is_same_v<S, A>) {
+      return field;
+    } else {
+      convert(field, phi);
+      return phi;
+    }
+  }
+
+  /**
+   * @brief Scratch of the calling OpenMP thread
+   */
+  inline typename Kernel::Scratch &thread_scratch() {
+    return scratch[static_cast<std::size_t>(omp_get_thread_num())];
+  }
+};
+
+using PredictWorkspace = BasicPredictWorkspace<Field2D::scalar_type>;
+} // namespace phase_field
+
+#endif // __PHASE_FIELD__WORKSPACE__
@@ -9,11 +9,24 @@
 #include "impl/color.hh"
 #include "impl/state.hh"
 #include "impl/type.hh"
+#include "param.hh"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
 #include <filesystem>
 #include <fstream>
 #include <iomanip>
+#include <nlohmann/json.hpp>
 #include <omp.h>
 #include <sstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+#include <vector>
 
 namespace phase_field::io {
 /**
@@ -133,21 +146,39 @@ inline void write(const std::filesystem::path &filename, const Field2D &field,
   fmt_raw(fo, field) << std::endl;
 }
 
-inline void read(const std::filesystem::path &filename, Field2D &field) {
-  const auto get_data = [](std::istream &is) {
-    std::vector<std::vector<Field2D::scalar_type>> ret;
-    std::string l1;
-    while (std::getline(is, l1)) {
-      std::string l2;
-      std::stringstream ss{l1};
-      ret.emplace_back(std::vector<Field2D::scalar_type>{});
-      while (std::getline(ss, l2, ' ')) {
-        ret.back().emplace_back(std::stod(l2));
-      }
-    }
-    return ret;
-  };
+/**
+ * @brief Parse one number of the legacy text format
+ *  std::from_chars where the standard library implements it for floating point, strtod
+ *  otherwise (the C locale is assumed, as the files are written with it).
+ *
+ * @return const char* end of the number, or nullptr if none was found
+ */
+inline const char *parse_number(const char *first, const char *last,
+                                Field2D::scalar_type &value) {
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+  const auto [ptr, ec] = std::from_chars(first, last, value);
+  return ec == std::errc{} ? ptr : nullptr;
+#else
+  // strtod needs a terminated string, and the mapped file is not
+  char buf[64];
+  const std::size_t n = std::min<std::size_t>(last - first, sizeof(buf) - 1);
+  std::memcpy(buf, first, n);
+  buf[n] = '\0';
+  char *end = nullptr;
+  value = std::strtod(buf, &end);
+  return end == buf ? nullptr : first + (end - buf);
+#endif
+}
 
+/**
+ * @brief Read a field from the legacy text format: rows of space separated numbers
+ *  The file is mapped and split into rows at the newlines, then the rows are parsed in parallel
+ *  straight into the field. Every row must hold the same number of values.
+ *
+ * @param filename input path
+ * @param field phase field in 2D tensor, resized to the file
+ */
+inline void read(const std::filesystem::path &filename, Field2D &field) {
   if (!std::filesystem::exists(filename)) {
     throw std::runtime_error("file '" + filename.string() + "' not exist");
   }
@@ -156,22 +187,390 @@ inline void read(const std::filesystem::path &filename, Field2D &field) {
     throw std::runtime_error("file '" + filename.string() + "' is not regular file");
   }
 
-  std::ifstream fi{filename};
-  if (!fi) {
+  const int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
     throw std::runtime_error("could not open '" + filename.string() + "'");
   }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size == 0) {
+    ::close(fd);
+    throw std::runtime_error("file '" + filename.string() + "' is empty");
+  }
+  const std::size_t length = st.st_size;
+  void *addr = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (addr == MAP_FAILED) {
+    throw std::runtime_error("could not map '" + filename.string() + "'");
+  }
+  const char *const begin = static_cast<const char *>(addr);
+  const char *const end = begin + length;
 
-  const auto data = get_data(fi);
-  const std::size_t y_size = data.size();
-  const std::size_t x_size = data.front().size();
+  /* Row boundaries; blank lines, such as the one after the last row, are skipped */
+  std::vector<std::pair<const char *, const char *>> rows;
+  for (const char *p = begin; p < end;) {
+    const char *nl = static_cast<const char *>(std::memchr(p, '\n', end - p));
+    const char *eol = nl ? nl : end;
+    if (std::find_if_not(p, eol, [](const unsigned char c) { return std::isspace(c); }) != eol) {
+      rows.emplace_back(p, eol);
+    }
+    p = eol + 1;
+  }
+
+  const auto is_space = [](const char c) { return c == ' ' || c == '\t' || c == '\r'; };
+  const auto count = [&is_space](const char *p, const char *last) {
+    std::size_t n = 0;
+    while (p < last) {
+      while (p < last && is_space(*p)) {
+        ++p;
+      }
+      if (p == last) {
+        break;
+      }
+      ++n;
+      while (p < last && !is_space(*p)) {
+        ++p;
+      }
+    }
+    return n;
+  };
+  const std::size_t y_size = rows.size();
+  const std::size_t x_size = y_size ? count(rows.front().first, rows.front().second) : 0;
+  if (y_size == 0 || x_size == 0) {
+    munmap(addr, length);
+    throw std::runtime_error("file '" + filename.string() + "' holds no values");
+  }
   field.resize({y_size, x_size});
-#pragma omp parallel for
+
+  /* The first malformed row, if any, reported once the parallel loop is over */
+  int64_t bad_row = -1;
+#pragma omp parallel for schedule(static)
   for (std::size_t y = 0; y < y_size; ++y) {
+    const char *p = rows[y].first;
+    const char *const last = rows[y].second;
+    auto &&dst = field[y];
+    std::size_t x = 0;
+    bool ok = true;
+    while (ok) {
+      while (p < last && is_space(*p)) {
+        ++p;
+      }
+      if (p == last) {
+        break;
+      }
+      Field2D::scalar_type value;
+      const char *next = x < x_size ? parse_number(p, last, value) : nullptr;
+      ok = next && (next == last || is_space(*next));
+      if (ok) {
+        dst[x++] = value;
+        p = next;
+      }
+    }
+    if (!ok || x != x_size) {
+#pragma omp critical(phase_field_io_read)
+      if (bad_row < 0 || static_cast<int64_t>(y) < bad_row) {
+        bad_row = y;
+      }
+    }
+  }
+  munmap(addr, length);
+  if (bad_row >= 0) {
+    throw std::runtime_error("file '" + filename.string() + "' row " +
+                             std::to_string(bad_row + 1) + ": expected " +
+                             std::to_string(x_size) + " numbers");
+  }
+}
+
+/**
+ * @brief Binary snapshot layout (native byte order)
+ *  [SnapshotHeader][meta JSON (meta_size bytes)][padding][data (row-major)]
+ *  The data section starts at data_offset, aligned to snapshot_alignment bytes.
+ */
+inline constexpr char snapshot_magic[8] = {'P', 'F', 'S', 'N', 'A', 'P', '\0', '\0'};
+inline constexpr uint32_t snapshot_version = 1;
+inline constexpr uint64_t snapshot_alignment = 64;
+
+enum class DType : uint32_t {
+  float64 = 1,
+  float32 = 2,
+};
+
+struct SnapshotHeader {
+  char magic[8];
+  uint32_t version;
+  DType dtype;
+  uint32_t rank;
+  uint32_t reserved;
+  uint64_t shape[3];
+  uint64_t step;
+  double time;
+  uint64_t meta_size;
+  uint64_t data_offset;
+};
+static_assert(sizeof(SnapshotHeader) == 80, "unexpected padding in SnapshotHeader");
+
+/**
+ * @brief Metadata stored alongside the field in a snapshot
+ */
+struct SnapshotInfo {
+  uint64_t step = 0;
+  double time = 0.0;
+  nlohmann::json meta = nlohmann::json::object();
+
+  SnapshotInfo() = default;
+  SnapshotInfo(const uint64_t s, const double t) : step(s), time(t) {}
+  SnapshotInfo(const uint64_t s, const double t, const Param &p) : step(s), time(t) {
+    meta["param"] = p;
+  }
+
+  /**
+   * @brief Restore the Param stored in the snapshot
+   */
+  inline Param param() const {
+    if (!meta.contains("param")) {
+      throw std::runtime_error("snapshot does not hold Param");
+    }
+    Param p = meta.at("param").get<Param>();
+    p.setup();
+    return p;
+  }
+};
+
+/**
+ * @brief Header of a float64 snapshot with the given shape
+ *
+ * @param shape extent of each axis, the last one being contiguous
+ * @param info step, time and metadata
+ * @param meta serialized info.meta, written right after the header
+ */
+inline SnapshotHeader make_snapshot_header(const std::vector<uint64_t> &shape,
+                                           const SnapshotInfo &info, const std::string &meta) {
+  if (shape.size() < 2 || shape.size() > 3) {
+    throw std::invalid_argument("only 2D and 3D fields are supported");
+  }
+  SnapshotHeader header{};
+  std::memcpy(header.magic, snapshot_magic, sizeof(header.magic));
+  header.version = snapshot_version;
+  header.dtype = DType::float64;
+  header.rank = shape.size();
+  for (std::size_t i = 0; i < shape.size(); ++i) {
+    header.shape[i] = shape[i];
+  }
+  header.step = info.step;
+  header.time = info.time;
+  header.meta_size = meta.size();
+  const uint64_t end = sizeof(SnapshotHeader) + meta.size();
+  header.data_offset = (end + snapshot_alignment - 1) / snapshot_alignment * snapshot_alignment;
+  return header;
+}
+
+/**
+ * @brief Write a field to the binary snapshot format
+ *
+ * @param filename output path
+ * @param field phase field in 2D or 3D tensor
+ * @param info step, time and metadata
+ * @param force overwrite the existing file
+ */
+template <std::size_t N>
+inline void write_snapshot(const std::filesystem::path &filename,
+                           const libtensor::Tensor<double, N> &field, const SnapshotInfo &info,
+                           const bool force = false) {
+  static_assert(N == 2 || N == 3, "only 2D and 3D fields are supported");
+  if (std::filesystem::exists(filename) && !force) {
+    throw std::runtime_error("file '" + filename.string() + "' already exist");
+  }
+
+  std::ofstream fo{filename, std::ios::binary};
+  if (!fo) {
+    throw std::runtime_error("could not open '" + filename.string() + "'");
+  }
+
+  const std::string meta = info.meta.dump();
+  const auto &f_shape = field.shape();
+  const auto header =
+      make_snapshot_header(std::vector<uint64_t>(f_shape.begin(), f_shape.end()), info, meta);
+  const uint64_t end = sizeof(SnapshotHeader) + meta.size();
+
+  fo.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  fo.write(meta.data(), meta.size());
+  const std::vector<char> padding(header.data_offset - end, '\0');
+  fo.write(padding.data(), padding.size());
+
+  std::vector<double> row(f_shape[N - 1]);
+  const auto write_row = [&fo, &row](const auto &src) {
+    for (std::size_t x = 0; x < row.size(); ++x) {
+      row[x] = src[x];
+    }
+    fo.write(reinterpret_cast<const char *>(row.data()), row.size() * sizeof(double));
+  };
+  if constexpr (N == 2) {
+    for (std::size_t y = 0; y < f_shape[0]; ++y) {
+      write_row(field[y]);
+    }
+  } else {
+    for (std::size_t z = 0; z < f_shape[0]; ++z) {
+      const auto &plane = field[z];
+      for (std::size_t y = 0; y < f_shape[1]; ++y) {
+        write_row(plane[y]);
+      }
+    }
+  }
+  if (!fo) {
+    throw std::runtime_error("failed to write '" + filename.string() + "'");
+  }
+}
+
+/**
+ * @brief Read-only memory mapped snapshot
+ *  The data section is accessed in place without copying.
+ */
+class MappedSnapshot {
+  const char *addr = nullptr;
+  std::size_t length = 0;
+  const SnapshotHeader *header_ = nullptr;
+
+  inline void release() {
+    if (addr) {
+      munmap(const_cast<char *>(addr), length);
+    }
+    addr = nullptr;
+    header_ = nullptr;
+    length = 0;
+  }
+
+public:
+  MappedSnapshot() = default;
+  explicit MappedSnapshot(const std::filesystem::path &filename) { open(filename); }
+  MappedSnapshot(const MappedSnapshot &) = delete;
+  MappedSnapshot &operator=(const MappedSnapshot &) = delete;
+  MappedSnapshot(MappedSnapshot &&o) noexcept
+      : addr(std::exchange(o.addr, nullptr)), length(std::exchange(o.length, 0)),
+        header_(std::exchange(o.header_, nullptr)) {}
+  MappedSnapshot &operator=(MappedSnapshot &&o) noexcept {
+    if (this != &o) {
+      release();
+      addr = std::exchange(o.addr, nullptr);
+      length = std::exchange(o.length, 0);
+      header_ = std::exchange(o.header_, nullptr);
+    }
+    return *this;
+  }
+  ~MappedSnapshot() { release(); }
+
+  inline void open(const std::filesystem::path &filename) {
+    release();
+    const int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+      throw std::runtime_error("could not open '" + filename.string() + "'");
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(SnapshotHeader)) {
+      ::close(fd);
+      throw std::runtime_error("file '" + filename.string() + "' is not a snapshot");
+    }
+    void *p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) {
+      throw std::runtime_error("could not map '" + filename.string() + "'");
+    }
+    addr = static_cast<const char *>(p);
+    length = st.st_size;
+    header_ = reinterpret_cast<const SnapshotHeader *>(addr);
+
+    const auto &h = *header_;
+    if (std::memcmp(h.magic, snapshot_magic, sizeof(h.magic)) != 0) {
+      release();
+      throw std::runtime_error("file '" + filename.string() + "' is not a snapshot");
+    }
+    if (h.version != snapshot_version || h.dtype != DType::float64 || h.rank < 2 ||
+        h.rank > 3) {
+      release();
+      throw std::runtime_error("unsupported snapshot '" + filename.string() + "'");
+    }
+    /* Bounded by the length before every product and sum, so a corrupt header cannot wrap */
+    bool fits = h.meta_size <= length - sizeof(SnapshotHeader) &&
+                h.data_offset >= sizeof(SnapshotHeader) + h.meta_size && h.data_offset <= length;
+    const std::size_t max_count = length / sizeof(double);
+    std::size_t count = 1;
+    for (std::size_t i = 0; fits && i < h.rank; ++i) {
+      fits = h.shape[i] == 0 || count <= max_count / h.shape[i];
+      count *= fits ? h.shape[i] : 1;
+    }
+    if (!fits || count > (length - h.data_offset) / sizeof(double)) {
+      release();
+      throw std::runtime_error("snapshot '" + filename.string() + "' is truncated");
+    }
+    if (h.data_offset % alignof(double) != 0) {
+      release();
+      throw std::runtime_error("snapshot '" + filename.string() + "' has misaligned data");
+    }
+  }
+
+  inline const SnapshotHeader &header() const { return *header_; }
+  inline std::size_t rank() const { return header_->rank; }
+  inline std::size_t shape(const std::size_t i) const { return header_->shape[i]; }
+
+  inline SnapshotInfo info() const {
+    SnapshotInfo ret(header_->step, header_->time);
+    ret.meta = nlohmann::json::parse(addr + sizeof(SnapshotHeader),
+                                     addr + sizeof(SnapshotHeader) + header_->meta_size);
+    return ret;
+  }
+
+  /**
+   * @brief Row-major data in the mapped file
+   */
+  inline const double *data() const {
+    return reinterpret_cast<const double *>(addr + header_->data_offset);
+  }
+  inline const double *row(const std::size_t y) const { return data() + y * shape(rank() - 1); }
+};
+
+/**
+ * @brief Check the magic of the file without mapping it
+ */
+inline bool is_snapshot(const std::filesystem::path &filename) {
+  std::ifstream fi{filename, std::ios::binary};
+  char magic[sizeof(snapshot_magic)] = {};
+  fi.read(magic, sizeof(magic));
+  return fi && std::memcmp(magic, snapshot_magic, sizeof(magic)) == 0;
+}
+
+/**
+ * @brief Read a 2D snapshot into a field
+ *
+ * @param filename input path
+ * @param field phase field in 2D tensor
+ * @return SnapshotInfo step, time and metadata of the snapshot
+ */
+inline SnapshotInfo read_snapshot(const std::filesystem::path &filename, Field2D &field) {
+  const MappedSnapshot snap(filename);
+  if (snap.rank() != 2) {
+    throw std::runtime_error("snapshot '" + filename.string() + "' is not 2D");
+  }
+  const std::size_t y_size = snap.shape(0);
+  const std::size_t x_size = snap.shape(1);
+  field.resize({y_size, x_size});
 #pragma omp parallel for
+  for (std::size_t y = 0; y < y_size; ++y) {
+    const double *src = snap.row(y);
+    auto &&dst = field[y];
     for (std::size_t x = 0; x < x_size; ++x) {
-      field[y][x] = data[y][x];
+      dst[x] = src[x];
     }
   }
+  return snap.info();
+}
+
+/**
+ * @brief Read a field either from a snapshot or from the legacy text format
+ */
+inline void load(const std::filesystem::path &filename, Field2D &field) {
+  if (is_snapshot(filename)) {
+    read_snapshot(filename, field);
+  } else {
+    read(filename, field);
+  }
 }
 } // namespace phase_field::io
 
@@ -0,0 +1,526 @@
+/*
+ * Copyright (c) 2025 Materials Modelling Lab, The University of Tokyo
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __PHASE_FIELD__MPI__
+#define __PHASE_FIELD__MPI__
+
+#include "impl/kernel.hh"
+#include "impl/type.hh"
+#include "impl/workspace.hh"
+#include "io.hh"
+#include "param.hh"
+#include <array>
+#include <mpi.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace phase_field::mpi {
+/**
+ * @brief Width of the halo around each block
+ *  A step reads phi two cells away: the face fluxes at x +- 1 use the central gradient at
+ *  x +- 1, which needs phi at x +- 2. A one cell halo is therefore not enough.
+ */
+inline constexpr int64_t halo = 2;
+
+inline void check(const int err, const char *what) {
+  if (err != MPI_SUCCESS) {
+    char msg[MPI_MAX_ERROR_STRING];
+    int len = 0;
+    MPI_Error_string(err, msg, &len);
+    throw std::runtime_error(std::string(what) + ": " + std::string(msg, len));
+  }
+}
+
+/**
+ * @brief 2D block decomposition of a global field over a Cartesian communicator
+ *  Rank (py, px) owns the global rows [y0, y1) and columns [x0, x1). The local field has the
+ *  shape (ny + 2 halo) x (nx + 2 halo) and the owned cells are the interior box. The domain is
+ *  not periodic: halos on the boundary of the global domain stay outside the valid box and are
+ *  read as zero, the same as PhaseField2D.
+ */
+class BlockDecomposition2D {
+  MPI_Comm cart = MPI_COMM_NULL;
+  int rank_ = 0;
+  int size_ = 1;
+  std::array<int, 2> dims = {0, 0};
+  std::array<int, 2> coords = {0, 0};
+  int64_t global_ny, global_nx;
+  Box2D owned_;
+  std::array<std::array<int, 3>, 3> neighbours;
+
+  static inline int64_t split(const int64_t n, const int parts, const int i) {
+    return i * (n / parts) + std::min<int64_t>(i, n % parts);
+  }
+
+  inline Box2D box_of(const std::array<int, 2> &c) const {
+    return {split(global_ny, dims[0], c[0]), split(global_ny, dims[0], c[0] + 1),
+            split(global_nx, dims[1], c[1]), split(global_nx, dims[1], c[1] + 1)};
+  }
+
+  inline Box2D box_of_rank(const int r) const {
+    std::array<int, 2> c;
+    check(MPI_Cart_coords(cart, r, 2, c.data()), "MPI_Cart_coords");
+    return box_of(c);
+  }
+
+public:
+  /**
+   * @brief Split a global grid over all ranks of comm
+   *
+   * @param comm communicator, duplicated into a Cartesian one
+   * @param ny global number of rows
+   * @param nx global number of columns
+   * @param process_grid ranks along y and x, 0 lets MPI choose
+   */
+  BlockDecomposition2D(MPI_Comm comm, const int64_t ny, const int64_t nx,
+                       std::array<int, 2> process_grid = {0, 0})
+      : dims(process_grid), global_ny(ny), global_nx(nx) {
+    check(MPI_Comm_size(comm, &size_), "MPI_Comm_size");
+    check(MPI_Dims_create(size_, 2, dims.data()), "MPI_Dims_create");
+    const std::array<int, 2> periods = {0, 0};
+    check(MPI_Cart_create(comm, 2, dims.data(), periods.data(), 0, &cart), "MPI_Cart_create");
+    check(MPI_Comm_rank(cart, &rank_), "MPI_Comm_rank");
+    check(MPI_Cart_coords(cart, rank_, 2, coords.data()), "MPI_Cart_coords");
+
+    /* The inner cells and the edge strips of predict must not overlap */
+    if (ny / dims[0] < 2 * halo || nx / dims[1] < 2 * halo) {
+      MPI_Comm_free(&cart);
+      throw std::invalid_argument("blocks must be at least " + std::to_string(2 * halo) +
+                                  " cells wide");
+    }
+    owned_ = box_of(coords);
+    for (int dy = -1; dy <= 1; ++dy) {
+      for (int dx = -1; dx <= 1; ++dx) {
+        const std::array<int, 2> c = {coords[0] + dy, coords[1] + dx};
+        int &n = neighbours[dy + 1][dx + 1];
+        n = MPI_PROC_NULL;
+        if (0 <= c[0] && c[0] < dims[0] && 0 <= c[1] && c[1] < dims[1] && (dy || dx)) {
+          check(MPI_Cart_rank(cart, c.data(), &n), "MPI_Cart_rank");
+        }
+      }
+    }
+  }
+  BlockDecomposition2D(const BlockDecomposition2D &) = delete;
+  BlockDecomposition2D &operator=(const BlockDecomposition2D &) = delete;
+
+  ~BlockDecomposition2D() {
+    if (cart != MPI_COMM_NULL) {
+      MPI_Comm_free(&cart);
+    }
+  }
+
+  inline MPI_Comm comm() const { return cart; }
+  inline int rank() const { return rank_; }
+  inline int size() const { return size_; }
+  inline const std::array<int, 2> &process_grid() const { return dims; }
+  inline int64_t ny() const { return global_ny; }
+  inline int64_t nx() const { return global_nx; }
+
+  /**
+   * @brief Global rows and columns owned by this rank
+   */
+  inline const Box2D &owned() const { return owned_; }
+
+  /**
+   * @brief Rank of the neighbour at offset (dy, dx), MPI_PROC_NULL outside the domain
+   */
+  inline int neighbour(const int dy, const int dx) const { return neighbours[dy + 1][dx + 1]; }
+
+  /**
+   * @brief Owned cells in local index
+   */
+  inline Box2D interior() const {
+    return {halo, halo + owned_.y1 - owned_.y0, halo, halo + owned_.x1 - owned_.x0};
+  }
+
+  /**
+   * @brief Local cells holding phi after a halo exchange
+   */
+  inline Box2D valid() const {
+    const auto in = interior();
+    return {neighbour(-1, 0) == MPI_PROC_NULL ? in.y0 : 0,
+            neighbour(1, 0) == MPI_PROC_NULL ? in.y1 : in.y1 + halo,
+            neighbour(0, -1) == MPI_PROC_NULL ? in.x0 : 0,
+            neighbour(0, 1) == MPI_PROC_NULL ? in.x1 : in.x1 + halo};
+  }
+
+  /**
+   * @brief Zero initialized local field including the halo
+   */
+  inline Field2D make_field() const {
+    const std::size_t ny = owned_.y1 - owned_.y0 + 2 * halo;
+    const std::size_t nx = owned_.x1 - owned_.x0 + 2 * halo;
+    return Field2D({ny, nx});
+  }
+
+  /**
+   * @brief Distribute a global field held by root to the local fields
+   *  Collective. The halos are left untouched.
+   */
+  inline void scatter(const Field2D &global, Field2D &local, const int root = 0) const {
+    const auto in = interior();
+    const auto copy_in = [&in, &local](const std::vector<double> &buf) {
+      std::size_t k = 0;
+      for (int64_t y = in.y0; y < in.y1; ++y) {
+        auto &&row = local[y];
+        for (int64_t x = in.x0; x < in.x1; ++x) {
+          row[x] = buf[k++];
+        }
+      }
+    };
+
+    std::vector<double> buf;
+    if (rank_ == root) {
+      if (global.shape()[0] != static_cast<std::size_t>(global_ny) ||
+          global.shape()[1] != static_cast<std::size_t>(global_nx)) {
+        throw std::runtime_error("invalid shape of tensor given");
+      }
+      for (int r = 0; r < size_; ++r) {
+        const auto b = box_of_rank(r);
+        buf.clear();
+        for (int64_t y = b.y0; y < b.y1; ++y) {
+          const auto &row = global[y];
+          for (int64_t x = b.x0; x < b.x1; ++x) {
+            buf.push_back(row[x]);
+          }
+        }
+        if (r == rank_) {
+          copy_in(buf);
+        } else {
+          check(MPI_Send(buf.data(), buf.size(), MPI_DOUBLE, r, 0, cart), "MPI_Send");
+        }
+      }
+    } else {
+      buf.resize((in.y1 - in.y0) * (in.x1 - in.x0));
+      check(MPI_Recv(buf.data(), buf.size(), MPI_DOUBLE, root, 0, cart, MPI_STATUS_IGNORE),
+            "MPI_Recv");
+      copy_in(buf);
+    }
+  }
+
+  /**
+   * @brief Collect the owned cells of every rank into a global field on root
+   *  Collective. global is resized on root and ignored elsewhere.
+   */
+  inline void gather(const Field2D &local, Field2D &global, const int root = 0) const {
+    const auto in = interior();
+    std::vector<double> buf;
+    if (rank_ != root) {
+      buf.reserve((in.y1 - in.y0) * (in.x1 - in.x0));
+      for (int64_t y = in.y0; y < in.y1; ++y) {
+        const auto &row = local[y];
+        for (int64_t x = in.x0; x < in.x1; ++x) {
+          buf.push_back(row[x]);
+        }
+      }
+      check(MPI_Send(buf.data(), buf.size(), MPI_DOUBLE, root, 1, cart), "MPI_Send");
+      return;
+    }
+
+    global.resize({static_cast<std::size_t>(global_ny), static_cast<std::size_t>(global_nx)});
+    for (int r = 0; r < size_; ++r) {
+      const auto b = box_of_rank(r);
+      if (r == rank_) {
+        for (int64_t y = b.y0; y < b.y1; ++y) {
+          const auto &src = local[y - b.y0 + in.y0];
+          auto &&dst = global[y];
+          for (int64_t x = b.x0; x < b.x1; ++x) {
+            dst[x] = src[x - b.x0 + in.x0];
+          }
+        }
+        continue;
+      }
+      buf.resize((b.y1 - b.y0) * (b.x1 - b.x0));
+      check(MPI_Recv(buf.data(), buf.size(), MPI_DOUBLE, r, 1, cart, MPI_STATUS_IGNORE),
+            "MPI_Recv");
+      std::size_t k = 0;
+      for (int64_t y = b.y0; y < b.y1; ++y) {
+        auto &&dst = global[y];
+        for (int64_t x = b.x0; x < b.x1; ++x) {
+          dst[x] = buf[k++];
+        }
+      }
+    }
+  }
+};
+
+/**
+ * @brief Non-blocking exchange of the halo with the eight neighbours
+ *  begin packs the owned edge cells and posts the sends and receives; end waits and unpacks
+ *  into the halo. Corners are exchanged with the diagonal neighbours since the gradient at a
+ *  face reads the cells next to it in the other direction.
+ */
+class HaloExchange {
+  const BlockDecomposition2D &decomp;
+  std::array<std::vector<double>, 9> send_buf;
+  std::array<std::vector<double>, 9> recv_buf;
+  std::vector<MPI_Request> requests;
+
+  /* Local rows (or columns) sent towards direction d and received from it */
+  static inline std::array<int64_t, 2> send_range(const int d, const int64_t lo, const int64_t hi) {
+    return d < 0 ? std::array<int64_t, 2>{lo, lo + halo}
+                 : d > 0 ? std::array<int64_t, 2>{hi - halo, hi} : std::array<int64_t, 2>{lo, hi};
+  }
+  static inline std::array<int64_t, 2> recv_range(const int d, const int64_t lo, const int64_t hi) {
+    return d < 0 ? std::array<int64_t, 2>{lo - halo, lo}
+                 : d > 0 ? std::array<int64_t, 2>{hi, hi + halo} : std::array<int64_t, 2>{lo, hi};
+  }
+  static inline int tag(const int dy, const int dx) { return (dy + 1) * 3 + (dx + 1); }
+
+public:
+  explicit HaloExchange(const BlockDecomposition2D &d) : decomp(d) { requests.reserve(16); }
+
+  /**
+   * @brief Post the exchange of the halo of phi
+   *  The owned cells of phi must not change until end returns.
+   */
+  inline void begin(const Field2D &phi) {
+    const auto in = decomp.interior();
+    requests.clear();
+    for (int dy = -1; dy <= 1; ++dy) {
+      for (int dx = -1; dx <= 1; ++dx) {
+        const int n = decomp.neighbour(dy, dx);
+        if (n == MPI_PROC_NULL) {
+          continue;
+        }
+        const auto id = tag(dy, dx);
+        const auto ys = send_range(dy, in.y0, in.y1);
+        const auto xs = send_range(dx, in.x0, in.x1);
+        auto &sb = send_buf[id];
+        sb.resize((ys[1] - ys[0]) * (xs[1] - xs[0]));
+        recv_buf[id].resize(sb.size());
+        std::size_t k = 0;
+        for (int64_t y = ys[0]; y < ys[1]; ++y) {
+          const auto &row = phi[y];
+          for (int64_t x = xs[0]; x < xs[1]; ++x) {
+            sb[k++] = row[x];
+          }
+        }
+        /* The neighbour in direction d sends towards -d */
+        requests.emplace_back();
+        check(MPI_Irecv(recv_buf[id].data(), recv_buf[id].size(), MPI_DOUBLE, n, tag(-dy, -dx),
+                        decomp.comm(), &requests.back()),
+              "MPI_Irecv");
+        requests.emplace_back();
+        check(MPI_Isend(sb.data(), sb.size(), MPI_DOUBLE, n, id, decomp.comm(), &requests.back()),
+              "MPI_Isend");
+      }
+    }
+  }
+
+  /**
+   * @brief Wait for the exchange posted by begin and fill the halo of phi
+   */
+  inline void end(Field2D &phi) {
+    check(MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE), "MPI_Waitall");
+    const auto in = decomp.interior();
+    for (int dy = -1; dy <= 1; ++dy) {
+      for (int dx = -1; dx <= 1; ++dx) {
+        if (decomp.neighbour(dy, dx) == MPI_PROC_NULL) {
+          continue;
+        }
+        const auto ys = recv_range(dy, in.y0, in.y1);
+        const auto xs = recv_range(dx, in.x0, in.x1);
+        const auto &rb = recv_buf[tag(dy, dx)];
+        std::size_t k = 0;
+        for (int64_t y = ys[0]; y < ys[1]; ++y) {
+          auto &&row = phi[y];
+          for (int64_t x = xs[0]; x < xs[1]; ++x) {
+            row[x] = rb[k++];
+          }
+        }
+      }
+    }
+    requests.clear();
+  }
+};
+
+/**
+ * @brief Distributed explicit solver of the 2D phase field
+ *  Every rank advances its block with the fused kernel. The halo exchange is overlapped with
+ *  the cells that do not depend on it: the master thread waits for the messages while the other
+ *  threads update the inner cells, then all threads update the edge strips.
+ *
+ *  MPI must be initialized with at least MPI_THREAD_FUNNELED; only the master thread calls MPI.
+ *  The result equals PhaseField2D::predict on the gathered field bitwise.
+ */
+class DistributedPhaseField2D {
+public:
+  const Param param;
+
+private:
+  const BlockDecomposition2D &decomp;
+  mutable HaloExchange exchange;
+  mutable PredictWorkspace workspace;
+  FusedPredictKernel fused;
+
+public:
+  DistributedPhaseField2D(const Param &p, const BlockDecomposition2D &d)
+      : param(p), decomp(d), exchange(d), fused(p) {}
+
+  /**
+   * @brief Advance the local block by one step
+   *
+   * @param phi current local field, its halo is refreshed
+   * @param ret next local field, only the owned cells are written
+   */
+  inline void predict(Field2D &phi, Field2D &ret) const {
+    if (phi.shape() != ret.shape()) {
+      throw std::runtime_error("invalid shape of tensor given");
+    }
+    const auto in = decomp.interior();
+    const auto valid = decomp.valid();
+    /* Cells at least halo away from every edge only read owned cells */
+    const Box2D inner{in.y0 + halo, in.y1 - halo, in.x0 + halo, in.x1 - halo};
+    const Box2D strips[4] = {{in.y0, inner.y0, in.x0, in.x1},
+                             {inner.y1, in.y1, in.x0, in.x1},
+                             {inner.y0, inner.y1, in.x0, inner.x0},
+                             {inner.y0, inner.y1, inner.x1, in.x1}};
+
+    workspace.reserve(phi);
+    exchange.begin(phi);
+#pragma omp parallel
+    {
+      auto &s = workspace.thread_scratch();
+#pragma omp master
+      exchange.end(phi);
+      fused.sweep(phi, ret, inner, valid, s);
+#pragma omp barrier
+      for (const auto &strip : strips) {
+        fused.sweep(phi, ret, strip, valid, s);
+      }
+    }
+  }
+};
+
+/**
+ * @brief Write the owned cells of every rank to one snapshot file with MPI-IO
+ *  Collective. The file is identical to io::write_snapshot of the gathered field.
+ *
+ * @param filename output path, overwritten if it exists
+ * @param decomp decomposition of local
+ * @param local local field including the halo
+ * @param info step, time and metadata
+ */
+inline void write_snapshot(const std::filesystem::path &filename,
+                           const BlockDecomposition2D &decomp, const Field2D &local,
+                           const io::SnapshotInfo &info) {
+  const std::string meta = info.meta.dump();
+  const auto header = io::make_snapshot_header(
+      {static_cast<uint64_t>(decomp.ny()), static_cast<uint64_t>(decomp.nx())}, info, meta);
+
+  if (decomp.rank() == 0 && std::filesystem::exists(filename)) {
+    std::filesystem::remove(filename);
+  }
+  check(MPI_Barrier(decomp.comm()), "MPI_Barrier");
+
+  MPI_File fh;
+  check(MPI_File_open(decomp.comm(), filename.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY,
+                      MPI_INFO_NULL, &fh),
+        ("could not open '" + filename.string() + "'").c_str());
+  if (decomp.rank() == 0) {
+    std::vector<char> head(header.data_offset, '\0');
+    std::memcpy(head.data(), &header, sizeof(header));
+    std::memcpy(head.data() + sizeof(header), meta.data(), meta.size());
+    check(MPI_File_write_at(fh, 0, head.data(), head.size(), MPI_CHAR, MPI_STATUS_IGNORE),
+          "MPI_File_write_at");
+  }
+
+  const auto &b = decomp.owned();
+  const auto in = decomp.interior();
+  const int sizes[2] = {static_cast<int>(decomp.ny()), static_cast<int>(decomp.nx())};
+  const int sub[2] = {static_cast<int>(b.y1 - b.y0), static_cast<int>(b.x1 - b.x0)};
+  const int starts[2] = {static_cast<int>(b.y0), static_cast<int>(b.x0)};
+  MPI_Datatype filetype;
+  check(MPI_Type_create_subarray(2, sizes, sub, starts, MPI_ORDER_C, MPI_DOUBLE, &filetype),
+        "MPI_Type_create_subarray");
+  check(MPI_Type_commit(&filetype), "MPI_Type_commit");
+
+  std::vector<double> buf;
+  buf.reserve(sub[0] * sub[1]);
+  for (int64_t y = in.y0; y < in.y1; ++y) {
+    const auto &row = local[y];
+    for (int64_t x = in.x0; x < in.x1; ++x) {
+      buf.push_back(row[x]);
+    }
+  }
+  char native[] = "native";
+  check(MPI_File_set_view(fh, header.data_offset, MPI_DOUBLE, filetype, native, MPI_INFO_NULL),
+        "MPI_File_set_view");
+  check(MPI_File_write_all(fh, buf.data(), buf.size(), MPI_DOUBLE, MPI_STATUS_IGNORE),
+        "MPI_File_write_all");
+  MPI_Type_free(&filetype);
+  check(MPI_File_close(&fh), "MPI_File_close");
+}
+
+/**
+ * @brief Read the owned cells of every rank from one snapshot file with MPI-IO
+ *  Collective. The halo of local is left untouched.
+ *
+ * @param filename snapshot written by write_snapshot or io::write_snapshot
+ * @param decomp decomposition of local, must match the shape of the snapshot
+ * @param local local field including the halo
+ * @return step, time and metadata of the snapshot
+ */
+inline io::SnapshotInfo read_snapshot(const std::filesystem::path &filename,
+                                      const BlockDecomposition2D &decomp, Field2D &local) {
+  MPI_File fh;
+  check(MPI_File_open(decomp.comm(), filename.c_str(), MPI_MODE_RDONLY, MPI_INFO_NULL, &fh),
+        ("could not open '" + filename.string() + "'").c_str());
+
+  io::SnapshotHeader header;
+  check(MPI_File_read_at_all(fh, 0, &header, sizeof(header), MPI_CHAR, MPI_STATUS_IGNORE),
+        "MPI_File_read_at_all");
+  if (std::memcmp(header.magic, io::snapshot_magic, sizeof(header.magic)) != 0 ||
+      header.version != io::snapshot_version || header.dtype != io::DType::float64 ||
+      header.rank != 2) {
+    MPI_File_close(&fh);
+    throw std::runtime_error("'" + filename.string() + "' is not a 2D float64 snapshot");
+  }
+  if (header.shape[0] != static_cast<uint64_t>(decomp.ny()) ||
+      header.shape[1] != static_cast<uint64_t>(decomp.nx())) {
+    MPI_File_close(&fh);
+    throw std::runtime_error("shape of '" + filename.string() + "' does not match");
+  }
+  std::string meta(header.meta_size, '\0');
+  check(MPI_File_read_at_all(fh, sizeof(header), meta.data(), meta.size(), MPI_CHAR,
+                             MPI_STATUS_IGNORE),
+        "MPI_File_read_at_all");
+
+  const auto &b = decomp.owned();
+  const auto in = decomp.interior();
+  const int sizes[2] = {static_cast<int>(decomp.ny()), static_cast<int>(decomp.nx())};
+  const int sub[2] = {static_cast<int>(b.y1 - b.y0), static_cast<int>(b.x1 - b.x0)};
+  const int starts[2] = {static_cast<int>(b.y0), static_cast<int>(b.x0)};
+  MPI_Datatype filetype;
+  check(MPI_Type_create_subarray(2, sizes, sub, starts, MPI_ORDER_C, MPI_DOUBLE, &filetype),
+        "MPI_Type_create_subarray");
+  check(MPI_Type_commit(&filetype), "MPI_Type_commit");
+
+  std::vector<double> buf(sub[0] * sub[1]);
+  char native[] = "native";
+  check(MPI_File_set_view(fh, header.data_offset, MPI_DOUBLE, filetype, native, MPI_INFO_NULL),
+        "MPI_File_set_view");
+  check(MPI_File_read_all(fh, buf.data(), buf.size(), MPI_DOUBLE, MPI_STATUS_IGNORE),
+        "MPI_File_read_all");
+  MPI_Type_free(&filetype);
+  check(MPI_File_close(&fh), "MPI_File_close");
+
+  std::size_t k = 0;
+  for (int64_t y = in.y0; y < in.y1; ++y) {
+    auto &&row = local[y];
+    for (int64_t x = in.x0; x < in.x1; ++x) {
+      row[x] = buf[k++];
+    }
+  }
+
+  io::SnapshotInfo info(header.step, header.time);
+  info.meta = nlohmann::json::parse(meta);
+  return info;
+}
+} // namespace phase_field::mpi
+
+#endif // __PHASE_FIELD__MPI__
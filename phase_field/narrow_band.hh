@@ -0,0 +1,295 @@
+/*
+ * Copyright (c) 2025 Materials Modelling Lab, The University of Tokyo
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __PHASE_FIELD__NARROW_BAND__
+#define __PHASE_FIELD__NARROW_BAND__
+
+#include "impl/kernel.hh"
+#include "impl/type.hh"
+#include "impl/workspace.hh"
+#include "param.hh"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace phase_field {
+/**
+ * @brief Tiles of a field that changed in the last step
+ *  The update of a cell only reads the cells within two of it, and tiles are wider than that, so
+ *  a tile whose own cells and whose eight neighbours did not change in the last step has the
+ *  same input as in that step and therefore the same (already stored) result. Only the tiles
+ *  around those that changed are active. In the bulk solid and liquid the update is exactly
+ *  zero (phi is clamped to FieldState::solid and FieldState::liquid), so the active tiles
+ *  follow the interface; the layer that settles along the zero padded boundary drops out too.
+ *
+ *  A change of at most tolerance counts as none. Tolerance 0 keeps the result bitwise
+ *  identical to a full step; a positive tolerance freezes cells that move slower than that.
+ */
+class ActivityMap {
+public:
+  using T = Field2D::scalar_type;
+  static constexpr int64_t tile_y = 32;
+  static constexpr int64_t tile_x = 64;
+
+private:
+  int64_t ny = 0, nx = 0;
+  int64_t n_ty = 0, n_tx = 0;
+  T tol;
+  std::vector<uint8_t> changed;
+  std::vector<uint8_t> was_active;
+  std::vector<int64_t> active_tiles;
+  std::vector<int64_t> stale_tiles;
+
+public:
+  /**
+   * @param tolerance largest change of a cell that counts as unchanged
+   */
+  explicit ActivityMap(const T tolerance = 0.0) : tol(tolerance) {
+    if (!(0.0 <= tolerance)) {
+      throw std::invalid_argument("tolerance must not be negative");
+    }
+  }
+
+  inline Box2D tile_box(const int64_t t) const {
+    const int64_t ty = t / n_tx;
+    const int64_t tx = t % n_tx;
+    return {ty * tile_y, std::min(ny, (ty + 1) * tile_y), tx * tile_x,
+            std::min(nx, (tx + 1) * tile_x)};
+  }
+
+  /**
+   * @brief Whether any cell of the box differs by more than the tolerance
+   */
+  inline bool differs(const Field2D &prev, const Field2D &next, const Box2D &b) const {
+    for (int64_t y = b.y0; y < b.y1; ++y) {
+      const auto &p = prev[y];
+      const auto &n = next[y];
+      T diff = 0.0;
+      for (int64_t x = b.x0; x < b.x1; ++x) {
+        diff = std::max(diff, std::abs(n[x] - p[x]));
+      }
+      if (diff > tol) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * @brief Mark every tile of a field of the shape of phi as changed
+   */
+  inline void reset(const Field2D &phi) {
+    ny = phi.shape()[0];
+    nx = phi.shape()[1];
+    n_ty = (ny + tile_y - 1) / tile_y;
+    n_tx = (nx + tile_x - 1) / tile_x;
+    changed.assign(n_ty * n_tx, 1);
+    was_active.assign(n_ty * n_tx, 1);
+  }
+
+  /**
+   * @brief Drop every tile state, the next step computes every tile
+   */
+  inline void clear() {
+    ny = nx = n_ty = n_tx = 0;
+    changed.clear();
+    was_active.clear();
+  }
+
+  inline bool matches(const Field2D &phi) const {
+    return static_cast<int64_t>(phi.shape()[0]) == ny &&
+           static_cast<int64_t>(phi.shape()[1]) == nx;
+  }
+
+  /**
+   * @brief Build the list of tiles to compute and of skipped tiles whose copy in ret is stale
+   *  Must be called once per step, before the tiles are computed.
+   */
+  inline void select() {
+    active_tiles.clear();
+    stale_tiles.clear();
+    for (int64_t ty = 0; ty < n_ty; ++ty) {
+      for (int64_t tx = 0; tx < n_tx; ++tx) {
+        bool active = false;
+        for (int64_t y = std::max<int64_t>(ty - 1, 0); y <= std::min(ty + 1, n_ty - 1); ++y) {
+          for (int64_t x = std::max<int64_t>(tx - 1, 0); x <= std::min(tx + 1, n_tx - 1); ++x) {
+            active |= changed[y * n_tx + x] != 0;
+          }
+        }
+        const int64_t t = ty * n_tx + tx;
+        if (active) {
+          active_tiles.push_back(t);
+        } else if (was_active[t]) {
+          stale_tiles.push_back(t);
+        }
+        was_active[t] = active;
+      }
+    }
+    /* Skipped tiles do not change; computed tiles are marked by the step */
+    for (const auto t : stale_tiles) {
+      changed[t] = 0;
+    }
+  }
+
+  /**
+   * @brief Tile states as one character per tile and flag, empty before the first step
+   */
+  inline std::string state() const {
+    std::string ret(2 * changed.size(), '0');
+    for (std::size_t t = 0; t < changed.size(); ++t) {
+      ret[2 * t] = changed[t] ? '1' : '0';
+      ret[2 * t + 1] = was_active[t] ? '1' : '0';
+    }
+    return ret;
+  }
+
+  /**
+   * @brief Restore the tile states of a field of the shape of phi saved by state
+   */
+  inline void restore(const Field2D &phi, const std::string &s) {
+    if (s.empty()) {
+      clear();
+      return;
+    }
+    reset(phi);
+    if (s.size() != 2 * changed.size()) {
+      clear();
+      throw std::invalid_argument("tile states do not match the field");
+    }
+    for (std::size_t t = 0; t < changed.size(); ++t) {
+      changed[t] = s[2 * t] == '1';
+      was_active[t] = s[2 * t + 1] == '1';
+    }
+  }
+
+  inline const std::vector<int64_t> &active() const { return active_tiles; }
+  inline const std::vector<int64_t> &stale() const { return stale_tiles; }
+  inline void set_changed(const int64_t t, const bool c) { changed[t] = c; }
+  inline int64_t size() const { return n_ty * n_tx; }
+
+  /**
+   * @brief Fraction of the tiles computed by the last step
+   */
+  inline double active_fraction() const {
+    return size() == 0 ? 0.0 : static_cast<double>(active_tiles.size()) / size();
+  }
+};
+
+/**
+ * @brief Explicit solver of the 2D phase field that only computes the tiles near the interface
+ *  Skipped tiles are copied from phi to ret only when ret may hold an older value there, that
+ *  is when the tile was computed in the previous step. This relies on phi and ret being the two
+ *  buffers of a ping-pong pair (swapped, or ret copied back into phi, after every step); call
+ *  reset when the field is modified or replaced by anything else. Whether a computed tile
+ *  changed is checked right after it is written, while it is still in cache, so the activity
+ *  map is refreshed without scanning the bulk.
+ *
+ *  With tolerance 0 the result is bitwise identical to PhaseField2D::predict.
+ */
+class NarrowBandPhaseField2D {
+public:
+  const Param param;
+
+private:
+  mutable PredictWorkspace workspace;
+  mutable ActivityMap map;
+  FusedPredictKernel fused;
+
+public:
+  NarrowBandPhaseField2D(const Param &p, const Field2D::scalar_type tolerance = 0.0)
+      : param(p), map(tolerance), fused(param) {}
+
+  /**
+   * @brief Forget the tile states, the next step computes every tile
+   */
+  inline void reset() const { map.clear(); }
+
+  /**
+   * @brief Advance the phase field by one step
+   *
+   * @param phi current phase field
+   * @param ret next phase field of the same ping-pong pair
+   */
+  inline void predict(const Field2D &phi, Field2D &ret) const {
+    if (phi.shape() != ret.shape()) {
+      throw std::runtime_error("invalid shape of tensor given");
+    }
+    if (!map.matches(phi)) {
+      map.reset(phi);
+    }
+    map.select();
+    workspace.reserve(phi);
+
+    const auto &active = map.active();
+    const auto &stale = map.stale();
+    const int64_t n_active = active.size();
+    const int64_t n_stale = stale.size();
+    const Box2D domain{0, static_cast<int64_t>(phi.shape()[0]), 0,
+                       static_cast<int64_t>(phi.shape()[1])};
+#pragma omp parallel
+    {
+      auto &s = workspace.thread_scratch();
+#pragma omp for schedule(dynamic) nowait
+      for (int64_t k = 0; k < n_active; ++k) {
+        const auto box = map.tile_box(active[k]);
+        fused.tile(phi, ret, box, domain, s);
+        map.set_changed(active[k], map.differs(phi, ret, box));
+      }
+#pragma omp for schedule(dynamic)
+      for (int64_t k = 0; k < n_stale; ++k) {
+        const auto box = map.tile_box(stale[k]);
+        for (int64_t y = box.y0; y < box.y1; ++y) {
+          const auto &src = phi[y];
+          auto &&dst = ret[y];
+          for (int64_t x = box.x0; x < box.x1; ++x) {
+            dst[x] = src[x];
+          }
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief Tile states, to be stored with phi in a checkpoint
+   */
+  inline std::string state() const { return map.state(); }
+
+  /**
+   * @brief Continue from tile states saved by state
+   *  The tiles left alone by a step keep what ret held, so phi is copied into ret, the buffer
+   *  of the next step, and the result stays bitwise identical to the run that saved the states.
+   *
+   * @param phi current phase field, read from the checkpoint
+   * @param ret next phase field of the same ping-pong pair
+   * @param s tile states saved by state
+   */
+  inline void restore(const Field2D &phi, Field2D &ret, const std::string &s) const {
+    if (phi.shape() != ret.shape()) {
+      throw std::runtime_error("invalid shape of tensor given");
+    }
+    map.restore(phi, s);
+    const auto ny = static_cast<int64_t>(phi.shape()[0]);
+    const auto nx = static_cast<int64_t>(phi.shape()[1]);
+#pragma omp parallel for schedule(static)
+    for (int64_t y = 0; y < ny; ++y) {
+      const auto &src = phi[y];
+      auto &&dst = ret[y];
+      for (int64_t x = 0; x < nx; ++x) {
+        dst[x] = src[x];
+      }
+    }
+  }
+
+  /**
+   * @brief Fraction of the tiles computed by the last step
+   */
+  inline double active_fraction() const { return map.active_fraction(); }
+};
+} // namespace phase_field
+
+#endif // __PHASE_FIELD__NARROW_BAND__
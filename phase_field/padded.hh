@@ -0,0 +1,341 @@
+/*
+ * Copyright (c) 2025 Materials Modelling Lab, The University of Tokyo
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __PHASE_FIELD__PADDED__
+#define __PHASE_FIELD__PADDED__
+
+#include "impl/kernel.hh"
+#include "impl/type.hh"
+#include "impl/workspace.hh"
+#include "param.hh"
+#include "phase_field.hh"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <omp.h>
+#include <stdexcept>
+#include <vector>
+
+namespace phase_field {
+/**
+ * @brief How the ghost cells beyond one side of the domain are filled
+ *  mirror:    reflection about the face, ghost -1 holds cell 0 and ghost -2 cell 1, so the
+ *             normal gradient vanishes at the face (Neumann, the symmetry of a quarter domain)
+ *  periodic:  the cells of the opposite side, which must be periodic as well
+ *  dirichlet: a fixed value
+ */
+enum class BoundaryKind { mirror, periodic, dirichlet };
+
+struct Boundary {
+  BoundaryKind kind = BoundaryKind::mirror;
+  double value = 0.0; // ghost value of dirichlet
+
+  static inline Boundary mirror() { return {BoundaryKind::mirror, 0.0}; }
+  static inline Boundary periodic() { return {BoundaryKind::periodic, 0.0}; }
+  static inline Boundary dirichlet(const double v) { return {BoundaryKind::dirichlet, v}; }
+};
+
+/**
+ * @brief Boundary of each side of a 2D domain, y0 and x0 being the sides at index 0
+ */
+struct Boundaries2D {
+  Boundary y0, y1, x0, x1;
+
+  Boundaries2D() = default;
+  explicit Boundaries2D(const Boundary &all) : y0(all), y1(all), x0(all), x1(all) {}
+  Boundaries2D(const Boundary &y0, const Boundary &y1, const Boundary &x0, const Boundary &x1)
+      : y0(y0), y1(y1), x0(x0), x1(x1) {}
+
+  /**
+   * @brief Check the boundaries against a ny x nx domain with ghost layers of width ghost
+   */
+  inline void validate(const int64_t ny, const int64_t nx, const int64_t ghost) const {
+    const auto pair = [](const Boundary &lo, const Boundary &hi) {
+      return (lo.kind == BoundaryKind::periodic) == (hi.kind == BoundaryKind::periodic);
+    };
+    if (!pair(y0, y1) || !pair(x0, x1)) {
+      throw std::invalid_argument("periodic boundaries must be given on both sides");
+    }
+    const auto reads = [](const Boundary &b) { return b.kind != BoundaryKind::dirichlet; };
+    if ((reads(y0) || reads(y1)) && ny < ghost) {
+      throw std::invalid_argument("domain too small for a mirror or periodic boundary along y");
+    }
+    if ((reads(x0) || reads(x1)) && nx < ghost) {
+      throw std::invalid_argument("domain too small for a mirror or periodic boundary along x");
+    }
+  }
+};
+
+/**
+ * @brief Allocator returning storage aligned to Alignment bytes
+ */
+template <typename S, std::size_t Alignment> struct AlignedAllocator {
+  using value_type = S;
+  template <typename U> struct rebind {
+    using other = AlignedAllocator<U, Alignment>;
+  };
+
+  AlignedAllocator() = default;
+  template <typename U> AlignedAllocator(const AlignedAllocator<U, Alignment> &) {}
+
+  inline S *allocate(const std::size_t n) {
+    return static_cast<S *>(::operator new(n * sizeof(S), std::align_val_t(Alignment)));
+  }
+  inline void deallocate(S *p, std::size_t) { ::operator delete(p, std::align_val_t(Alignment)); }
+
+  template <typename U> inline bool operator==(const AlignedAllocator<U, Alignment> &) const {
+    return true;
+  }
+  template <typename U> inline bool operator!=(const AlignedAllocator<U, Alignment> &) const {
+    return false;
+  }
+};
+
+/**
+ * @brief 2D field of ny x nx cells surrounded by ghost layers of width ghost
+ *  phi[y][x] is valid for y in [-ghost, ny + ghost) and x in [-ghost, nx + ghost). Every row
+ *  starts cell 0 on an alignment byte boundary, so the interior of a row is aligned for SIMD
+ *  loads; the ghost cells sit in the padding just before it.
+ *
+ *  The ghost layers are filled from the boundaries by fill, once per step, after which the
+ *  stencil reads every neighbour from memory with no test for the edge of the domain.
+ */
+template <typename S> class BasicPaddedField2D {
+public:
+  using scalar_type = S;
+  static constexpr int64_t ghost = 2;
+  static constexpr std::size_t alignment = 64;
+
+private:
+  static_assert(alignment % sizeof(S) == 0, "alignment must be a multiple of the scalar");
+  static constexpr int64_t lead = static_cast<int64_t>(alignment / sizeof(S)); // before cell 0
+  static_assert(lead >= ghost, "ghost cells must fit in front of cell 0");
+
+  std::array<std::size_t, 2> extent{0, 0};
+  int64_t pitch = 0;
+  std::vector<S, AlignedAllocator<S, alignment>> buf;
+
+  inline S *origin() { return buf.data() + ghost * pitch + lead; }
+  inline const S *origin() const { return buf.data() + ghost * pitch + lead; }
+
+  /* ghost cell -g, g = 1 .. ghost, of a line of n cells at p spaced by d */
+  static inline void fill_line(S *p, const int64_t n, const int64_t d, const Boundary &lo,
+                               const Boundary &hi) {
+    for (int64_t g = 1; g <= ghost; ++g) {
+      S *dst_lo = p - g * d;
+      S *dst_hi = p + (n - 1 + g) * d;
+      switch (lo.kind) {
+      case BoundaryKind::mirror:
+        *dst_lo = p[(g - 1) * d];
+        break;
+      case BoundaryKind::periodic:
+        *dst_lo = p[(n - g) * d];
+        break;
+      case BoundaryKind::dirichlet:
+        *dst_lo = static_cast<S>(lo.value);
+      }
+      switch (hi.kind) {
+      case BoundaryKind::mirror:
+        *dst_hi = p[(n - g) * d];
+        break;
+      case BoundaryKind::periodic:
+        *dst_hi = p[(g - 1) * d];
+        break;
+      case BoundaryKind::dirichlet:
+        *dst_hi = static_cast<S>(hi.value);
+      }
+    }
+  }
+
+public:
+  BasicPaddedField2D() = default;
+
+  /**
+   * @param shape interior cells {ny, nx}, zero initialized along with the ghost cells
+   */
+  explicit BasicPaddedField2D(const std::array<std::size_t, 2> &shape) : extent(shape) {
+    const auto nx = static_cast<int64_t>(shape[1]);
+    pitch = (lead + nx + ghost + lead - 1) / lead * lead;
+    buf.assign(static_cast<std::size_t>((static_cast<int64_t>(shape[0]) + 2 * ghost) * pitch),
+               S(0));
+  }
+
+  /**
+   * @brief Copy of the interior of phi, the ghost cells left zero until fill
+   */
+  explicit BasicPaddedField2D(const BasicField2D<S> &phi)
+      : BasicPaddedField2D(std::array<std::size_t, 2>{phi.shape()[0], phi.shape()[1]}) {
+    assign(phi);
+  }
+
+  static inline BasicPaddedField2D like(const BasicPaddedField2D &f) {
+    return BasicPaddedField2D(f.shape());
+  }
+
+  inline const std::array<std::size_t, 2> &shape() const { return extent; }
+
+  /**
+   * @brief Distance between two rows in cells, a multiple of alignment bytes
+   */
+  inline int64_t stride() const { return pitch; }
+
+  inline S *operator[](const int64_t y) { return origin() + y * pitch; }
+  inline const S *operator[](const int64_t y) const { return origin() + y * pitch; }
+
+  /**
+   * @brief Copy the interior from phi of the same shape
+   */
+  inline void assign(const BasicField2D<S> &phi) {
+    if (phi.shape()[0] != extent[0] || phi.shape()[1] != extent[1]) {
+      throw std::runtime_error("invalid shape of tensor given");
+    }
+    for (int64_t y = 0; y < static_cast<int64_t>(extent[0]); ++y) {
+      const auto &src = phi[y];
+      S *dst = (*this)[y];
+      for (int64_t x = 0; x < static_cast<int64_t>(extent[1]); ++x) {
+        dst[x] = src[x];
+      }
+    }
+  }
+
+  /**
+   * @brief Copy the interior into phi of the same shape
+   */
+  inline void copy_to(BasicField2D<S> &phi) const {
+    if (phi.shape()[0] != extent[0] || phi.shape()[1] != extent[1]) {
+      throw std::runtime_error("invalid shape of tensor given");
+    }
+    for (int64_t y = 0; y < static_cast<int64_t>(extent[0]); ++y) {
+      const S *src = (*this)[y];
+      auto &&dst = phi[y];
+      for (int64_t x = 0; x < static_cast<int64_t>(extent[1]); ++x) {
+        dst[x] = src[x];
+      }
+    }
+  }
+
+  /**
+   * @brief Fill the ghost layers from the boundaries
+   *  The ghost columns of every row are filled first, then the ghost rows are filled whole, so
+   *  the corners follow the boundaries of y applied to the ghost columns. Work-shared when
+   *  called from inside an OpenMP parallel region, by every thread of it.
+   *
+   * @param b boundaries, checked with Boundaries2D::validate by the caller
+   */
+  inline void fill(const Boundaries2D &b) {
+    const auto ny = static_cast<int64_t>(extent[0]);
+    const auto nx = static_cast<int64_t>(extent[1]);
+#pragma omp for schedule(static)
+    for (int64_t y = 0; y < ny; ++y) {
+      fill_line((*this)[y], nx, 1, b.x0, b.x1);
+    }
+#pragma omp for schedule(static)
+    for (int64_t x = -ghost; x < nx + ghost; ++x) {
+      fill_line((*this)[0] + x, ny, pitch, b.y0, b.y1);
+    }
+  }
+};
+
+using PaddedField2D = BasicPaddedField2D<Field2D::scalar_type>;
+using PaddedPingPong2D = BasicPingPong2D<Field2D::scalar_type, PaddedField2D>;
+
+/**
+ * @brief Explicit solver of the 2D phase field on a padded field with the given boundaries
+ *  Each step fills the ghost layers of the current field, then runs the fused kernel over the
+ *  interior with the whole padded field valid: the gradient and the fluxes next to the edge are
+ *  taken from the ghost cells, so the stencil over the interior has no boundary case.
+ *
+ *  Unlike the zero padding of BasicPhaseField2D, which zeroes phi and the fluxes outside the
+ *  domain, dirichlet here fixes only phi in the ghost cells; the fluxes across the face follow
+ *  from it.
+ */
+template <typename S, typename A = S> class BasicPaddedPhaseField2D {
+public:
+  using Field = BasicPaddedField2D<S>;
+  using State = BasicPingPong2D<S, Field>;
+  using Workspace = BasicPredictWorkspace<S, A>;
+  static constexpr int64_t ghost = Field::ghost;
+  const Param param;
+  const Boundaries2D boundaries;
+
+private:
+  using Kernel = BasicFusedPredictKernel<S, A>;
+  mutable Workspace workspace;
+  Kernel fused;
+
+  inline void prepare(const Field &phi, const Field &ret) const {
+    if (phi.shape() != ret.shape()) {
+      throw std::runtime_error("invalid shape of tensor given");
+    }
+    boundaries.validate(static_cast<int64_t>(phi.shape()[0]), static_cast<int64_t>(phi.shape()[1]),
+                        ghost);
+    workspace.reserve(phi);
+  }
+
+  /* One step, by every thread of the enclosing parallel region */
+  inline void step(Field &phi, Field &ret, typename Kernel::Scratch &s) const {
+    phi.fill(boundaries);
+    const auto ny = static_cast<int64_t>(phi.shape()[0]);
+    const auto nx = static_cast<int64_t>(phi.shape()[1]);
+    const Box2D padded{-ghost, ny + ghost, -ghost, nx + ghost};
+    const int64_t n_ty = (ny + Kernel::tile_y - 1) / Kernel::tile_y;
+    const int64_t n_tx = (nx + Kernel::tile_x - 1) / Kernel::tile_x;
+#pragma omp for collapse(2) schedule(static)
+    for (int64_t ty = 0; ty < n_ty; ++ty) {
+      for (int64_t tx = 0; tx < n_tx; ++tx) {
+        const Box2D out{ty * Kernel::tile_y, std::min(ny, (ty + 1) * Kernel::tile_y),
+                        tx * Kernel::tile_x, std::min(nx, (tx + 1) * Kernel::tile_x)};
+        fused.tile(phi, ret, out, padded, s);
+      }
+    }
+  }
+
+public:
+  /**
+   * @param p parameters
+   * @param b boundary of every side
+   */
+  BasicPaddedPhaseField2D(const Param &p, const Boundaries2D &b)
+      : param(p), boundaries(b), fused(param) {}
+
+  /**
+   * @brief Advance the phase field by one step
+   *  The ghost layers of phi are filled on the way, so phi is not const.
+   *
+   * @param phi current phase field
+   * @param ret next phase field, only its interior is written
+   */
+  inline void predict(Field &phi, Field &ret) const {
+    prepare(phi, ret);
+#pragma omp parallel
+    step(phi, ret, workspace.thread_scratch());
+  }
+
+  /**
+   * @brief Advance the phase field by n_steps steps in one parallel region
+   *
+   * @param state current field and the buffer of the next one
+   * @param n_steps number of steps
+   */
+  inline void advance(State &state, const std::size_t n_steps) const {
+    prepare(state.current(), state.next());
+#pragma omp parallel
+    {
+      auto &s = workspace.thread_scratch();
+      for (std::size_t n = 0; n < n_steps; ++n) {
+        step(state.current(), state.next(), s);
+#pragma omp single
+        state.swap();
+      }
+    }
+  }
+};
+
+using PaddedPhaseField2D = BasicPaddedPhaseField2D<Field2D::scalar_type>;
+} // namespace phase_field
+
+#endif // __PHASE_FIELD__PADDED__
@@ -8,87 +8,281 @@
 
 #include "impl/derivative.hh"
 #include "impl/functor.hh"
+#include "impl/kernel.hh"
 #include "impl/state.hh"
 #include "impl/type.hh"
+#include "impl/workspace.hh"
 #include "param.hh"
 #include <algorithm>
+#include <array>
+#include <type_traits>
 
 namespace phase_field {
 
-class PhaseField2D {
+/**
+ * @brief The two fields of a time integration, stepped by swapping instead of copying
+ *  current() holds the latest step and next() the buffer the following step is written into.
+ *  Both keep their storage for the whole run; output reads current() in place. F is the field
+ *  type, any type with F::like (e.g. BasicPaddedField2D).
+ */
+template <typename S, typename F = BasicField2D<S>> class BasicPingPong2D {
+  std::array<F, 2> fields;
+  std::size_t cur = 0;
+
+public:
+  /**
+   * @param phi initial field, moved into the current buffer
+   */
+  explicit BasicPingPong2D(F &&phi) {
+    fields[1] = F::like(phi);
+    fields[0] = std::move(phi);
+  }
+
+  inline const F &current() const { return fields[cur]; }
+  inline F &current() { return fields[cur]; }
+  inline F &next() { return fields[cur ^ 1]; }
+
+  /**
+   * @brief Make next the current field, after it has been written
+   */
+  inline void swap() { cur ^= 1; }
+};
+
+using PingPong2D = BasicPingPong2D<Field2D::scalar_type>;
+
+/**
+ * @brief Explicit solver of the 2D phase field
+ *  Each instance owns its filters and a workspace, so solvers with different parameters or
+ *  shapes can run side by side. The overloads without a workspace argument use the owned one
+ *  and therefore must not be called on the same instance from several threads at once.
+ *
+ *  phi is stored in S and the right hand side is computed in A, see BasicFusedPredictKernel.
+ *  Use one of the aliases below rather than the template.
+ */
+template <typename S, typename A = S> class BasicPhaseField2D {
 public:
+  using Field = BasicField2D<S>;
+  using Stats = BasicStepStats<A>;
+  using Workspace = BasicPredictWorkspace<S, A>;
   const Param param;
 
 private:
-  InvAbsN4Functor inv_abs_n4_func;
-  N4Functor n4_func;
-  AcFunctor ac_func;
-  AkFunctor ak_func;
-  libtensor::functor::BindLhsWrapper<libtensor::functor::ProdFunctor<Field2D::scalar_type>> w_func;
-  Aniso2Functor aniso2_func;
-  Aniso3Functor aniso3_func;
-  ChemPotFunctor chem_func;
-  FieldClampFunctor clamp_func;
-  libtensor::functor::SumFunctor<Field2D::scalar_type> sum_func;
-  PredictFunctor predict_func;
+  using T = A;
+  const Param units; // param in the units of the right hand side, see compute_param
+  const BasicFilter2D<T> dx_filter;
+  const BasicFilter2D<T> dy_filter;
+  const BasicFilter2D<T> lap_filter;
+  mutable Workspace workspace;
+
+  InvAbsN4Functor<T> inv_abs_n4_func;
+  N4Functor<T> n4_func;
+  AcFunctor<T> ac_func;
+  AkFunctor<T> ak_func;
+  libtensor::functor::BindLhsWrapper<libtensor::functor::ProdFunctor<T>> w_func;
+  Aniso2Functor<T> aniso2_func;
+  Aniso3Functor<T> aniso3_func;
+  ChemPotFunctor<T> chem_func;
+  FieldClampFunctor<T> clamp_func;
+  libtensor::functor::SumFunctor<T> sum_func;
+  PredictFunctor<T> predict_func;
+  BasicFusedPredictKernel<S, A> fused;
 
 public:
-  PhaseField2D(const Param &p)
-      : param(p), ac_func(p.epsilon_c), ak_func(p.epsilon_k), w_func(p.W0), aniso2_func(p.W0),
-        aniso3_func(p.W0, p.epsilon_c), chem_func(param.u, param.lambda), predict_func(param.dt) {}
+  BasicPhaseField2D(const Param &p)
+      : param(p), units(compute_param<T>(p)), dx_filter(get_dx_filter<T>(units.dx)),
+        dy_filter(get_dy_filter<T>(units.dx)), lap_filter(get_laplacian_filter<T>(units.dx)),
+        ac_func(p.epsilon_c), ak_func(p.epsilon_k), w_func(units.W0), aniso2_func(units.W0),
+        aniso3_func(units.W0, p.epsilon_c), chem_func(param.u, param.lambda),
+        predict_func(param.dt), fused(param) {}
+
+  /**
+   * @brief Advance the phase field by one step with the fused single pass kernel
+   *
+   * @param phi current phase field
+   * @param ret next phase field
+   */
+  inline void predict(const Field &phi, Field &ret) const { predict(phi, ret, workspace); }
 
-  inline void predict(const Field2D &phi, Field2D &ret) const {
+  /**
+   * @brief Advance the phase field by one step with the fused single pass kernel
+   *
+   * @param phi current phase field
+   * @param ret next phase field
+   * @param ws workspace owned by the caller
+   */
+  inline void predict(const Field &phi, Field &ret, Workspace &ws) const {
     if (phi.shape() != ret.shape()) {
       throw std::runtime_error("invalid shape of tensor given");
     }
-    static const auto dx_filter = get_dx_filter(param.dx);
-    static const auto dy_filter = get_dy_filter(param.dx);
-    static const auto lap_filter = get_laplacian_filter(param.dx);
-
-    static auto dphi_dx = Field2D::like(phi);
-    static auto dphi_dy = Field2D::like(phi);
-    conv2d(phi, dx_filter, dphi_dx);
-    conv2d(phi, dy_filter, dphi_dy);
-
-    static auto abs_n4_inv = Field2D::like(phi);
-    abs_n4_inv.map(inv_abs_n4_func, dphi_dx, dphi_dy);
-
-    static auto n4 = Field2D::like(phi);
-    n4.map(n4_func, dphi_dx, dphi_dy, abs_n4_inv);
-
-    static auto ac = Field2D::like(phi);
-    static auto ak = Field2D::like(phi);
-    ac.map(ac_func, n4);
-    ak.map(ak_func, n4);
-
-    static auto W = Field2D::like(phi);
-    W.map(w_func, ac);
-
-    static auto tau_inv = Field2D::like(phi);
-    tau_inv.map(TauInvFunctor(param.tau0), ac, ak);
-
-    static auto term1 = Field2D::like(phi);
-    static auto term2_dx = Field2D::like(phi);
-    static auto term2_dy = Field2D::like(phi);
-    static auto term3_dx = Field2D::like(phi);
-    static auto term3_dy = Field2D::like(phi);
-    static auto term4 = Field2D::like(phi);
-
-    static auto cache = Field2D::like(phi);
-
-    conv2d(phi, lap_filter, term1);
-    term1.map([&](Field2D::scalar_type &ret) { ret *= std::pow(param.W0, 2.0); });
-    conv2d(cache.map(aniso2_func, W, dphi_dx), dx_filter, term2_dx);
-    conv2d(cache.map(aniso2_func, W, dphi_dy), dy_filter, term2_dy);
-    conv2d(cache.map(aniso3_func, W, dphi_dx, dphi_dy, abs_n4_inv), dx_filter, term3_dx);
-    conv2d(cache.map(aniso3_func, W, dphi_dy, dphi_dx, abs_n4_inv), dy_filter, term3_dy);
-    term4.map(chem_func, phi);
-    cache.map(sum_func, term1, term2_dx, term2_dy, term3_dx, term3_dy, term4);
-
-    ret.map(predict_func, tau_inv, cache, phi).map(clamp_func);
+    ws.reserve(phi);
+#pragma omp parallel
+    fused.sweep(phi, ret, ws.thread_scratch());
+  }
+
+  /**
+   * @brief Advance the phase field by n_steps steps
+   *  Same result as n_steps calls to predict, swapping the buffers of state in between. All steps
+   *  run in a single OpenMP parallel region, with a barrier between two steps.
+   *
+   * @param state current field and the buffer of the next one
+   * @param n_steps number of steps
+   */
+  inline void advance(BasicPingPong2D<S> &state, const std::size_t n_steps) const {
+    advance(state, n_steps, workspace);
+  }
+
+  /**
+   * @brief Advance the phase field by n_steps steps
+   *
+   * @param state current field and the buffer of the next one
+   * @param n_steps number of steps
+   * @param ws workspace owned by the caller
+   */
+  inline void advance(BasicPingPong2D<S> &state, const std::size_t n_steps, Workspace &ws) const {
+    if (state.current().shape() != state.next().shape()) {
+      throw std::runtime_error("invalid shape of tensor given");
+    }
+    ws.reserve(state.current());
+#pragma omp parallel
+    {
+      auto &scratch = ws.thread_scratch();
+      for (std::size_t step = 0; step < n_steps; ++step) {
+        /* The implicit barrier of the sweep lets the swap see every row of the step */
+        fused.sweep(state.current(), state.next(), scratch);
+#pragma omp single
+        state.swap();
+      }
+    }
+  }
+
+  /**
+   * @brief Advance the phase field by dt and estimate the stability limit
+   *  Same as predict except that the time step is given at call time instead of param.dt.
+   *
+   * @param phi current phase field
+   * @param ret next phase field
+   * @param dt time step
+   * @return stability rate of phi and largest change of the step
+   */
+  inline Stats predict(const Field &phi, Field &ret, const T dt) const {
+    return predict(phi, ret, dt, workspace);
+  }
+
+  /**
+   * @brief Advance the phase field by dt and estimate the stability limit
+   *
+   * @param phi current phase field
+   * @param ret next phase field
+   * @param dt time step
+   * @param ws workspace owned by the caller
+   * @return stability rate of phi and largest change of the step
+   */
+  inline Stats predict(const Field &phi, Field &ret, const T dt, Workspace &ws) const {
+    if (phi.shape() != ret.shape()) {
+      throw std::runtime_error("invalid shape of tensor given");
+    }
+    ws.reserve(phi);
+    Stats stats;
+#pragma omp parallel
+    {
+      Stats local;
+      fused.sweep(phi, ret, dt, ws.thread_scratch(), local);
+#pragma omp critical
+      stats.merge(local);
+    }
+    return stats;
+  }
+
+  /**
+   * @brief Advance the phase field by one step term by term
+   *  Kept as the reference implementation of predict.
+   *
+   * @param phi current phase field
+   * @param ret next phase field
+   */
+  inline void predict_reference(const Field &phi, Field &ret) const {
+    predict_reference(phi, ret, workspace);
+  }
+
+  /**
+   * @brief Advance the phase field by one step term by term
+   *  Every term is computed in A; when S differs, phi is first copied into the workspace.
+   *
+   * @param field current phase field
+   * @param ret next phase field
+   * @param ws workspace owned by the caller
+   */
+  inline void predict_reference(const Field &field, Field &ret, Workspace &ws) const {
+    if (field.shape() != ret.shape()) {
+      throw std::runtime_error("invalid shape of tensor given");
+    }
+    ws.reserve_reference(field);
+    const auto &phi = ws.promote(field);
+    /* Bytes of one field, for the traffic of the stages: every array read or written */
+    [[maybe_unused]] const uint64_t n = phi.shape()[0] * phi.shape()[1] * sizeof(T);
+
+    {
+      PHASE_FIELD_PROFILE_SCOPE(gradient, 4 * n);
+      conv2d(phi, dx_filter, ws.dphi_dx);
+      conv2d(phi, dy_filter, ws.dphi_dy);
+    }
+
+    {
+      PHASE_FIELD_PROFILE_SCOPE(anisotropy, 16 * n);
+      ws.abs_n4_inv.map(inv_abs_n4_func, ws.dphi_dx, ws.dphi_dy);
+      ws.n4.map(n4_func, ws.dphi_dx, ws.dphi_dy, ws.abs_n4_inv);
+
+      ws.ac.map(ac_func, ws.n4);
+      ws.ak.map(ak_func, ws.n4);
+
+      ws.W.map(w_func, ws.ac);
+      ws.tau_inv.map(TauInvFunctor<T>(param.tau0), ws.ac, ws.ak);
+    }
+
+    {
+      PHASE_FIELD_PROFILE_SCOPE(divergence, 4 * n);
+      conv2d(phi, lap_filter, ws.term1);
+      const auto W0_sq = static_cast<T>(std::pow(units.W0, 2.0));
+      ws.term1.map([W0_sq](T &ret) { ret *= W0_sq; });
+    }
+    /* Each anisotropic flux is mapped into the cache, then differentiated */
+    const auto flux = [&](const auto &map, [[maybe_unused]] const uint64_t arrays,
+                          const BasicFilter2D<T> &filter, BasicField2D<T> &term) {
+      {
+        PHASE_FIELD_PROFILE_SCOPE(anisotropy, arrays * n);
+        map();
+      }
+      PHASE_FIELD_PROFILE_SCOPE(divergence, 2 * n);
+      conv2d(ws.cache, filter, term);
+    };
+    flux([&] { ws.cache.map(aniso2_func, ws.W, ws.dphi_dx); }, 3, dx_filter, ws.term2_dx);
+    flux([&] { ws.cache.map(aniso2_func, ws.W, ws.dphi_dy); }, 3, dy_filter, ws.term2_dy);
+    flux([&] { ws.cache.map(aniso3_func, ws.W, ws.dphi_dx, ws.dphi_dy, ws.abs_n4_inv); }, 5,
+         dx_filter, ws.term3_dx);
+    flux([&] { ws.cache.map(aniso3_func, ws.W, ws.dphi_dy, ws.dphi_dx, ws.abs_n4_inv); }, 5,
+         dy_filter, ws.term3_dy);
+
+    PHASE_FIELD_PROFILE_SCOPE(update, 15 * n);
+    ws.term4.map(chem_func, phi);
+    ws.cache.map(sum_func, ws.term1, ws.term2_dx, ws.term2_dy, ws.term3_dx, ws.term3_dy,
+                 ws.term4);
+
+    if constexpr (std::is_same_v<S, A>) {
+      ret.map(predict_func, ws.tau_inv, ws.cache, phi).map(clamp_func);
+    } else {
+      ws.term4.map(predict_func, ws.tau_inv, ws.cache, phi).map(clamp_func);
+      convert(ws.term4, ret);
+    }
     return;
   }
 };
+
+/* double throughout, the reference precision */
+using PhaseField2D = BasicPhaseField2D<double>;
+/* float throughout: half the memory traffic and twice the SIMD width of double */
+using FloatPhaseField2D = BasicPhaseField2D<float>;
+/* phi stored in float, the right hand side and the step computed in double */
+using MixedPhaseField2D = BasicPhaseField2D<float, double>;
 } // namespace phase_field
 
 #endif
\ No newline at end of file
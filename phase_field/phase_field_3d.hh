@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2025 Materials Modelling Lab, The University of Tokyo
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __PHASE_FIELD__PHASE_FIELD_3D__
+#define __PHASE_FIELD__PHASE_FIELD_3D__
+
+#include "impl/kernel_3d.hh"
+#include "impl/type.hh"
+#include "param.hh"
+#include <omp.h>
+#include <vector>
+
+namespace phase_field {
+/**
+ * @brief Scratch memory of PhaseField3D::predict
+ *  Must not be shared by solvers running at the same time.
+ */
+class PredictWorkspace3D {
+  std::vector<FusedPredictKernel3D::Scratch> scratch;
+
+public:
+  /**
+   * @brief Prepare the per-thread scratch, must be called outside of the parallel region
+   */
+  inline void reserve() {
+    const auto n_threads = static_cast<std::size_t>(omp_get_max_threads());
+    if (scratch.size() < n_threads) {
+      scratch.resize(n_threads);
+    }
+    for (auto &s : scratch) {
+      s.reserve();
+    }
+  }
+
+  inline FusedPredictKernel3D::Scratch &thread_scratch() {
+    return scratch[static_cast<std::size_t>(omp_get_thread_num())];
+  }
+};
+
+/**
+ * @brief Explicit solver of the 3D phase field with cubic anisotropy
+ */
+class PhaseField3D {
+public:
+  const Param param;
+
+private:
+  FusedPredictKernel3D fused;
+  mutable PredictWorkspace3D workspace;
+
+public:
+  PhaseField3D(const Param &p) : param(p), fused(param) {}
+
+  /**
+   * @brief Advance the phase field by one step
+   *
+   * @param phi current phase field
+   * @param ret next phase field
+   */
+  inline void predict(const Field3D &phi, Field3D &ret) const { predict(phi, ret, workspace); }
+
+  /**
+   * @brief Advance the phase field by one step
+   *
+   * @param phi current phase field
+   * @param ret next phase field
+   * @param ws workspace owned by the caller
+   */
+  inline void predict(const Field3D &phi, Field3D &ret, PredictWorkspace3D &ws) const {
+    if (phi.shape() != ret.shape()) {
+      throw std::runtime_error("invalid shape of tensor given");
+    }
+    ws.reserve();
+#pragma omp parallel
+    fused.sweep(phi, ret, ws.thread_scratch());
+  }
+};
+} // namespace phase_field
+
+#endif // __PHASE_FIELD__PHASE_FIELD_3D__
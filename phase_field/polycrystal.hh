@@ -0,0 +1,610 @@
+/*
+ * Copyright (c) 2025 Materials Modelling Lab, The University of Tokyo
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __PHASE_FIELD__POLYCRYSTAL__
+#define __PHASE_FIELD__POLYCRYSTAL__
+
+#include "impl/functor.hh"
+#include "impl/state.hh"
+#include "impl/type.hh"
+#include "param.hh"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <nlohmann/json.hpp>
+#include <omp.h>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace phase_field {
+/**
+ * @brief Parameters of the polycrystal on top of Param
+ */
+struct PolycrystalParam {
+  Field2D::scalar_type coupling = 50.0;  // gamma of the grain boundary energy, see below
+  Field2D::scalar_type threshold = 1e-4; // phi <= liquid + threshold counts as no grain
+
+  NLOHMANN_DEFINE_TYPE_INTRUSIVE(PolycrystalParam, coupling, threshold);
+};
+
+/**
+ * @brief Phase fields of many grains, holding only the grains active in each cell
+ *  Every cell has K slots of (grain, phi). A grain not listed in a cell has phi = liquid there.
+ *  Slots are filled from the first one, empty slots hold none. Memory is K slots per cell
+ *  whatever the number of grains.
+ *
+ *  A grain is listed in every cell within two cells (|dy| + |dx| <= 2, the reach of the stencil)
+ *  of a cell where it is present, so the cells a step can change are all listed.
+ */
+template <std::size_t K> class BasicGrainField2D {
+public:
+  using T = Field2D::scalar_type;
+  static constexpr std::size_t slots = K;
+  static constexpr int32_t none = -1;
+
+private:
+  int64_t ny = 0, nx = 0;
+  std::vector<int32_t> id_buf;
+  std::vector<T> value_buf;
+
+  inline std::size_t offset(const int64_t y, const int64_t x) const {
+    return static_cast<std::size_t>(y * nx + x) * K;
+  }
+
+public:
+  BasicGrainField2D() = default;
+
+  /**
+   * @brief ny x nx cells of liquid
+   */
+  BasicGrainField2D(const int64_t n_y, const int64_t n_x)
+      : ny(n_y), nx(n_x), id_buf(static_cast<std::size_t>(n_y * n_x) * K, none),
+        value_buf(static_cast<std::size_t>(n_y * n_x) * K, FieldState::liquid) {
+    if (n_y < 2 || n_x < 2) {
+      throw std::invalid_argument("grain field must be at least 2 x 2");
+    }
+  }
+
+  inline std::array<std::size_t, 2> shape() const {
+    return {static_cast<std::size_t>(ny), static_cast<std::size_t>(nx)};
+  }
+
+  inline int32_t *ids(const int64_t y, const int64_t x) { return id_buf.data() + offset(y, x); }
+  inline const int32_t *ids(const int64_t y, const int64_t x) const {
+    return id_buf.data() + offset(y, x);
+  }
+  inline T *values(const int64_t y, const int64_t x) { return value_buf.data() + offset(y, x); }
+  inline const T *values(const int64_t y, const int64_t x) const {
+    return value_buf.data() + offset(y, x);
+  }
+
+  /**
+   * @brief phi of grain g in the cell, liquid if not listed
+   */
+  inline T get(const int64_t y, const int64_t x, const int32_t g) const {
+    const int32_t *id = ids(y, x);
+    for (std::size_t k = 0; k < K && id[k] != none; ++k) {
+      if (id[k] == g) {
+        return values(y, x)[k];
+      }
+    }
+    return FieldState::liquid;
+  }
+
+  /**
+   * @brief Set phi of grain g in the cell, listing it if needed; false when the cell is full
+   */
+  inline bool set(const int64_t y, const int64_t x, const int32_t g, const T v) {
+    int32_t *id = ids(y, x);
+    for (std::size_t k = 0; k < K; ++k) {
+      if (id[k] == g || id[k] == none) {
+        id[k] = g;
+        values(y, x)[k] = v;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * @brief Place a circular nucleus of grain g, listing it in the cells around it
+   *  Other grains in the nucleus are kept; the grain boundary energy pushes them apart.
+   */
+  inline void set_nuclear(const int64_t yc, const int64_t xc, const int64_t r, const int32_t g) {
+    if (yc < 0 || xc < 0 || yc >= ny || xc >= nx) {
+      throw std::invalid_argument("centre out of the field");
+    }
+    if (g < 0) {
+      throw std::invalid_argument("grain must not be negative");
+    }
+    /* Cells within r + 2 cover the two cells around every cell of the nucleus */
+    const int64_t reach = r + 2;
+    for (int64_t y = std::max<int64_t>(0, yc - reach); y < std::min(ny, yc + reach + 1); ++y) {
+      for (int64_t x = std::max<int64_t>(0, xc - reach); x < std::min(nx, xc + reach + 1); ++x) {
+        const int64_t d_sq = (y - yc) * (y - yc) + (x - xc) * (x - xc);
+        bool ok = true;
+        if (d_sq <= r * r) {
+          ok = set(y, x, g, FieldState::solid);
+        } else if (d_sq <= reach * reach) {
+          ok = set(y, x, g, get(y, x, g));
+        }
+        if (!ok) {
+          throw std::runtime_error("too many grains in a cell for the slots");
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief Largest phi over the grains of every cell, the single field of PhaseField2D
+   */
+  inline void to_field(Field2D &phi) const {
+    if (static_cast<int64_t>(phi.shape()[0]) != ny || static_cast<int64_t>(phi.shape()[1]) != nx) {
+      throw std::runtime_error("invalid shape of tensor given");
+    }
+#pragma omp parallel for schedule(static)
+    for (int64_t y = 0; y < ny; ++y) {
+      auto &&row = phi[y];
+      for (int64_t x = 0; x < nx; ++x) {
+        T v = FieldState::liquid;
+        for (std::size_t k = 0; k < K; ++k) {
+          v = std::max(v, values(y, x)[k]);
+        }
+        row[x] = v;
+      }
+    }
+  }
+
+  /**
+   * @brief Grain of the largest phi in the cell if it is solid (phi > 0), none otherwise
+   */
+  inline int32_t grain(const int64_t y, const int64_t x) const {
+    int32_t ret = none;
+    T best = 0.0;
+    for (std::size_t k = 0; k < K && ids(y, x)[k] != none; ++k) {
+      if (values(y, x)[k] > best) {
+        best = values(y, x)[k];
+        ret = ids(y, x)[k];
+      }
+    }
+    return ret;
+  }
+
+  /**
+   * @brief Mean number of grains listed per cell
+   */
+  inline double occupancy() const {
+    std::size_t n = 0;
+    for (const auto id : id_buf) {
+      n += id != none;
+    }
+    return static_cast<double>(n) / static_cast<double>(ny * nx);
+  }
+
+  inline std::size_t bytes() const {
+    return id_buf.size() * sizeof(int32_t) + value_buf.size() * sizeof(T);
+  }
+
+  inline void swap(BasicGrainField2D &o) {
+    std::swap(ny, o.ny);
+    std::swap(nx, o.nx);
+    id_buf.swap(o.id_buf);
+    value_buf.swap(o.value_buf);
+  }
+};
+
+/**
+ * @brief Explicit solver of many grains of arbitrary orientation on a BasicGrainField2D
+ *  Every grain i has its own phase field phi_i, liquid where the grain is absent, and follows
+ *  the equation of PhaseField2D with the anisotropy rotated by its orientation theta_i: the
+ *  gradient is turned into the frame of the crystal, the anisotropic flux computed there and
+ *  turned back. Grains repel each other through the energy gamma sum_{i<j} p_i^2 p_j^2 with
+ *  p = (1 + phi) / 2, which adds -gamma p_i sum_{j != i} p_j^2 to the right hand side of grain i
+ *  and forms the grain boundaries.
+ *
+ *  A step only visits the K slots of a cell. Grains present in a cell (phi > liquid +
+ *  threshold) are listed again within two cells of it after the step, a grain falling below
+ *  the threshold everywhere around a cell is dropped there. Boundaries are mirror (zero flux),
+ *  and with one grain of orientation 0 the result matches PaddedPhaseField2D with mirror
+ *  boundaries up to the threshold.
+ *
+ *  Cost and memory per cell depend on K, not on the number of grains; only the table of
+ *  orientations grows with it.
+ */
+template <std::size_t K> class BasicPolycrystalPhaseField2D {
+public:
+  using T = Field2D::scalar_type;
+  using Grains = BasicGrainField2D<K>;
+  static constexpr int32_t none = Grains::none;
+  const Param param;
+  const PolycrystalParam poly;
+
+private:
+  std::vector<T> cos_t, sin_t;
+  const T W0, W0_sq, inv_2dx, inv_dx_sq, tau0, dt, gamma, floor;
+  AcFunctor<T> ac_func;
+  AkFunctor<T> ak_func;
+  Aniso3Functor<T> aniso3_func;
+  ChemPotFunctor<T> chem_func;
+  FieldClampFunctor<T> clamp_func;
+
+  /* Per step buffers: fluxes over the cells and one ghost ring, phi after the step and the
+     grains within one cell of a present one, all in the slots of the current field, and per
+     cell whether a grain appeared or vanished there and within one cell of it */
+  mutable std::vector<T> flux; // fx, fy, tau_inv per slot
+  mutable std::vector<T> next;
+  mutable std::vector<int32_t> near_ids;
+  mutable std::vector<T> near_values;
+  mutable std::vector<uint8_t> changed, touched;
+  mutable Grains spare;
+  mutable std::size_t overflow = 0;
+
+  static inline int64_t reflect(const int64_t i, const int64_t n) {
+    return i < 0 ? -i - 1 : (i >= n ? 2 * n - 1 - i : i);
+  }
+
+  static inline int find(const int32_t *id, const int32_t g) {
+    for (std::size_t k = 0; k < K && id[k] != none; ++k) {
+      if (id[k] == g) {
+        return static_cast<int>(k);
+      }
+    }
+    return -1;
+  }
+
+  /* Slot of grain g in the cell at id, trying slot k first: neighbours mostly list a grain in
+     the same slot */
+  static inline int find(const int32_t *id, const int32_t g, const std::size_t k) {
+    return id[k] == g ? static_cast<int>(k) : find(id, g);
+  }
+
+  /* Offsets of the slots of a row and a column, mirrored outside the field */
+  static inline std::size_t row_at(const int64_t y, const int64_t ny, const int64_t nx) {
+    return static_cast<std::size_t>(reflect(y, ny) * nx) * K;
+  }
+  static inline std::size_t column_at(const int64_t x, const int64_t nx) {
+    return static_cast<std::size_t>(reflect(x, nx)) * K;
+  }
+
+  inline void reserve(const Grains &f) const {
+    const auto ny = static_cast<std::size_t>(f.shape()[0]);
+    const auto nx = static_cast<std::size_t>(f.shape()[1]);
+    if (spare.shape() != f.shape()) {
+      flux.assign((ny + 2) * (nx + 2) * K * 3, T(0));
+      next.assign(ny * nx * K, T(0));
+      near_ids.assign(ny * nx * K, none);
+      near_values.assign(ny * nx * K, T(0));
+      changed.assign(ny * nx, 0);
+      touched.assign(ny * nx, 0);
+      spare = Grains(static_cast<int64_t>(ny), static_cast<int64_t>(nx));
+    }
+  }
+
+  /* Flux and 1 / tau of every listed grain, over the cells and one ghost ring */
+  inline void flux_pass(const Grains &f) const {
+    const auto ny = static_cast<int64_t>(f.shape()[0]);
+    const auto nx = static_cast<int64_t>(f.shape()[1]);
+    const int32_t *ids = f.ids(0, 0);
+    const T *values = f.values(0, 0);
+    const auto value = [&](const std::size_t o, const int32_t g, const std::size_t k) {
+      const int i = find(ids + o, g, k);
+      return i < 0 ? T(FieldState::liquid) : values[o + static_cast<std::size_t>(i)];
+    };
+#pragma omp for schedule(static)
+    for (int64_t yy = -1; yy <= ny; ++yy) {
+      const auto r0 = row_at(yy, ny, nx), rm = row_at(yy - 1, ny, nx), rp = row_at(yy + 1, ny, nx);
+      T *out = flux.data() + static_cast<std::size_t>((yy + 1) * (nx + 2)) * K * 3;
+      for (int64_t xx = -1; xx <= nx; ++xx, out += K * 3) {
+        const auto c0 = column_at(xx, nx), cm = column_at(xx - 1, nx), cp = column_at(xx + 1, nx);
+        const int32_t *id = ids + r0 + c0;
+        for (std::size_t k = 0; k < K; ++k) {
+          const int32_t g = id[k];
+          if (g == none) {
+            break;
+          }
+          const T gx = (value(r0 + cp, g, k) - value(r0 + cm, g, k)) * inv_2dx;
+          const T gy = (value(rp + c0, g, k) - value(rm + c0, g, k)) * inv_2dx;
+          const T c = cos_t[static_cast<std::size_t>(g)];
+          const T s = sin_t[static_cast<std::size_t>(g)];
+          const T rx = c * gx + s * gy;
+          const T ry = -s * gx + c * gy;
+          const T abs_sq = gx * gx + gy * gy;
+          const T abs_n4_inv = abs_sq == T(0) ? T(0) : T(1) / (abs_sq * abs_sq);
+          const T n4 = (rx * rx * rx * rx + ry * ry * ry * ry) * abs_n4_inv;
+          T ac, ak, ax, ay;
+          ac_func(ac, n4);
+          ak_func(ak, n4);
+          const T W = W0 * ac;
+          aniso3_func(ax, W, rx, ry, abs_n4_inv);
+          aniso3_func(ay, W, ry, rx, abs_n4_inv);
+          const T w2 = W * W - W0_sq;
+          out[3 * k + 0] = w2 * gx + c * ax - s * ay;
+          out[3 * k + 1] = w2 * gy + s * ax + c * ay;
+          out[3 * k + 2] = T(1) / (tau0 * ac * ak);
+        }
+      }
+    }
+  }
+
+  /* phi of every listed grain after the step, into next; all cells count as changed if full */
+  inline void update_pass(const Grains &f, const bool full) const {
+    const auto ny = static_cast<int64_t>(f.shape()[0]);
+    const auto nx = static_cast<int64_t>(f.shape()[1]);
+    const auto fx = static_cast<std::size_t>(nx + 2) * K * 3; // a row of flux
+    const int32_t *ids = f.ids(0, 0);
+    const T *values = f.values(0, 0);
+    const T *in_flux = flux.data();
+    T *out_next = next.data();
+    uint8_t *out_changed = changed.data();
+    /* phi and the flux component q of grain g in the cell of slots o and flux f_o */
+    const auto value = [&](const std::size_t o, const int32_t g, const std::size_t k) {
+      const int i = find(ids + o, g, k);
+      return i < 0 ? T(FieldState::liquid) : values[o + static_cast<std::size_t>(i)];
+    };
+    const auto flux_at = [&](const std::size_t o, const std::size_t f_o, const int32_t g,
+                             const std::size_t k, const std::size_t q) {
+      const int i = find(ids + o, g, k);
+      return i < 0 ? T(0) : in_flux[f_o + 3 * static_cast<std::size_t>(i) + q];
+    };
+#pragma omp for schedule(static)
+    for (int64_t y = 0; y < ny; ++y) {
+      const auto r0 = row_at(y, ny, nx), rm = row_at(y - 1, ny, nx), rp = row_at(y + 1, ny, nx);
+      const auto f0 = static_cast<std::size_t>(y + 1) * fx;
+      for (int64_t x = 0; x < nx; ++x) {
+        const auto c0 = column_at(x, nx), cm = column_at(x - 1, nx), cp = column_at(x + 1, nx);
+        const int32_t *id = ids + r0 + c0;
+        uint8_t &change = out_changed[static_cast<std::size_t>(y * nx + x)];
+        change = full;
+        if (id[0] == none) {
+          continue; // nothing listed, rebuild_pass reads no value here
+        }
+        const T *v = values + r0 + c0;
+        T *out = out_next + r0 + c0;
+        const auto fc = f0 + static_cast<std::size_t>(x + 1) * K * 3; // flux of the cell
+        T p_sq_sum = 0.0;
+        for (std::size_t k = 0; k < K && id[k] != none; ++k) {
+          const T p = T(0.5) * (T(1) + v[k]);
+          p_sq_sum += p * p;
+        }
+        for (std::size_t k = 0; k < K; ++k) {
+          const int32_t g = id[k];
+          if (g == none) {
+            break;
+          }
+          const T phi = v[k];
+          const T lap = (value(rm + c0, g, k) + value(rp + c0, g, k) + value(r0 + cm, g, k) +
+                         value(r0 + cp, g, k) - T(4) * phi) *
+                        inv_dx_sq;
+          const T div = (flux_at(r0 + cp, fc + K * 3, g, k, 0) -
+                         flux_at(r0 + cm, fc - K * 3, g, k, 0) +
+                         flux_at(rp + c0, fc + fx, g, k, 1) - flux_at(rm + c0, fc - fx, g, k, 1)) *
+                        inv_2dx;
+          T term4;
+          chem_func(term4, phi);
+          const T p = T(0.5) * (T(1) + phi);
+          const T repel = -gamma * p * (p_sq_sum - p * p);
+          T ret = phi + dt * in_flux[fc + 3 * k + 2] * (W0_sq * lap + div + term4 + repel);
+          clamp_func(ret);
+          out[k] = ret;
+          change |= (phi > floor) != (ret > floor);
+        }
+      }
+    }
+  }
+
+  /*
+   * Write the candidates of a cell into its K slots; returns whether some did not fit. Only
+   * then are they ranked, the largest own value first and then the largest value nearby, by
+   * insertion sort as n is small.
+   */
+  struct Candidate {
+    int32_t id;
+    T own, near;
+  };
+  static inline bool before(const Candidate &a, const Candidate &b) {
+    return a.own != b.own ? a.own > b.own : (a.near != b.near ? a.near > b.near : a.id < b.id);
+  }
+  static inline bool keep(Candidate *c, const std::size_t n, int32_t *id, T *value, T *near) {
+    for (std::size_t i = 1; n > K && i < n; ++i) {
+      const Candidate t = c[i];
+      std::size_t j = i;
+      for (; j > 0 && before(t, c[j - 1]); --j) {
+        c[j] = c[j - 1];
+      }
+      c[j] = t;
+    }
+    for (std::size_t k = 0; k < K; ++k) {
+      id[k] = k < n ? c[k].id : none;
+      if (value) {
+        value[k] = k < n ? c[k].own : FieldState::liquid;
+      }
+      if (near) {
+        near[k] = k < n ? c[k].near : FieldState::liquid;
+      }
+    }
+    return n > K;
+  }
+
+  /* Add grain g seen nearby with value v, or raise the nearby value of a known one */
+  static inline void add(Candidate *c, std::size_t &n, const int32_t g, const T own, const T v) {
+    for (std::size_t i = 0; i < n; ++i) {
+      if (c[i].id == g) {
+        c[i].near = std::max(c[i].near, v);
+        return;
+      }
+    }
+    c[n++] = {g, own, v};
+  }
+
+  /*
+   * Dilate the present grains by one cell twice: near_ids lists the grains present within one
+   * cell, the new field those within two, with phi after the step. Only cells within two of a
+   * change are redone, the rest keep their grains and take the new phi; the grains nearby of a
+   * cell not touched keep what they were, only their values for ranking grow stale. Cells with
+   * nothing listed around them, most of the liquid, are only marked empty; as none is -1 and
+   * ids are not negative, the AND of the first ids of the five cells is none exactly then.
+   */
+  inline void rebuild_pass(const Grains &f, Grains &out) const {
+    const auto ny = static_cast<int64_t>(f.shape()[0]);
+    const auto nx = static_cast<int64_t>(f.shape()[1]);
+    const auto row = static_cast<std::size_t>(nx) * K;
+    const int32_t *in_ids = f.ids(0, 0);
+    const T *in_next = next.data();
+    int32_t *n_ids = near_ids.data();
+    T *n_values = near_values.data();
+    const uint8_t *in_changed = changed.data();
+    uint8_t *n_touched = touched.data();
+    const auto own_value = [&](const std::size_t o, const int32_t g) {
+      const int k = find(in_ids + o, g);
+      return k < 0 ? T(FieldState::liquid) : in_next[o + static_cast<std::size_t>(k)];
+    };
+    /* Offsets of the cell and its four neighbours, mirrored at the edges */
+    const auto around = [&](const int64_t y, const int64_t x, std::size_t *p) {
+      const auto o = static_cast<std::size_t>(y) * row;
+      const auto c = static_cast<std::size_t>(x) * K;
+      p[0] = o + c;
+      p[1] = static_cast<std::size_t>(reflect(y - 1, ny)) * row + c;
+      p[2] = static_cast<std::size_t>(reflect(y + 1, ny)) * row + c;
+      p[3] = o + (x == 0 ? c : c - K);
+      p[4] = o + (x == nx - 1 ? c : c + K);
+    };
+    const auto any = [&](const uint8_t *flag, const std::size_t *p) {
+      return (flag[p[0] / K] | flag[p[1] / K] | flag[p[2] / K] | flag[p[3] / K] |
+              flag[p[4] / K]) != 0;
+    };
+    std::size_t lost = 0;
+#pragma omp for schedule(static)
+    for (int64_t y = 0; y < ny; ++y) {
+      for (int64_t x = 0; x < nx; ++x) {
+        std::size_t p[5];
+        around(y, x, p);
+        if ((in_ids[p[0]] & in_ids[p[1]] & in_ids[p[2]] & in_ids[p[3]] & in_ids[p[4]]) == none) {
+          n_touched[p[0] / K] = 0;
+          n_ids[p[0]] = none;
+          continue;
+        }
+        n_touched[p[0] / K] = any(in_changed, p);
+        if (!n_touched[p[0] / K]) {
+          continue;
+        }
+        Candidate c[5 * K];
+        std::size_t n = 0;
+        for (int d = 0; d < 5; ++d) {
+          const int32_t *id = in_ids + p[d];
+          const T *v = in_next + p[d];
+          for (std::size_t k = 0; k < K && id[k] != none; ++k) {
+            if (v[k] > floor) {
+              add(c, n, id[k], d == 0 ? v[k] : T(FieldState::liquid), v[k]);
+            }
+          }
+        }
+        for (std::size_t i = 0; n > K && i < n; ++i) {
+          c[i].own = own_value(p[0], c[i].id); // only ranking needs the own value
+        }
+        lost += keep(c, n, n_ids + p[0], nullptr, n_values + p[0]) ? 1 : 0;
+      }
+    }
+#pragma omp for schedule(static)
+    for (int64_t y = 0; y < ny; ++y) {
+      for (int64_t x = 0; x < nx; ++x) {
+        std::size_t p[5];
+        around(y, x, p);
+        if ((n_ids[p[0]] & n_ids[p[1]] & n_ids[p[2]] & n_ids[p[3]] & n_ids[p[4]]) == none) {
+          if (out.ids(y, x)[0] != none) {
+            keep(nullptr, 0, out.ids(y, x), out.values(y, x), nullptr);
+          }
+          continue;
+        }
+        if (!any(n_touched, p)) {
+          int32_t *id = out.ids(y, x);
+          T *v = out.values(y, x);
+          for (std::size_t k = 0; k < K; ++k) {
+            id[k] = in_ids[p[0] + k];
+            v[k] = id[k] == none ? T(FieldState::liquid) : in_next[p[0] + k];
+          }
+          continue;
+        }
+        Candidate c[5 * K];
+        std::size_t n = 0;
+        for (int d = 0; d < 5; ++d) {
+          for (std::size_t k = 0; k < K && n_ids[p[d] + k] != none; ++k) {
+            const int32_t g = n_ids[p[d] + k];
+            add(c, n, g, own_value(p[0], g), n_values[p[d] + k]);
+          }
+        }
+        lost += keep(c, n, out.ids(y, x), out.values(y, x), nullptr) ? 1 : 0;
+      }
+    }
+#pragma omp atomic
+    overflow += lost;
+  }
+
+public:
+  /**
+   * @param p parameters
+   * @param orientations angle of the crystal axes of every grain [rad], indexed by grain
+   * @param q coupling and threshold of the grains
+   */
+  BasicPolycrystalPhaseField2D(const Param &p, const std::vector<double> &orientations,
+                               const PolycrystalParam &q = {})
+      : param(p), poly(q), W0(p.W0), W0_sq(p.W0 * p.W0), inv_2dx(1.0 / (2.0 * p.dx)),
+        inv_dx_sq(1.0 / (p.dx * p.dx)), tau0(p.tau0), dt(p.dt), gamma(q.coupling),
+        floor(FieldState::liquid + q.threshold), ac_func(p.epsilon_c), ak_func(p.epsilon_k),
+        aniso3_func(p.W0, p.epsilon_c), chem_func(p.u, p.lambda) {
+    if (!(q.coupling >= 0.0) || !(q.threshold > 0.0 && q.threshold < 1.0)) {
+      throw std::invalid_argument("invalid polycrystal parameters");
+    }
+    for (const auto theta : orientations) {
+      cos_t.push_back(std::cos(theta));
+      sin_t.push_back(std::sin(theta));
+    }
+  }
+
+  inline std::size_t grains() const { return cos_t.size(); }
+
+  /**
+   * @brief Advance all grains by n_steps steps in one parallel region
+   *  Every grain listed in state must have an orientation.
+   *
+   * @param state grains, replaced by the grains after the steps
+   * @param n_steps number of steps
+   */
+  inline void advance(Grains &state, const std::size_t n_steps) const {
+    reserve(state);
+    overflow = 0;
+#pragma omp parallel
+    for (std::size_t n = 0; n < n_steps; ++n) {
+      flux_pass(state);
+      update_pass(state, n == 0);
+      rebuild_pass(state, spare);
+#pragma omp barrier
+#pragma omp single
+      state.swap(spare);
+    }
+  }
+
+  /**
+   * @brief Times in the last advance a cell was relisted with more grains near than K slots
+   *  Each of the two dilations of a step counts; the grains with the smallest phi were dropped.
+   */
+  inline std::size_t overflowed() const { return overflow; }
+
+  /**
+   * @brief Bytes of the per step buffers, on top of the grains themselves
+   */
+  inline std::size_t bytes() const {
+    return flux.size() * sizeof(T) + next.size() * sizeof(T) + near_ids.size() * sizeof(int32_t) +
+           near_values.size() * sizeof(T) + changed.size() + touched.size() + spare.bytes();
+  }
+};
+
+using GrainField2D = BasicGrainField2D<4>;
+using PolycrystalPhaseField2D = BasicPolycrystalPhaseField2D<4>;
+} // namespace phase_field
+
+#endif // __PHASE_FIELD__POLYCRYSTAL__
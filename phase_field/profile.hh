@@ -0,0 +1,339 @@
+/*
+ * Copyright (c) 2025 Materials Modelling Lab, The University of Tokyo
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __PHASE_FIELD__PROFILE__
+#define __PHASE_FIELD__PROFILE__
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+#include <string>
+
+#if defined(PHASE_FIELD_PROFILE) && defined(__linux__)
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Opt-in instrumentation of the stages of predict
+ *  Built with PHASE_FIELD_PROFILE defined (CMake option ENABLE_PROFILE), every
+ *  PHASE_FIELD_PROFILE_SCOPE accumulates its wall time, the bytes its arrays move and, once
+ *  enable_counters() succeeded, the cycles and last level cache misses of the thread. Without
+ *  the macro the scopes expand to nothing, so the instrumented kernels compile to the same code.
+ *
+ *  Each thread accumulates into a slot of its own; report() sums the slots and must not run
+ *  concurrently with instrumented code. The fused kernel is timed per row and per thread, so its
+ *  seconds are thread seconds; the term by term path is timed on the calling thread around
+ *  parallel loops, so its seconds are wall time.
+ */
+namespace phase_field::profile {
+#ifdef PHASE_FIELD_PROFILE
+inline constexpr bool enabled = true;
+#else
+inline constexpr bool enabled = false;
+#endif
+
+enum class Stage {
+  load = 0,   // rows of phi into the tile
+  gradient,   // first derivatives of phi
+  anisotropy, // 1 / tau and the anisotropic fluxes
+  divergence, // laplacian and the divergence of the fluxes
+  update,     // chemical potential, sum of the terms and the explicit step
+  count,
+};
+
+inline const char *name(const Stage s) {
+  static const char *names[] = {"load", "gradient", "anisotropy", "divergence", "update"};
+  return names[static_cast<int>(s)];
+}
+
+inline constexpr std::size_t n_stages = static_cast<std::size_t>(Stage::count);
+
+/**
+ * @brief Totals of one stage
+ */
+struct Counters {
+  double seconds = 0.0;
+  uint64_t calls = 0;
+  uint64_t bytes = 0;
+  uint64_t cycles = 0;
+  uint64_t llc_misses = 0;
+
+  inline void merge(const Counters &o) {
+    seconds += o.seconds;
+    calls += o.calls;
+    bytes += o.bytes;
+    cycles += o.cycles;
+    llc_misses += o.llc_misses;
+  }
+};
+
+/**
+ * @brief Hardware counters of the calling thread through perf_event (Linux only)
+ *  Cycles and last level cache misses are opened as one group and read together.
+ */
+class PerfCounters {
+  int leader = -1;
+  int member = -1;
+
+#if defined(PHASE_FIELD_PROFILE) && defined(__linux__)
+  static inline int open(const uint64_t config, const int group) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.read_format = PERF_FORMAT_GROUP;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.disabled = group < 0 ? 1 : 0;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group, 0));
+  }
+#endif
+
+public:
+  PerfCounters() {
+#if defined(PHASE_FIELD_PROFILE) && defined(__linux__)
+    leader = open(PERF_COUNT_HW_CPU_CYCLES, -1);
+    if (leader < 0) {
+      return;
+    }
+    member = open(PERF_COUNT_HW_CACHE_MISSES, leader);
+    if (member < 0) {
+      ::close(leader);
+      leader = -1;
+      return;
+    }
+    ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+  }
+  PerfCounters(const PerfCounters &) = delete;
+  PerfCounters &operator=(const PerfCounters &) = delete;
+  ~PerfCounters() {
+#if defined(PHASE_FIELD_PROFILE) && defined(__linux__)
+    if (member >= 0) {
+      ::close(member);
+    }
+    if (leader >= 0) {
+      ::close(leader);
+    }
+#endif
+  }
+
+  inline bool available() const { return leader >= 0; }
+
+  /**
+   * @brief Current cycles and cache misses, zero when unavailable
+   */
+  inline std::array<uint64_t, 2> read() const {
+    std::array<uint64_t, 2> ret = {0, 0};
+#if defined(PHASE_FIELD_PROFILE) && defined(__linux__)
+    uint64_t buf[3] = {0, 0, 0}; // number of events, then their values
+    if (leader >= 0 && ::read(leader, buf, sizeof(buf)) == static_cast<ssize_t>(sizeof(buf))) {
+      ret = {buf[1], buf[2]};
+    }
+#endif
+    return ret;
+  }
+};
+
+/**
+ * @brief Counters of every thread that ran an instrumented scope
+ */
+class Registry {
+public:
+  struct Slot {
+    std::array<Counters, n_stages> stages;
+    std::unique_ptr<PerfCounters> perf;
+  };
+
+private:
+  std::mutex mtx;
+  std::deque<Slot> slots; // stable addresses, one per thread
+  bool counters = false;
+
+public:
+  static inline Registry &get() {
+    static Registry instance;
+    return instance;
+  }
+
+  /**
+   * @brief Slot of the calling thread, created on its first use
+   */
+  inline Slot &slot() {
+    thread_local Slot *local = nullptr;
+    if (!local) {
+      std::lock_guard lock{mtx};
+      local = &slots.emplace_back();
+      if (counters) {
+        local->perf = std::make_unique<PerfCounters>();
+      }
+    }
+    return *local;
+  }
+
+  /**
+   * @brief Read hardware counters in the threads that start profiling from now on
+   *  Call before the first instrumented step.
+   *
+   * @return whether perf_event is usable by this process
+   */
+  inline bool enable_counters() {
+    std::lock_guard lock{mtx};
+    counters = enabled && PerfCounters().available();
+    return counters;
+  }
+
+  inline bool counters_enabled() {
+    std::lock_guard lock{mtx};
+    return counters;
+  }
+
+  /**
+   * @brief Zero the counters of every thread
+   */
+  inline void reset() {
+    std::lock_guard lock{mtx};
+    for (auto &s : slots) {
+      s.stages = {};
+    }
+  }
+
+  /**
+   * @brief Totals of every stage over all threads
+   */
+  inline std::array<Counters, n_stages> totals() {
+    std::lock_guard lock{mtx};
+    std::array<Counters, n_stages> ret = {};
+    for (const auto &s : slots) {
+      for (std::size_t i = 0; i < n_stages; ++i) {
+        ret[i].merge(s.stages[i]);
+      }
+    }
+    return ret;
+  }
+};
+
+/**
+ * @brief Accumulate the time (and counters) from construction to destruction into a stage
+ */
+class Scope {
+  Counters &counters;
+  const PerfCounters *perf;
+  const std::chrono::steady_clock::time_point start;
+  std::array<uint64_t, 2> hw;
+
+public:
+  Scope(const Stage stage, const uint64_t bytes)
+      : Scope(Registry::get().slot(), static_cast<std::size_t>(stage), bytes) {}
+  Scope(Registry::Slot &slot, const std::size_t stage, const uint64_t bytes)
+      : counters(slot.stages[stage]), perf(slot.perf.get()),
+        start(std::chrono::steady_clock::now()),
+        hw(perf ? perf->read() : std::array<uint64_t, 2>{0, 0}) {
+    counters.bytes += bytes;
+    ++counters.calls;
+  }
+  Scope(const Scope &) = delete;
+  Scope &operator=(const Scope &) = delete;
+  ~Scope() {
+    if (perf) {
+      const auto now = perf->read();
+      counters.cycles += now[0] - hw[0];
+      counters.llc_misses += now[1] - hw[1];
+    }
+    counters.seconds +=
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  }
+};
+
+inline bool enable_counters() { return Registry::get().enable_counters(); }
+inline void reset() { Registry::get().reset(); }
+
+/**
+ * @brief Totals of every stage with their share of the time and bandwidth
+ *  Hardware counters are null unless enable_counters() succeeded.
+ */
+inline nlohmann::json report() {
+  const auto totals = Registry::get().totals();
+  const bool hw = Registry::get().counters_enabled();
+  double all = 0.0;
+  for (const auto &c : totals) {
+    all += c.seconds;
+  }
+  nlohmann::json ret = nlohmann::json::array();
+  for (std::size_t i = 0; i < n_stages; ++i) {
+    const auto &c = totals[i];
+    ret.push_back({{"stage", name(static_cast<Stage>(i))},
+                   {"seconds", c.seconds},
+                   {"share", all > 0.0 ? c.seconds / all : 0.0},
+                   {"calls", c.calls},
+                   {"bytes", c.bytes},
+                   {"bandwidth", c.seconds > 0.0 ? c.bytes / c.seconds : 0.0},
+                   {"cycles", hw ? nlohmann::json(c.cycles) : nlohmann::json()},
+                   {"llc_misses", hw ? nlohmann::json(c.llc_misses) : nlohmann::json()}});
+  }
+  return ret;
+}
+
+/**
+ * @brief Write report() as JSON, or as CSV when the extension is .csv
+ */
+inline void write(const std::filesystem::path &filename) {
+  std::ofstream fo{filename};
+  if (!fo) {
+    throw std::runtime_error("could not open '" + filename.string() + "'");
+  }
+  const auto r = report();
+  if (filename.extension() == ".csv") {
+    const char *keys[] = {"stage", "seconds", "share", "calls", "bytes", "bandwidth", "cycles",
+                          "llc_misses"};
+    for (std::size_t k = 0; k < std::size(keys); ++k) {
+      fo << (k ? "," : "") << keys[k];
+    }
+    fo << std::endl;
+    for (const auto &row : r) {
+      for (std::size_t k = 0; k < std::size(keys); ++k) {
+        const auto &v = row.at(keys[k]);
+        fo << (k ? "," : "") << (v.is_string() ? v.get<std::string>() : v.dump());
+      }
+      fo << std::endl;
+    }
+  } else {
+    fo << r.dump(2) << std::endl;
+  }
+  if (!fo) {
+    throw std::runtime_error("failed to write '" + filename.string() + "'");
+  }
+}
+} // namespace phase_field::profile
+
+#define PHASE_FIELD_PROFILE_CAT_(a, b) a##b
+#define PHASE_FIELD_PROFILE_CAT(a, b) PHASE_FIELD_PROFILE_CAT_(a, b)
+
+/**
+ * @brief Time the rest of the enclosing block as a stage, moving bytes through its arrays
+ *  Neither argument is evaluated unless PHASE_FIELD_PROFILE is defined.
+ */
+#ifdef PHASE_FIELD_PROFILE
+#define PHASE_FIELD_PROFILE_SCOPE(stage, bytes)                                                   \
+  const ::phase_field::profile::Scope PHASE_FIELD_PROFILE_CAT(profile_scope_, __LINE__)(          \
+      ::phase_field::profile::Stage::stage, static_cast<uint64_t>(bytes))
+#else
+#define PHASE_FIELD_PROFILE_SCOPE(stage, bytes)
+#endif
+
+#endif // __PHASE_FIELD__PROFILE__
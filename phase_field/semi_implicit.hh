@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2025 Materials Modelling Lab, The University of Tokyo
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __PHASE_FIELD__SEMI_IMPLICIT__
+#define __PHASE_FIELD__SEMI_IMPLICIT__
+
+#include "impl/fft.hh"
+#include "impl/functor.hh"
+#include "impl/kernel.hh"
+#include "impl/type.hh"
+#include "impl/workspace.hh"
+#include "padded.hh"
+#include "param.hh"
+#include "phase_field.hh"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace phase_field {
+/**
+ * @brief Semi-implicit solver of the 2D phase field, with the stiff Laplacian solved spectrally
+ *  The explicit right hand side N(phi) = (div + chemical potential) / tau of the fused kernel is
+ *  kept, anisotropy and nonlinearity included, and the step is
+ *
+ *    (1 - dt kappa L) (phi' - phi) = dt N(phi)
+ *
+ *  with L the 5-point Laplacian with reflecting boundaries, solved in cosine space (fft::Dct2D).
+ *  N(phi) is taken with the same boundaries: phi is copied into a PaddedField2D with mirror
+ *  ghost cells before the sweep, rather than zero padded as in PhaseField2D, so the operator
+ *  the solve damps is the one of the explicit part next to the walls as well.
+ *  It adds dt kappa L (phi' - phi) to forward Euler, a term of the order of dt^2 that vanishes
+ *  at steady state, and damps the short waves that limit the explicit step to
+ *  dt < dx^2 tau / (4 W^2). kappa = W0^2 (1 + 15 epsilon_c) / tau_min bounds the diffusion
+ *  coefficient W^2 / tau of the anisotropic operator over every orientation, the same bound
+ *  the explicit stability rate of BasicStepStats uses. The chemical potential stays explicit,
+ *  so dt is still limited to about tau / |df/dphi|.
+ *
+ *  The step is taken as param.dt; only double precision is supported.
+ */
+class SemiImplicitPhaseField2D {
+public:
+  using T = Field2D::scalar_type;
+  const Param param;
+  const T kappa;
+
+private:
+  mutable PredictWorkspace workspace;
+  mutable fft::Dct2D dct;
+  mutable PaddedField2D padded;     // phi with mirror ghost cells
+  mutable std::vector<T> inc;       // dt N(phi), then phi' - phi
+  mutable std::vector<T> lap_y;     // eigenvalues of the Laplacian along y
+  mutable std::vector<T> lap_x;     // and along x
+  FusedPredictKernel fused;
+  ChemPotFunctor<T> chem_func;
+  FieldClampFunctor<T> clamp_func;
+
+  /* Eigenvalues -4 sin^2(pi k / 2n) / dx^2 of the 1D Laplacian with reflecting boundaries */
+  inline std::vector<T> get_eigenvalues(const int64_t n) const {
+    std::vector<T> ret(n);
+    for (int64_t k = 0; k < n; ++k) {
+      const T s = std::sin(T(M_PI) * static_cast<T>(k) / static_cast<T>(2 * n));
+      ret[k] = -T(4) * s * s / (param.dx * param.dx);
+    }
+    return ret;
+  }
+
+  inline void reserve(const Field2D &phi) const {
+    const int64_t ny = phi.shape()[0];
+    const int64_t nx = phi.shape()[1];
+    Boundaries2D(Boundary::mirror()).validate(ny, nx, PaddedField2D::ghost);
+    workspace.reserve(phi);
+    dct.reserve(ny, nx);
+    if (padded.shape() != phi.shape()) {
+      padded = PaddedField2D(phi.shape());
+    }
+    if (static_cast<int64_t>(lap_y.size()) != ny || static_cast<int64_t>(lap_x.size()) != nx) {
+      lap_y = get_eigenvalues(ny);
+      lap_x = get_eigenvalues(nx);
+      inc.assign(static_cast<std::size_t>(ny * nx), T(0));
+    }
+  }
+
+  /* One step from phi to ret, by every thread of the enclosing parallel region */
+  inline void step(const Field2D &phi, Field2D &ret, FusedPredictKernel::Scratch &s) const {
+    const int64_t ny = phi.shape()[0];
+    const int64_t nx = phi.shape()[1];
+    const T dt = param.dt;
+    T *d = inc.data();
+#pragma omp for schedule(static)
+    for (int64_t y = 0; y < ny; ++y) {
+      const auto &src = phi[y];
+      T *dst = padded[y];
+      for (int64_t x = 0; x < nx; ++x) {
+        dst[x] = src[x];
+      }
+    }
+    padded.fill(Boundaries2D(Boundary::mirror()));
+    const int64_t g = PaddedField2D::ghost;
+    const Box2D valid{-g, ny + g, -g, nx + g};
+    constexpr int64_t tile_y = FusedPredictKernel::tile_y;
+    constexpr int64_t tile_x = FusedPredictKernel::tile_x;
+    const int64_t n_ty = (ny + tile_y - 1) / tile_y;
+    const int64_t n_tx = (nx + tile_x - 1) / tile_x;
+#pragma omp for collapse(2) schedule(static)
+    for (int64_t ty = 0; ty < n_ty; ++ty) {
+      for (int64_t tx = 0; tx < n_tx; ++tx) {
+        const Box2D out{ty * tile_y, std::min(ny, (ty + 1) * tile_y), tx * tile_x,
+                        std::min(nx, (tx + 1) * tile_x)};
+        fused.tile(padded, out, valid, s,
+                   [this, d, dt, nx](const int64_t y, const Box2D &o, const T *p, const T *div,
+                                     const T *tau_inv) {
+                     T *row = d + y * nx + o.x0;
+                     for (int64_t i = 0; i < o.x1 - o.x0; ++i) {
+                       T term4;
+                       chem_func(term4, p[i]);
+                       row[i] = dt * tau_inv[i] * (div[i] + term4);
+                     }
+                   });
+      }
+    }
+    const T c = dt * kappa;
+    const T *ly = lap_y.data();
+    const T *lx = lap_x.data();
+    dct.filter(d, [c, ly, lx](const int64_t ky, const int64_t kx) {
+      return T(1) / (T(1) - c * (ly[ky] + lx[kx]));
+    });
+#pragma omp for schedule(static)
+    for (int64_t y = 0; y < ny; ++y) {
+      const auto &src = phi[y];
+      auto &&dst = ret[y];
+      const T *row = d + y * nx;
+      for (int64_t x = 0; x < nx; ++x) {
+        T next = src[x] + row[x];
+        clamp_func(next);
+        dst[x] = next;
+      }
+    }
+  }
+
+public:
+  SemiImplicitPhaseField2D(const Param &p)
+      : param(p), kappa(get_kappa(p)), fused(param), chem_func(p.u, p.lambda) {
+    if (!(p.dt > 0.0)) {
+      throw std::invalid_argument("time step must be positive");
+    }
+  }
+
+  /**
+   * @brief Largest diffusion coefficient W^2 / tau of the anisotropic operator
+   *  a_c a_k is concave in n4 = (nx^4 + ny^4) / |n|^4, so tau is smallest at an end of the
+   *  range n4 = 1/2 to 1 or at n4 = 0, taken where the gradient vanishes.
+   */
+  static inline T get_kappa(const Param &p) {
+    const AcFunctor<T> ac(p.epsilon_c);
+    const AkFunctor<T> ak(p.epsilon_k);
+    T ac_ak = std::numeric_limits<T>::max();
+    for (const T n4 : {T(0), T(0.5), T(1)}) {
+      ac_ak = std::min(ac_ak, (ac.c1 + ac.c2 * n4) * (ak.c1 - ak.c2 * n4));
+    }
+    return p.W0 * p.W0 * (1.0 + 15.0 * p.epsilon_c) / (p.tau0 * ac_ak);
+  }
+
+  /**
+   * @brief Advance the phase field by one step of param.dt
+   *
+   * @param phi current phase field
+   * @param ret next phase field
+   */
+  inline void predict(const Field2D &phi, Field2D &ret) const {
+    if (phi.shape() != ret.shape()) {
+      throw std::runtime_error("invalid shape of tensor given");
+    }
+    reserve(phi);
+#pragma omp parallel
+    step(phi, ret, workspace.thread_scratch());
+  }
+
+  /**
+   * @brief Advance the phase field by n_steps steps of param.dt in one parallel region
+   *
+   * @param state current field and the buffer of the next one
+   * @param n_steps number of steps
+   */
+  inline void advance(PingPong2D &state, const std::size_t n_steps) const {
+    if (state.current().shape() != state.next().shape()) {
+      throw std::runtime_error("invalid shape of tensor given");
+    }
+    reserve(state.current());
+#pragma omp parallel
+    {
+      auto &s = workspace.thread_scratch();
+      for (std::size_t n = 0; n < n_steps; ++n) {
+        step(state.current(), state.next(), s);
+#pragma omp single
+        state.swap();
+      }
+    }
+  }
+};
+} // namespace phase_field
+
+#endif // __PHASE_FIELD__SEMI_IMPLICIT__
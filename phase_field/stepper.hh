@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2025 Materials Modelling Lab, The University of Tokyo
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __PHASE_FIELD__STEPPER__
+#define __PHASE_FIELD__STEPPER__
+
+#include "impl/kernel.hh"
+#include "impl/type.hh"
+#include "phase_field.hh"
+#include <algorithm>
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+
+namespace phase_field {
+/**
+ * @brief Bounds of the adaptive time step
+ *  dt_min and dt_max are in units of tau0.
+ */
+struct StepperParam {
+  Field2D::scalar_type safety = 0.5;    // fraction of the stability limit
+  Field2D::scalar_type max_dphi = 0.02; // largest change of phi per step
+  Field2D::scalar_type growth = 1.2;    // largest ratio of consecutive steps
+  Field2D::scalar_type dt_min = 1e-4;   // lower bound, well below the fixed step (0.004)
+  Field2D::scalar_type dt_max = 0.2;    // upper bound
+
+  NLOHMANN_DEFINE_TYPE_INTRUSIVE(StepperParam, safety, max_dphi, growth, dt_min, dt_max);
+};
+
+/**
+ * @brief Explicit time integration with a step chosen from the previous one
+ *  After each step the next dt is the smallest of
+ *    dt * max_dphi / (largest dphi)    (accuracy, shrinks while the interface moves fast)
+ *    dt * growth
+ *  clamped to [dt_min, dt_max] tau0, and then at most safety / max_rate (stability of the
+ *  current state), which wins over dt_min so no step is knowingly unstable. The first step uses
+ *  param.dt.
+ */
+class AdaptiveStepper {
+public:
+  using T = Field2D::scalar_type;
+
+private:
+  const PhaseField2D &system;
+  const StepperParam cfg;
+  T dt_next;
+  T elapsed = 0.0;
+  std::size_t n_steps = 0;
+  StepStats last;
+
+public:
+  AdaptiveStepper(const PhaseField2D &s, const StepperParam &c = {})
+      : system(s), cfg(c), dt_next(s.param.dt) {
+    if (!(0.0 < c.safety && c.safety <= 1.0) || c.max_dphi <= 0.0 || c.growth < 1.0 ||
+        c.dt_min <= 0.0 || c.dt_max < c.dt_min) {
+      throw std::invalid_argument("invalid stepper parameter given");
+    }
+  }
+
+  /**
+   * @brief Advance phi by one adaptive step, never past t_end
+   *
+   * @param phi current phase field
+   * @param ret next phase field
+   * @param t_end time not to be stepped over
+   * @return time step taken
+   */
+  inline T step(const Field2D &phi, Field2D &ret, const T t_end) {
+    /* Snap to t_end instead of leaving a sliver for the next step */
+    const T remaining = t_end - elapsed;
+    const T dt = dt_next * 1.000001 >= remaining ? remaining : dt_next;
+    last = system.predict(phi, ret, dt);
+    elapsed = dt == remaining ? t_end : elapsed + dt;
+    ++n_steps;
+
+    const T tau0 = system.param.tau0;
+    T next = dt_next * cfg.growth;
+    if (last.max_dphi > 0.0) {
+      next = std::min(next, dt * cfg.max_dphi / last.max_dphi);
+    }
+    dt_next = std::clamp(next, cfg.dt_min * tau0, cfg.dt_max * tau0);
+    if (last.max_rate > 0.0) {
+      dt_next = std::min(dt_next, cfg.safety * last.dt_stable());
+    }
+    return dt;
+  }
+
+  /**
+   * @brief Physical time integrated so far
+   */
+  inline T time() const { return elapsed; }
+
+  /**
+   * @brief Number of steps taken so far
+   */
+  inline std::size_t steps() const { return n_steps; }
+
+  /**
+   * @brief Time step of the next call of step (before snapping to t_end)
+   */
+  inline T dt() const { return dt_next; }
+
+  /**
+   * @brief Statistics of the last step
+   */
+  inline const StepStats &stats() const { return last; }
+
+  /**
+   * @brief Continue from the state of another stepper, e.g. read back from a checkpoint
+   *  With the same field, the following steps are bitwise identical to those of that stepper.
+   *
+   * @param time time() of the stepper
+   * @param steps steps() of the stepper
+   * @param dt dt() of the stepper
+   */
+  inline void restore(const T time, const std::size_t steps, const T dt) {
+    if (!(dt > 0.0) || !(time >= 0.0)) {
+      throw std::invalid_argument("invalid stepper state given");
+    }
+    elapsed = time;
+    n_steps = steps;
+    dt_next = dt;
+    last = {};
+  }
+};
+} // namespace phase_field
+
+#endif // __PHASE_FIELD__STEPPER__
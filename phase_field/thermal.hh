@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2025 Materials Modelling Lab, The University of Tokyo
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __PHASE_FIELD__THERMAL__
+#define __PHASE_FIELD__THERMAL__
+
+#include "impl/functor.hh"
+#include "impl/kernel.hh"
+#include "impl/type.hh"
+#include "impl/workspace.hh"
+#include "param.hh"
+#include <algorithm>
+#include <nlohmann/json.hpp>
+#include <vector>
+
+namespace phase_field {
+struct ThermalParam {
+  Field2D::scalar_type D; // Thermal diffusivity [m^2/s]
+
+  NLOHMANN_DEFINE_TYPE_INTRUSIVE(ThermalParam, D);
+
+  /**
+   * @brief Largest step stable for both the phase field and the explicit heat equation
+   */
+  static inline Field2D::scalar_type calc_dt(const Param &p, const ThermalParam &t) {
+    assert(t.D && "D not set");
+    return std::min(p.dt, 0.2 * p.dx * p.dx / t.D);
+  }
+};
+
+static inline const auto get_pure_ni_thermal_param = []() -> ThermalParam {
+  ThermalParam ret;
+  ret.D = 1.13e-5; // k / cp with k = 60 W/(m K)
+  return ret;
+};
+
+/**
+ * @brief Scratch memory of PhaseFieldThermal2D::predict
+ */
+class ThermalWorkspace {
+  std::vector<std::vector<Field2D::scalar_type>> u_rows;
+
+public:
+  PredictWorkspace predict;
+
+  inline void reserve(const Field2D &phi) {
+    predict.reserve(phi);
+    const auto n_threads = static_cast<std::size_t>(omp_get_max_threads());
+    if (u_rows.size() < n_threads) {
+      u_rows.resize(n_threads);
+    }
+    for (auto &r : u_rows) {
+      r.resize(3 * (FusedPredictKernel::tile_x + 2));
+    }
+  }
+
+  /**
+   * @brief Three rows of the undercooling for the calling OpenMP thread
+   */
+  inline Field2D::scalar_type *thread_rows() {
+    return u_rows[static_cast<std::size_t>(omp_get_thread_num())].data();
+  }
+};
+
+/**
+ * @brief Phase field coupled with the dimensionless undercooling u = (T - Tm) / (L / cp)
+ *  tau dphi/dt = <isothermal right hand side with Param::u replaced by u(x, y, t)>
+ *      du/dt   = D lap(u) + 1/2 dphi/dt
+ *  Both fields are advanced in the same tiled sweep of FusedPredictKernel, so phi and u are
+ *  each read once per step. The phase field keeps the zero padded boundary of predict, and the
+ *  undercooling uses zero flux (mirror) boundaries. param.dt is reduced to the stability limit
+ *  of the heat equation when needed.
+ */
+class PhaseFieldThermal2D {
+public:
+  using T = Field2D::scalar_type;
+  const Param param;
+  const ThermalParam thermal;
+
+private:
+  FusedPredictKernel fused;
+  ChemPotFieldFunctor<> chem_func;
+  PredictFunctor<> predict_func;
+  FieldClampFunctor<> clamp_func;
+  HeatFunctor<> heat_func;
+  mutable ThermalWorkspace workspace;
+
+  static inline Param with_coupled_dt(const Param &p, const ThermalParam &t) {
+    Param ret = p;
+    ret.dt = ThermalParam::calc_dt(p, t);
+    return ret;
+  }
+
+public:
+  PhaseFieldThermal2D(const Param &p, const ThermalParam &t)
+      : param(with_coupled_dt(p, t)), thermal(t), fused(param), chem_func(param.lambda),
+        predict_func(param.dt), heat_func(thermal.D, param.dt, param.dx) {}
+
+  /**
+   * @brief Advance the phase field and the undercooling by one step
+   *
+   * @param phi current phase field
+   * @param u current undercooling
+   * @param phi_next next phase field
+   * @param u_next next undercooling
+   */
+  inline void predict(const Field2D &phi, const Field2D &u, Field2D &phi_next,
+                      Field2D &u_next) const {
+    predict(phi, u, phi_next, u_next, workspace);
+  }
+
+  /**
+   * @brief Advance the phase field and the undercooling by one step
+   *
+   * @param phi current phase field
+   * @param u current undercooling
+   * @param phi_next next phase field
+   * @param u_next next undercooling
+   * @param ws workspace owned by the caller
+   */
+  inline void predict(const Field2D &phi, const Field2D &u, Field2D &phi_next, Field2D &u_next,
+                      ThermalWorkspace &ws) const {
+    if (phi.shape() != u.shape() || phi.shape() != phi_next.shape() ||
+        phi.shape() != u_next.shape()) {
+      throw std::runtime_error("invalid shape of tensor given");
+    }
+    ws.reserve(phi);
+    const int64_t ny = phi.shape()[0];
+    const int64_t nx = phi.shape()[1];
+    const int64_t stride = FusedPredictKernel::tile_x + 2;
+
+#pragma omp parallel
+    {
+      T *u_rows = ws.thread_rows();
+      const auto slot = [u_rows, stride](const int64_t y) {
+        return u_rows + ((y % 3) + 3) % 3 * stride;
+      };
+      const auto load = [&](const int64_t y, const Box2D &out) {
+        const auto &src = u[std::clamp<int64_t>(y, 0, ny - 1)];
+        T *dst = slot(y);
+        for (int64_t x = out.x0 - 1; x < out.x1 + 1; ++x) {
+          dst[x - out.x0 + 1] = src[std::clamp<int64_t>(x, 0, nx - 1)];
+        }
+      };
+
+      fused.sweep(phi, ws.predict.thread_scratch(),
+                  [&](const int64_t y, const Box2D &out, const T *p, const T *div,
+                      const T *tau_inv) {
+                    if (y == out.y0) {
+                      load(y - 1, out);
+                      load(y, out);
+                    }
+                    load(y + 1, out);
+                    const T *u_n = slot(y - 1) + 1;
+                    const T *u_c = slot(y) + 1;
+                    const T *u_s = slot(y + 1) + 1;
+
+                    auto &&phi_row = phi_next[y];
+                    auto &&u_row = u_next[y];
+                    for (int64_t i = 0; i < out.x1 - out.x0; ++i) {
+                      T term4;
+                      chem_func(term4, p[i], u_c[i]);
+                      const T rhs = div[i] + term4;
+
+                      T next;
+                      predict_func(next, tau_inv[i], rhs, p[i]);
+                      clamp_func(next);
+
+                      const T lap = u_n[i] + u_s[i] + u_c[i - 1] + u_c[i + 1] - 4.0 * u_c[i];
+                      T u_new;
+                      heat_func(u_new, lap, u_c[i], next - p[i]);
+
+                      phi_row[out.x0 + i] = next;
+                      u_row[out.x0 + i] = u_new;
+                    }
+                  });
+    }
+  }
+};
+} // namespace phase_field
+
+#endif // __PHASE_FIELD__THERMAL__
@@ -37,6 +37,83 @@ inline void set_nuclear_to_corner(Field2D &f, const int64_t r) {
     }
   }
 }
+
+/**
+ * @brief Set a circular nuclear centred at (yc, xc) to the 2D phase field
+ *
+ * @param yc y of the centre in grid index
+ * @param xc x of the centre in grid index
+ * @param r radius of the nuclear in grid size
+ * @param f field 2D tensor
+ */
+inline void set_nuclear(Field2D &f, const int64_t yc, const int64_t xc, const int64_t r) {
+  const auto &f_shape = f.shape();
+  const auto r_sq = static_cast<Field2D::scalar_type>(r * r);
+  if (yc < 0 || xc < 0 || static_cast<int64_t>(f_shape[0]) <= yc ||
+      static_cast<int64_t>(f_shape[1]) <= xc) {
+    throw std::invalid_argument("centre out of the field");
+  }
+
+#pragma omp parallel for
+  for (int64_t y = 0; y < static_cast<int64_t>(f_shape[0]); ++y) {
+    auto &&row = f[y];
+    for (int64_t x = 0; x < static_cast<int64_t>(f_shape[1]); ++x) {
+      const auto dx = static_cast<Field2D::scalar_type>(x - xc);
+      const auto dy = static_cast<Field2D::scalar_type>(y - yc);
+      row[x] = (dx * dx + dy * dy) <= r_sq ? FieldState::solid : FieldState::liquid;
+    }
+  }
+}
+
+/**
+ * @brief Copy a field into another scalar type
+ *
+ * @param src field to be copied
+ * @param dst copy, resized to the shape of src
+ */
+template <typename T, typename U>
+inline void convert(const BasicField2D<U> &src, BasicField2D<T> &dst) {
+  if (dst.shape() != src.shape()) {
+    dst = BasicField2D<T>(src.shape());
+  }
+  const auto ny = static_cast<int64_t>(src.shape()[0]);
+  const auto nx = static_cast<int64_t>(src.shape()[1]);
+#pragma omp parallel for
+  for (int64_t y = 0; y < ny; ++y) {
+    const auto &in = src[y];
+    auto &&out = dst[y];
+    for (int64_t x = 0; x < nx; ++x) {
+      out[x] = static_cast<T>(in[x]);
+    }
+  }
+}
+
+/**
+ * @brief Set the nuclear to the 3D phase field
+ *
+ * @param r radius of the nuclear in grid size
+ * @param f field 3D tensor
+ */
+inline void set_nuclear_to_corner(Field3D &f, const int64_t r) {
+  const auto &f_shape = f.shape();
+  const auto r_sq = static_cast<Field3D::scalar_type>(r * r);
+  if (static_cast<int64_t>(f_shape[0]) <= r || static_cast<int64_t>(f_shape[1]) <= r ||
+      static_cast<int64_t>(f_shape[2]) <= r) {
+    throw std::invalid_argument("diameter too large");
+  }
+
+#pragma omp parallel for
+  for (int64_t z = 0; z < static_cast<int64_t>(f_shape[0]); ++z) {
+    auto &&plane = f[z];
+    for (int64_t y = 0; y < static_cast<int64_t>(f_shape[1]); ++y) {
+      auto &&row = plane[y];
+      for (int64_t x = 0; x < static_cast<int64_t>(f_shape[2]); ++x) {
+        const auto d_sq = static_cast<Field3D::scalar_type>(x * x + y * y + z * z);
+        row[x] = d_sq <= r_sq ? FieldState::solid : FieldState::liquid;
+      }
+    }
+  }
+}
 } // namespace phase_field
 
 #endif
\ No newline at end of file
@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2025 Materials Modelling Lab, The University of Tokyo
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __PHASE_FIELD__WRITER__
+#define __PHASE_FIELD__WRITER__
+
+#include "impl/type.hh"
+#include "io.hh"
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace phase_field::io {
+enum class Format {
+  snapshot, // binary .pfs
+  text,     // legacy .dat
+};
+
+/**
+ * @brief Background writer of field snapshots
+ *  submit copies the field into one of a fixed pool of buffers and returns; a dedicated thread
+ *  formats and writes the buffers in submission order. When every buffer is still queued,
+ *  submit blocks until one is released (backpressure), so memory use stays bounded. The time
+ *  the caller spent blocked is accumulated and reported by blocked_seconds.
+ */
+class AsyncWriter {
+  struct Job {
+    std::filesystem::path filename;
+    Format format;
+    SnapshotInfo info;
+    std::size_t buffer;
+  };
+
+  std::vector<Field2D> buffers;
+  std::vector<std::size_t> free_buffers;
+  std::deque<Job> jobs;
+  bool busy = false;
+  bool stop = false;
+  std::exception_ptr error;
+
+  mutable std::mutex mtx;
+  std::condition_variable cv_job;
+  std::condition_variable cv_free;
+  std::thread worker;
+
+  double blocked = 0.0;
+  double copying = 0.0;
+  double writing = 0.0;
+  std::size_t n_written = 0;
+
+  inline void rethrow() {
+    if (error) {
+      std::rethrow_exception(std::exchange(error, nullptr));
+    }
+  }
+
+  inline void run() {
+    while (true) {
+      Job job;
+      {
+        std::unique_lock lock(mtx);
+        cv_job.wait(lock, [this] { return stop || !jobs.empty(); });
+        if (jobs.empty()) {
+          return;
+        }
+        job = std::move(jobs.front());
+        jobs.pop_front();
+        busy = true;
+      }
+
+      const auto begin = std::chrono::steady_clock::now();
+      try {
+        const auto &field = buffers[job.buffer];
+        if (job.format == Format::snapshot) {
+          write_snapshot(job.filename, field, job.info, true);
+        } else {
+          write(job.filename, field, true);
+        }
+      } catch (...) {
+        std::lock_guard lock(mtx);
+        error = std::current_exception();
+      }
+      const auto end = std::chrono::steady_clock::now();
+
+      {
+        std::lock_guard lock(mtx);
+        writing += std::chrono::duration<double>(end - begin).count();
+        ++n_written;
+        free_buffers.push_back(job.buffer);
+        busy = false;
+      }
+      cv_free.notify_all();
+    }
+  }
+
+public:
+  /**
+   * @brief Start the writer thread
+   *
+   * @param depth number of snapshots that may be in flight
+   */
+  explicit AsyncWriter(const std::size_t depth = 2) : buffers(std::max<std::size_t>(depth, 1)) {
+    for (std::size_t i = 0; i < buffers.size(); ++i) {
+      free_buffers.push_back(i);
+    }
+    worker = std::thread([this] { run(); });
+  }
+  AsyncWriter(const AsyncWriter &) = delete;
+  AsyncWriter &operator=(const AsyncWriter &) = delete;
+
+  ~AsyncWriter() {
+    {
+      std::lock_guard lock(mtx);
+      stop = true;
+    }
+    cv_job.notify_all();
+    worker.join();
+  }
+
+  /**
+   * @brief Queue a snapshot of the field
+   *  Blocks only while all buffers are in flight.
+   *
+   * @param filename output path, overwritten if it exists
+   * @param field phase field to be copied
+   * @param format output format
+   * @param info step, time and metadata written with snapshot format
+   */
+  inline void submit(const std::filesystem::path &filename, const Field2D &field,
+                     const Format format, const SnapshotInfo &info = {}) {
+    const auto begin = std::chrono::steady_clock::now();
+    std::size_t id;
+    {
+      std::unique_lock lock(mtx);
+      cv_free.wait(lock, [this] { return !free_buffers.empty() || error; });
+      rethrow();
+      id = free_buffers.back();
+      free_buffers.pop_back();
+    }
+    const auto acquired = std::chrono::steady_clock::now();
+
+    auto &buf = buffers[id];
+    const std::size_t y_size = field.shape()[0];
+    const std::size_t x_size = field.shape()[1];
+    if (buf.shape() != field.shape()) {
+      buf.resize({y_size, x_size});
+    }
+#pragma omp parallel for
+    for (std::size_t y = 0; y < y_size; ++y) {
+      const auto &src = field[y];
+      auto &&dst = buf[y];
+      for (std::size_t x = 0; x < x_size; ++x) {
+        dst[x] = src[x];
+      }
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    {
+      std::lock_guard lock(mtx);
+      jobs.push_back({filename, format, info, id});
+      blocked += std::chrono::duration<double>(end - begin).count();
+      copying += std::chrono::duration<double>(end - acquired).count();
+    }
+    cv_job.notify_one();
+  }
+
+  /**
+   * @brief Wait until every queued snapshot is written
+   */
+  inline void flush() {
+    const auto begin = std::chrono::steady_clock::now();
+    std::unique_lock lock(mtx);
+    cv_free.wait(lock, [this] { return (jobs.empty() && !busy) || error; });
+    blocked += std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    rethrow();
+  }
+
+  /**
+   * @brief Seconds the caller spent in submit and flush, including the copy
+   */
+  inline double blocked_seconds() const {
+    std::lock_guard lock(mtx);
+    return blocked;
+  }
+
+  /**
+   * @brief Seconds the caller spent copying fields into buffers
+   */
+  inline double copy_seconds() const {
+    std::lock_guard lock(mtx);
+    return copying;
+  }
+
+  /**
+   * @brief Seconds the writer thread spent formatting and writing
+   */
+  inline double write_seconds() const {
+    std::lock_guard lock(mtx);
+    return writing;
+  }
+
+  inline std::size_t written() const {
+    std::lock_guard lock(mtx);
+    return n_written;
+  }
+};
+} // namespace phase_field::io
+
+#endif // __PHASE_FIELD__WRITER__
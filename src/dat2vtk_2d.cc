@@ -3,21 +3,41 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdint>
 #include <cstring>
 #include <filesystem>
+#include <fnmatch.h>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <mutex>
+#include <set>
+#include <omp.h>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include <phase_field/io.hh>
 
-#include <vtkImageData.h>
-#include <vtkNew.h>
-#include <vtkXMLImageDataWriter.h>
+#include <zlib.h>
+
+enum class Symmetry {
+  mirror,   // 2x2 image rebuilt from the quadrant row by row while writing
+  quadrant, // computed quadrant only, reflected in ParaView
+};
 
 struct Args {
-  std::filesystem::path input;
-  std::filesystem::path output = "vtk"; // *Optional
-  std::filesystem::path name;           // *Optional
+  std::vector<std::string> input;
+  std::filesystem::path output = "vtk";          // *Optional
+  std::filesystem::path name;                    // *Optional
+  std::filesystem::path pvd = "phase_field.pvd"; // *Optional
+  std::size_t jobs = 0;                          // *Optional, 0: one per hardware thread
+  std::size_t memory = 0;                        // *Optional, [MiB], 0: unlimited
+  Symmetry symmetry = Symmetry::mirror;
+  bool compress = false;
 };
 
 static void parse_args(const int argc, const char *const argv[], Args &args) {
@@ -25,9 +45,23 @@ static void parse_args(const int argc, const char *const argv[], Args &args) {
     os << argv[0] << " [Option]" << std::endl;
     os << std::endl;
     os << "Options:" << std::endl;
-    os << "    --input    Input .dat file" << std::endl;
+    os << "    --input    .pfs snapshots or .dat files, directories or quoted glob patterns"
+       << std::endl;
     os << "    --output   (Opt) Output path (default: vtk)" << std::endl;
-    os << "    --name     (Opt) Output filename (default: <input_basename>.vti)" << std::endl;
+    os << "    --name     (Opt) Output filename of a single input (default: <input>.vti)"
+       << std::endl;
+    os << "    --pvd      (Opt) Time series collection of several inputs (default: "
+          "phase_field.pvd)"
+       << std::endl;
+    os << "    --jobs     (Opt) Files converted at once (default: hardware threads)" << std::endl;
+    os << "    --memory   (Opt) Memory budget in MiB, lowers --jobs (default: unlimited)"
+       << std::endl;
+    os << "    --symmetry (Opt) mirror: write the 2x2 mirrored image, quadrant: write the input as"
+       << std::endl;
+    os << "               is to be reflected in ParaView by the reflect.py written next to it"
+       << std::endl;
+    os << "               (default: mirror)" << std::endl;
+    os << "    --compress (Opt) Write zlib compressed appended data" << std::endl;
     os << "    --help     (Opt) Print help" << std::endl;
     return os;
   };
@@ -36,6 +70,10 @@ static void parse_args(const int argc, const char *const argv[], Args &args) {
     input,
     output,
     name,
+    pvd,
+    jobs,
+    memory,
+    symmetry,
   } ctx = context::none;
 
   for (int64_t i = 1; i < argc; ++i) {
@@ -47,6 +85,16 @@ static void parse_args(const int argc, const char *const argv[], Args &args) {
         ctx = context::output;
       } else if (!strcmp(argv[i], "--name")) {
         ctx = context::name;
+      } else if (!strcmp(argv[i], "--pvd")) {
+        ctx = context::pvd;
+      } else if (!strcmp(argv[i], "--jobs")) {
+        ctx = context::jobs;
+      } else if (!strcmp(argv[i], "--memory")) {
+        ctx = context::memory;
+      } else if (!strcmp(argv[i], "--symmetry")) {
+        ctx = context::symmetry;
+      } else if (!strcmp(argv[i], "--compress")) {
+        args.compress = true;
       } else if (!strcmp(argv[i], "--help")) {
         show_help(std::cout);
         exit(EXIT_SUCCESS);
@@ -56,8 +104,8 @@ static void parse_args(const int argc, const char *const argv[], Args &args) {
     } else {
       switch (ctx) {
       case context::input: {
-        args.input = argv[i];
-        ctx = context::none;
+        // Several inputs may follow, as expanded by the shell
+        args.input.emplace_back(argv[i]);
         break;
       }
       case context::output: {
@@ -70,6 +118,32 @@ static void parse_args(const int argc, const char *const argv[], Args &args) {
         ctx = context::none;
         break;
       }
+      case context::pvd: {
+        args.pvd = argv[i];
+        ctx = context::none;
+        break;
+      }
+      case context::jobs: {
+        args.jobs = std::stoul(argv[i]);
+        ctx = context::none;
+        break;
+      }
+      case context::memory: {
+        args.memory = std::stoul(argv[i]);
+        ctx = context::none;
+        break;
+      }
+      case context::symmetry: {
+        if (!strcmp(argv[i], "mirror")) {
+          args.symmetry = Symmetry::mirror;
+        } else if (!strcmp(argv[i], "quadrant")) {
+          args.symmetry = Symmetry::quadrant;
+        } else {
+          throw std::invalid_argument(std::string("Invalid symmetry '") + argv[i] + "' given");
+        }
+        ctx = context::none;
+        break;
+      }
       default:
         throw std::invalid_argument("Invalid token given");
       }
@@ -79,17 +153,365 @@ static void parse_args(const int argc, const char *const argv[], Args &args) {
   if (args.input.empty()) {
     throw std::invalid_argument("Required option '--input' not given");
   }
+}
+
+/**
+ * @brief Whether a .pfs file found in a directory is a field snapshot to convert
+ *  Checkpoints of the solver (rank 3, or "checkpoint" in the meta) sit next to the snapshots of
+ *  a run and are skipped. Files that cannot be read are kept so that convert reports them.
+ */
+static bool is_field_snapshot(const std::filesystem::path &filename) {
+  try {
+    phase_field::io::MappedSnapshot snapshot;
+    snapshot.open(filename);
+    return snapshot.rank() == 2 && !snapshot.info().meta.contains("checkpoint");
+  } catch (const std::exception &) {
+    return true;
+  }
+}
+
+/**
+ * @brief Expand the inputs into a sorted list of files
+ *  A directory stands for the .pfs snapshots and .dat files in it, and a filename with *, ? or [ is
+ *  matched against the files of its directory, so quoted patterns work without the shell
+ *  (whose argument list overflows for long runs).
+ */
+static std::vector<std::filesystem::path> expand_inputs(const std::vector<std::string> &input) {
+  namespace fs = std::filesystem;
+  std::vector<fs::path> ret;
+  const auto list = [&ret](const fs::path &dir, const auto &match) {
+    std::vector<fs::path> found;
+    for (const auto &entry : fs::directory_iterator(dir)) {
+      if (entry.is_regular_file() && match(entry.path())) {
+        found.push_back(entry.path());
+      }
+    }
+    std::sort(found.begin(), found.end());
+    ret.insert(ret.end(), found.begin(), found.end());
+    return found.size();
+  };
+
+  for (const auto &s : input) {
+    const fs::path p{s};
+    if (fs::is_directory(p)) {
+      list(p, [](const fs::path &f) {
+        return f.extension() == ".dat" || (f.extension() == ".pfs" && is_field_snapshot(f));
+      });
+    } else if (s.find_first_of("*?[") != std::string::npos) {
+      const auto dir = p.has_parent_path() ? p.parent_path() : fs::path(".");
+      const auto pattern = p.filename().string();
+      const auto n = list(dir, [&pattern](const fs::path &f) {
+        return fnmatch(pattern.c_str(), f.filename().c_str(), 0) == 0;
+      });
+      if (n == 0) {
+        throw std::runtime_error("no file matches '" + s + "'");
+      }
+    } else if (fs::is_regular_file(p)) {
+      ret.push_back(p);
+    } else {
+      throw std::runtime_error("file '" + s + "' not exist");
+    }
+  }
+  return ret;
+}
+
+/**
+ * @brief One converted file and its place in the time series
+ */
+struct Converted {
+  std::filesystem::path filename;
+  double time = 0.0;
+  std::string error;
+};
 
-  if (args.name.empty()) {
-    args.name = std::filesystem::path(args.input).filename().replace_extension(".vti");
+/**
+ * @brief Time of a .dat file, which only carries the step in its name (pf_step001000.dat)
+ */
+static double step_from_name(const std::filesystem::path &filename, const double fallback) {
+  const auto stem = filename.stem().string();
+  auto it = stem.end();
+  while (it != stem.begin() && std::isdigit(static_cast<unsigned char>(*(it - 1)))) {
+    --it;
+  }
+  return it == stem.end() ? fallback : std::stod(std::string(it, stem.end()));
+}
+
+/**
+ * @brief Streaming writer of a VTI image with one Float64 point array in appended raw data
+ *  Rows are produced by a callback into a small block buffer and written (or zlib compressed)
+ *  block by block, so the image itself is never held in memory. The block header of compressed
+ *  data precedes the blocks; it is written as a placeholder and filled in once their compressed
+ *  sizes are known.
+ */
+class VtiWriter {
+  std::ofstream fo;
+  std::filesystem::path filename;
+  std::size_t size_y, size_x;
+  bool compress;
+
+  // Output rows per block, about 256 KiB of data
+  std::size_t block_rows() const {
+    return std::max<std::size_t>(1, (std::size_t{1} << 18) / (size_x * sizeof(double)));
+  }
+
+  void check() const {
+    if (!fo) {
+      throw std::runtime_error("failed to write '" + filename.string() + "'");
+    }
+  }
+
+public:
+  /**
+   * @param origin coordinates of the first point
+   * @param time written as TimeValue field data, which ParaView shows as the time
+   */
+  VtiWriter(const std::filesystem::path &filename, const std::size_t size_y,
+            const std::size_t size_x, const double origin[2], const double time,
+            const bool compress, const Symmetry symmetry)
+      : fo(filename, std::ios::binary | std::ios::trunc), filename(filename), size_y(size_y),
+        size_x(size_x), compress(compress) {
+    if (!fo) {
+      throw std::runtime_error("could not open '" + filename.string() + "'");
+    }
+    const uint16_t one = 1;
+    const bool little = *reinterpret_cast<const char *>(&one) == 1;
+    fo << std::setprecision(17);
+    fo << "<?xml version=\"1.0\"?>\n";
+    fo << "<VTKFile type=\"ImageData\" version=\"1.0\" byte_order=\""
+       << (little ? "LittleEndian" : "BigEndian") << "\" header_type=\"UInt64\"";
+    if (compress) {
+      fo << " compressor=\"vtkZLibDataCompressor\"";
+    }
+    fo << ">\n";
+    const auto extent = "0 " + std::to_string(size_x - 1) + " 0 " + std::to_string(size_y - 1) +
+                        " 0 0";
+    fo << "  <ImageData WholeExtent=\"" << extent << "\" Origin=\"" << origin[0] << " "
+       << origin[1] << " 0\" Spacing=\"1 1 1\">\n";
+    fo << "    <FieldData>\n";
+    fo << "      <DataArray type=\"Float64\" Name=\"TimeValue\" NumberOfTuples=\"1\" "
+          "format=\"ascii\">"
+       << time << "</DataArray>\n";
+    if (symmetry == Symmetry::quadrant) {
+      // Planes (x = 0, y = 0) to reflect about, a hint for users and scripts; ParaView ignores it
+      fo << "      <DataArray type=\"Float64\" Name=\"ReflectPlanes\" NumberOfComponents=\"2\" "
+            "NumberOfTuples=\"1\" format=\"ascii\">0 0</DataArray>\n";
+    }
+    fo << "    </FieldData>\n";
+    fo << "    <Piece Extent=\"" << extent << "\">\n";
+    fo << "      <PointData Scalars=\"ImageScalars\">\n";
+    fo << "        <DataArray type=\"Float64\" Name=\"ImageScalars\" format=\"appended\" "
+          "offset=\"0\"/>\n";
+    fo << "      </PointData>\n";
+    fo << "      <CellData>\n";
+    fo << "      </CellData>\n";
+    fo << "    </Piece>\n";
+    fo << "  </ImageData>\n";
+    fo << "  <AppendedData encoding=\"raw\">\n   _";
+    check();
+  }
+
+  /**
+   * @brief Write the data, asking fill_row(y, row) for every output row from the bottom
+   */
+  template <typename F> void write(F &&fill_row) {
+    const std::size_t rows = block_rows();
+    const std::size_t n_blocks = (size_y + rows - 1) / rows;
+    const uint64_t block_bytes = rows * size_x * sizeof(double);
+    const uint64_t total = size_y * size_x * sizeof(double);
+    std::vector<double> block(rows * size_x);
+
+    std::vector<uint64_t> header;
+    std::streampos header_pos = fo.tellp();
+    if (compress) {
+      const uint64_t last = total - (n_blocks - 1) * block_bytes;
+      header = {n_blocks, block_bytes, last};
+      header.resize(3 + n_blocks, 0);
+    } else {
+      header = {total};
+    }
+    fo.write(reinterpret_cast<const char *>(header.data()), header.size() * sizeof(uint64_t));
+
+    std::vector<Bytef> packed(compress ? compressBound(block_bytes) : 0);
+    for (std::size_t b = 0; b < n_blocks; ++b) {
+      const std::size_t y0 = b * rows;
+      const std::size_t n = std::min(rows, size_y - y0);
+      for (std::size_t i = 0; i < n; ++i) {
+        fill_row(y0 + i, block.data() + i * size_x);
+      }
+      const auto bytes = n * size_x * sizeof(double);
+      if (compress) {
+        uLongf length = packed.size();
+        if (compress2(packed.data(), &length, reinterpret_cast<const Bytef *>(block.data()),
+                      bytes, 5) != Z_OK) {
+          throw std::runtime_error("failed to compress '" + filename.string() + "'");
+        }
+        header[3 + b] = length;
+        fo.write(reinterpret_cast<const char *>(packed.data()), length);
+      } else {
+        fo.write(reinterpret_cast<const char *>(block.data()), bytes);
+      }
+    }
+    fo << "\n  </AppendedData>\n</VTKFile>\n";
+    if (compress) {
+      fo.seekp(header_pos);
+      fo.write(reinterpret_cast<const char *>(header.data()), header.size() * sizeof(uint64_t));
+    }
+    fo.flush();
+    check();
+  }
+};
+
+/**
+ * @brief Convert one snapshot into a VTI file with four fold symmetry
+ *  With Symmetry::mirror each output row is assembled from one input row, reversed on the left
+ *  half, so no more than a block of the 2x2 image exists at a time. Symmetry::quadrant writes
+ *  the input as is, placed at (0.5, 0.5) so that reflecting about x = 0 and y = 0 gives the same
+ *  image as mirror, shifted by half of its size.
+ */
+static Converted convert(const std::filesystem::path &input, const std::filesystem::path &output,
+                         const bool compress, const Symmetry symmetry,
+                         const double fallback_time) {
+  Converted ret;
+  ret.filename = output;
+  ret.time = fallback_time;
+
+  // Snapshots are read in place from the mapped file, .dat files are parsed into a field
+  phase_field::io::MappedSnapshot snapshot;
+  phase_field::Field2D field;
+  std::size_t size_y = 0, size_x = 0;
+  const bool mapped = phase_field::io::is_snapshot(input);
+  if (mapped) {
+    snapshot.open(input);
+    if (snapshot.rank() != 2) {
+      throw std::runtime_error("snapshot " + input.string() + " is not 2D");
+    }
+    size_y = snapshot.shape(0);
+    size_x = snapshot.shape(1);
+    ret.time = snapshot.header().time;
+  } else {
+    phase_field::io::read(input, field);
+    size_y = field.shape()[0];
+    size_x = field.shape()[1];
+    ret.time = step_from_name(input, fallback_time);
+  }
+  const auto copy_row = [&](const std::size_t y, double *dst) {
+    if (mapped) {
+      std::copy_n(snapshot.row(y), size_x, dst);
+    } else {
+      const auto &src = field[y];
+      for (std::size_t x = 0; x < size_x; ++x) {
+        dst[x] = src[x];
+      }
+    }
+  };
+
+  if (symmetry == Symmetry::quadrant) {
+    const double origin[2] = {0.5, 0.5};
+    VtiWriter writer(output, size_y, size_x, origin, ret.time, compress, symmetry);
+    writer.write(copy_row);
+  } else {
+    const double origin[2] = {0.0, 0.0};
+    VtiWriter writer(output, size_y * 2, size_x * 2, origin, ret.time, compress, symmetry);
+    writer.write([&](const std::size_t y, double *dst) {
+      // Flip for 4 fold sym
+      copy_row(y < size_y ? size_y - 1 - y : y - size_y, dst + size_x);
+      std::reverse_copy(dst + size_x, dst + 2 * size_x, dst);
+    });
+  }
+  return ret;
+}
+
+/**
+ * @brief Bytes held while converting one file: the block buffers of the writer, plus the parsed
+ *  field of a .dat file and its text rows (snapshots are mapped)
+ */
+static std::size_t footprint(const std::filesystem::path &input) {
+  const std::size_t buffers = std::size_t{1} << 19;
+  if (phase_field::io::is_snapshot(input)) {
+    return buffers;
+  }
+  // A .dat cell takes at least two bytes of text, and parsing keeps a copy of the rows
+  const auto cells = std::filesystem::file_size(input) / 2;
+  return buffers + 2 * cells * sizeof(double);
+}
+
+/**
+ * @brief ParaView collection of the converted files, ordered by time
+ */
+static void write_pvd(const std::filesystem::path &filename, std::vector<Converted> files) {
+  std::stable_sort(files.begin(), files.end(),
+                   [](const Converted &a, const Converted &b) { return a.time < b.time; });
+  std::ofstream fo{filename};
+  if (!fo) {
+    throw std::runtime_error("could not open '" + filename.string() + "'");
+  }
+  fo << "<?xml version=\"1.0\"?>" << std::endl;
+  fo << "<VTKFile type=\"Collection\" version=\"0.1\">" << std::endl;
+  fo << "  <Collection>" << std::endl;
+  fo << std::setprecision(17);
+  for (const auto &f : files) {
+    fo << "    <DataSet timestep=\"" << f.time << "\" part=\"0\" file=\""
+       << f.filename.filename().string() << "\"/>" << std::endl;
+  }
+  fo << "  </Collection>" << std::endl;
+  fo << "</VTKFile>" << std::endl;
+  if (!fo) {
+    throw std::runtime_error("failed to write '" + filename.string() + "'");
+  }
+}
+
+/**
+ * @brief Write a ParaView Python script opening data and reflecting it about x = 0 and y = 0
+ *  Run as `pvpython reflect.py` or `paraview --script=reflect.py`.
+ */
+static void write_reflect(const std::filesystem::path &filename,
+                          const std::filesystem::path &data) {
+  std::ofstream fo{filename};
+  if (!fo) {
+    throw std::runtime_error("could not open '" + filename.string() + "'");
+  }
+  fo << "# Reflect the quadrants written by dat2vtk_2d --symmetry quadrant into the whole crystal"
+     << std::endl;
+  fo << "from paraview.simple import *" << std::endl;
+  fo << std::endl;
+  fo << "data = OpenDataFile(" << std::quoted(std::filesystem::absolute(data).string()) << ")"
+     << std::endl;
+  fo << "x = Reflect(Input=data, Plane=\"X\", Center=0.0)" << std::endl;
+  fo << "xy = Reflect(Input=x, Plane=\"Y\", Center=0.0)" << std::endl;
+  fo << "ColorBy(Show(xy), (\"POINTS\", \"ImageScalars\"))" << std::endl;
+  fo << "ResetCamera()" << std::endl;
+  fo << "Render()" << std::endl;
+  if (!fo) {
+    throw std::runtime_error("failed to write '" + filename.string() + "'");
   }
 }
 
 int main(int argc, char *argv[]) {
   Args args;
+  std::vector<std::filesystem::path> inputs;
   try {
     parse_args(argc, argv, args);
-  } catch (const std::invalid_argument &e) {
+    inputs = expand_inputs(args.input);
+    if (inputs.empty()) {
+      throw std::invalid_argument("no .pfs or .dat file given");
+    }
+    if (!args.name.empty() && inputs.size() > 1) {
+      throw std::invalid_argument("'--name' needs a single input");
+    }
+    /* Snapshots are timed in seconds and .dat files by their step, which one series cannot mix */
+    const auto snapshots = std::count_if(inputs.begin(), inputs.end(), [](const auto &f) {
+      return phase_field::io::is_snapshot(f);
+    });
+    if (snapshots != 0 && static_cast<std::size_t>(snapshots) != inputs.size()) {
+      throw std::invalid_argument("inputs mix .pfs snapshots and .dat files, convert them apart");
+    }
+    std::set<std::filesystem::path> names;
+    for (const auto &f : inputs) {
+      if (!names.insert(f.filename().replace_extension(".vti")).second) {
+        throw std::invalid_argument("inputs share the output name of '" + f.string() + "'");
+      }
+    }
+  } catch (const std::exception &e) {
     std::clog << e.what() << std::endl;
     return EXIT_FAILURE;
   }
@@ -100,51 +522,82 @@ int main(int argc, char *argv[]) {
     return EXIT_FAILURE;
   }
 
-  phase_field::Field2D field;
-  try {
-    phase_field::io::read(args.input, field);
-  } catch (const std::runtime_error &e) {
-    std::clog << e.what() << std::endl;
-    return EXIT_FAILURE;
+  /*
+   * Every worker converts one file at a time and releases it before taking the next, so at most
+   * jobs files are held in memory whatever the number of inputs. The OpenMP threads parsing a
+   * .dat file are shared out among the workers, so jobs teams never hold more than the cores.
+   */
+  std::size_t jobs = args.jobs ? args.jobs : std::max(1u, std::thread::hardware_concurrency());
+  jobs = std::min(jobs, inputs.size());
+  if (args.memory) {
+    std::size_t largest = 0;
+    try {
+      for (const auto &f : inputs) {
+        largest = std::max(largest, footprint(f));
+      }
+    } catch (const std::exception &e) {
+      std::clog << e.what() << std::endl;
+      return EXIT_FAILURE;
+    }
+    const std::size_t fit = (args.memory << 20) / std::max<std::size_t>(largest, 1);
+    jobs = std::max<std::size_t>(1, std::min(jobs, fit));
   }
 
-  vtkNew<vtkImageData> image_data;
-  image_data->SetOrigin(0, 0, 0);
-  image_data->SetSpacing(1, 1, 1);
-
-  const std::size_t size_y = field.shape()[0];
-  const std::size_t size_x = field.shape()[1];
-
-  // Make double size for mirror flip
-  image_data->SetDimensions(size_x * 2, size_y * 2, 1);
-  image_data->AllocateScalars(VTK_DOUBLE, 1);
-
-  const auto get_at = [&image_data](const std::size_t x,
-                                    const std::size_t y) -> phase_field::Field2D::scalar_type * {
-    return static_cast<phase_field::Field2D::scalar_type *>(image_data->GetScalarPointer(x, y, 0));
+  std::vector<Converted> results(inputs.size());
+  std::atomic<std::size_t> next{0};
+  std::mutex mtx;
+  const int omp_threads = std::max(1, omp_get_max_threads() / static_cast<int>(jobs));
+  const auto work = [&]() {
+    omp_set_num_threads(omp_threads);
+    for (std::size_t i = next++; i < inputs.size(); i = next++) {
+      const auto name = args.name.empty()
+                            ? inputs[i].filename().replace_extension(".vti")
+                            : args.name;
+      try {
+        results[i] = convert(inputs[i], args.output / name, args.compress, args.symmetry, i);
+        std::lock_guard lock{mtx};
+        std::cout << args.output / name << std::endl;
+      } catch (const std::exception &e) {
+        results[i].error = e.what();
+        std::lock_guard lock{mtx};
+        std::clog << e.what() << std::endl;
+      }
+    }
   };
+  std::vector<std::thread> workers;
+  for (std::size_t t = 1; t < jobs; ++t) {
+    workers.emplace_back(work);
+  }
+  work();
+  for (auto &t : workers) {
+    t.join();
+  }
 
-  for (std::size_t y = 0; y < size_y; ++y) {
-    for (std::size_t x = 0; x < size_x; ++x) {
-      // Flip for 4 fold sym
-      auto px_quad1 = get_at(size_x + x, size_y + y);
-      auto px_quad2 = get_at(size_x - 1 - x, size_x + y);
-      auto px_quad3 = get_at(size_x - 1 - x, size_y - 1 - y);
-      auto px_quad4 = get_at(size_x + x, size_y - 1 - y);
-      *px_quad1 = field[y][x];
-      *px_quad2 = field[y][x];
-      *px_quad3 = field[y][x];
-      *px_quad4 = field[y][x];
+  std::vector<Converted> converted;
+  for (const auto &r : results) {
+    if (r.error.empty()) {
+      converted.push_back(r);
     }
   }
+  if (inputs.size() > 1 && !converted.empty()) {
+    try {
+      write_pvd(args.output / args.pvd, converted);
+    } catch (const std::exception &e) {
+      std::clog << e.what() << std::endl;
+      return EXIT_FAILURE;
+    }
+    std::cout << args.output / args.pvd << std::endl;
+  }
+  if (args.symmetry == Symmetry::quadrant && !converted.empty()) {
+    try {
+      write_reflect(args.output / "reflect.py",
+                    inputs.size() > 1 ? args.output / args.pvd : converted.front().filename);
+    } catch (const std::exception &e) {
+      std::clog << e.what() << std::endl;
+      return EXIT_FAILURE;
+    }
+    std::cout << args.output / "reflect.py" << std::endl;
+  }
 
-  vtkNew<vtkXMLImageDataWriter> writer;
-  writer->SetDataModeToBinary();
-  writer->SetFileName((args.output / args.name).c_str());
-  writer->SetInputData(image_data);
-  writer->Write();
-
-  std::cout << args.output / args.name << std::endl;
-
-  return EXIT_SUCCESS;
-}
\ No newline at end of file
+  return converted.size() == inputs.size() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -3,18 +3,38 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <chrono>
+#include <csignal>
 #include <cstring>
 #include <filesystem>
 #include <iostream>
+#include <optional>
 #include <sstream>
 
+#include <phase_field/amr.hh>
+#include <phase_field/checkpoint.hh>
+#include <phase_field/config.hh>
 #include <phase_field/io.hh>
+#include <phase_field/narrow_band.hh>
+#include <phase_field/padded.hh>
+#include <phase_field/profile.hh>
 #include <phase_field/phase_field.hh>
+#include <phase_field/semi_implicit.hh>
+#include <phase_field/stepper.hh>
+#include <phase_field/temporal.hh>
 #include <phase_field/util.hh>
+#include <phase_field/writer.hh>
 
 struct Args {
   bool verbose = false;
-  std::filesystem::path output = "output"; // *Optional
+  bool adaptive = false;
+  bool check = false;
+  bool restart = false;
+  bool counters = false;
+  double checkpoint = -1.0;     // *Optional, overrides the run file
+  std::filesystem::path config; // *Optional
+  std::filesystem::path output; // *Optional, overrides the run file
+  std::string format;           // *Optional, overrides the run file
 };
 
 static void parse_args(const int argc, const char *const argv[], Args &args) {
@@ -22,14 +42,27 @@ static void parse_args(const int argc, const char *const argv[], Args &args) {
     os << argv[0] << " [Option]" << std::endl;
     os << std::endl;
     os << "Options:" << std::endl;
+    os << "    --config   (Opt) JSON run file (default: built-in 80x80 pure Ni case)" << std::endl;
+    os << "    --check    (Opt) Validate the run and print it without running" << std::endl;
+    os << "    --restart  (Opt) Resume from the checkpoint in the output folder, if any"
+       << std::endl;
+    os << "    --checkpoint (Opt) Wall-clock seconds between checkpoints (default: 0, off)"
+       << std::endl;
+    os << "    --counters (Opt) Read cycles and cache misses in the profile (ENABLE_PROFILE)"
+       << std::endl;
     os << "    --verbose  (Opt) Verbose mode" << std::endl;
+    os << "    --adaptive (Opt) Adaptive time step, same as solver.backend adaptive" << std::endl;
     os << "    --output   (Opt) Output folder (default: output)" << std::endl;
+    os << "    --format   (Opt) Output format pfs or dat (default: pfs)" << std::endl;
     os << "    --help     (Opt) Print help" << std::endl;
     return os;
   };
   enum class Context {
     none = 0,
+    config,
+    checkpoint,
     output,
+    format,
   } ctx = Context::none;
 
   for (int64_t i = 1; i < argc; ++i) {
@@ -37,8 +70,22 @@ static void parse_args(const int argc, const char *const argv[], Args &args) {
       ctx = Context::none;
       if (!strcmp(argv[i], "--verbose")) {
         args.verbose = true;
+      } else if (!strcmp(argv[i], "--adaptive")) {
+        args.adaptive = true;
+      } else if (!strcmp(argv[i], "--check")) {
+        args.check = true;
+      } else if (!strcmp(argv[i], "--config")) {
+        ctx = Context::config;
+      } else if (!strcmp(argv[i], "--restart")) {
+        args.restart = true;
+      } else if (!strcmp(argv[i], "--counters")) {
+        args.counters = true;
+      } else if (!strcmp(argv[i], "--checkpoint")) {
+        ctx = Context::checkpoint;
       } else if (!strcmp(argv[i], "--output")) {
         ctx = Context::output;
+      } else if (!strcmp(argv[i], "--format")) {
+        ctx = Context::format;
       } else if (!strcmp(argv[i], "--help")) {
         show_help(std::cout);
         exit(EXIT_SUCCESS);
@@ -47,11 +94,26 @@ static void parse_args(const int argc, const char *const argv[], Args &args) {
       }
     } else {
       switch (ctx) {
+      case Context::config: {
+        args.config = argv[i];
+        ctx = Context::none;
+        break;
+      }
+      case Context::checkpoint: {
+        args.checkpoint = std::stod(argv[i]);
+        ctx = Context::none;
+        break;
+      }
       case Context::output: {
         args.output = argv[i];
         ctx = Context::none;
         break;
       }
+      case Context::format: {
+        args.format = argv[i];
+        ctx = Context::none;
+        break;
+      }
       default:
         throw std::invalid_argument("Invalid token given");
       }
@@ -64,70 +126,367 @@ static void parse_args(const int argc, const char *const argv[], Args &args) {
   }
 }
 
+/**
+ * @brief Run file given by --config, or the built-in case, with the command line on top
+ */
+static phase_field::RunConfig get_run(const Args &args) {
+  auto run = args.config.empty() ? phase_field::RunConfig{}
+                                 : phase_field::RunConfig::load(args.config);
+  if (args.adaptive) {
+    run.solver.backend = "adaptive";
+  }
+  if (!args.output.empty()) {
+    run.output.directory = args.output;
+  }
+  if (!args.format.empty()) {
+    run.output.format = args.format;
+  }
+  if (args.checkpoint >= 0.0) {
+    run.checkpoint.interval = args.checkpoint;
+  }
+  run.validate();
+  /* steps and output.interval then count steps of the scaled dt */
+  if (run.solver.backend == "semi_implicit") {
+    run.param.dt *= run.solver.dt_scale;
+  }
+  return run;
+}
+
+/* Set by SIGTERM, SIGINT or SIGUSR1: write a checkpoint at the next step and stop */
+static volatile std::sig_atomic_t stop_signal = 0;
+
+static void request_stop(const int sig) { stop_signal = sig; }
+
 int main(int argc, char *argv[]) {
   Args args;
+  phase_field::RunConfig run;
   try {
     parse_args(argc, argv, args);
-  } catch (const std::invalid_argument &e) {
+    /* Everything is checked here, before any field is allocated */
+    run = get_run(args);
+  } catch (const std::exception &e) {
     std::cerr << e.what() << std::endl;
     return EXIT_FAILURE;
   }
-  const auto fmt_filename = [](const std::size_t step) -> std::string {
+  if (args.check) {
+    std::cout << run.to_json().dump(2) << std::endl;
+    std::cout << "fields:  " << run.bytes() / (1024.0 * 1024.0) << " [MiB]" << std::endl;
+    return EXIT_SUCCESS;
+  }
+  const auto &output = run.output.directory;
+  const auto fmt_filename = [&run](const std::size_t step) -> std::string {
     std::stringstream ss;
     ss << "pf_step";
     ss << std::setfill('0') << std::setw(6) << step;
-    ss << ".dat";
+    ss << "." << run.output.format;
     return ss.str();
   };
-  const auto get_log_stream = [](const std::filesystem::path &filename) {
-    std::ofstream fo{filename};
+  const auto get_log_stream = [&args](const std::filesystem::path &filename) {
+    std::ofstream fo{filename, args.restart ? std::ios::app : std::ios::out};
     if (!fo) {
       throw std::runtime_error("could not open '" + filename.string() + "'");
     }
     return fo;
   };
 
-  if (!std::filesystem::is_directory(args.output) &&
-      !std::filesystem::create_directories(args.output)) {
-    std::cerr << "failed to create " << args.output << std::endl;
+  if (!std::filesystem::is_directory(output) && !std::filesystem::create_directories(output)) {
+    std::cerr << "failed to create " << output << std::endl;
     return EXIT_FAILURE;
   }
-  auto log_stream = get_log_stream(args.output / "out.log");
-
-  phase_field::Param param = phase_field::get_pure_ni_param();
-
-  param.lambda = 16.0;
-  param.u = -0.2;
-  param.setup();
+  auto log_stream = get_log_stream(output / "out.log");
+  {
+    std::ofstream fo{output / "run.json"};
+    fo << run.to_json().dump(2) << std::endl;
+  }
 
+  const phase_field::Param &param = run.param;
   std::cout << param << std::endl;
   log_stream << param << std::endl;
-  log_stream.close();
 
+  /* Only the solver of the selected backend is built, the others would allocate for nothing */
   const auto system = phase_field::PhaseField2D(param);
-  phase_field::Field2D phi({80, 80});
-  phase_field::set_nuclear_to_corner(phi, 10);
+  const auto &backend = run.solver.backend;
+  std::optional<phase_field::NarrowBandPhaseField2D> narrow_band;
+  std::optional<phase_field::TemporalPhaseField2D> temporal;
+  std::optional<phase_field::SemiImplicitPhaseField2D> semi_implicit;
+  std::optional<phase_field::PaddedPhaseField2D> padded;
+  std::optional<phase_field::AMRPhaseField2D> amr;
+  std::optional<phase_field::AdaptiveStepper> stepper;
+  if (backend == "narrow_band") {
+    narrow_band.emplace(param, run.solver.tolerance);
+  } else if (backend == "temporal") {
+    temporal.emplace(param, run.solver.depth);
+  } else if (backend == "semi_implicit") {
+    semi_implicit.emplace(param);
+  } else if (backend == "padded") {
+    const auto boundary = run.solver.boundary == "periodic" ? phase_field::Boundary::periodic()
+                          : run.solver.boundary == "dirichlet"
+                              ? phase_field::Boundary::dirichlet(run.solver.boundary_value)
+                              : phase_field::Boundary::mirror();
+    padded.emplace(param, phase_field::Boundaries2D(boundary));
+  } else if (backend == "amr") {
+    amr.emplace(param, run.solver.amr);
+  } else if (backend == "adaptive") {
+    stepper.emplace(system, run.solver.stepper);
+  }
+
+  /* Resume from the checkpoint, or start from the initial condition */
+  const auto ckpt_path = output / run.checkpoint.file;
+  phase_field::Field2D phi({static_cast<std::size_t>(run.grid.ny),
+                            static_cast<std::size_t>(run.grid.nx)});
+  nlohmann::json resumed;
+  try {
+    if (args.restart && std::filesystem::exists(ckpt_path)) {
+      phase_field::Field2D data;
+      const auto info = phase_field::io::read_checkpoint(ckpt_path, {&data});
+      resumed = info.meta.at("checkpoint");
+      if (info.meta.at("param") != nlohmann::json(param) || resumed.at("backend") != backend ||
+          resumed.value("dt_scale", 1.0) != run.solver.dt_scale) {
+        throw std::runtime_error("checkpoint " + ckpt_path.string() +
+                                 " was written by another run");
+      }
+      if (backend == "amr") {
+        amr->restore(data, resumed.at("amr"));
+      } else if (data.shape() != phi.shape()) {
+        throw std::runtime_error("checkpoint " + ckpt_path.string() + " has another grid");
+      } else {
+        phi = std::move(data);
+      }
+      std::cout << "Resume from " << ckpt_path << " at step " << info.step << std::endl;
+      log_stream << "restart:     step " << info.step << std::endl;
+    } else if (run.initial.type == "corner") {
+      phase_field::set_nuclear_to_corner(phi, run.initial.radius);
+    } else if (run.initial.type == "circle") {
+      phase_field::set_nuclear(phi, run.initial.center_y, run.initial.center_x,
+                               run.initial.radius);
+    } else {
+      phase_field::io::read_snapshot(run.initial.file, phi);
+    }
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
   if (args.verbose) {
     std::cout << "[Enter] to continue..." << std::endl;
     while (std::cin.get() != '\n')
       ;
   }
 
-  auto phi_next = phase_field::Field2D::like(phi);
-  for (std::size_t step = 0; step < 5000; ++step) {
-    if (step % 100 == 0) {
-      if (args.verbose) {
-        std::system("clear");
-        std::cout << "time: " << std::setw(6) << std::fixed << step * param.dt * 1.0e9 << " [ns] ";
-        std::cout << "(step:" << std::setw(5) << step << ")" << std::endl;
-        phase_field::io::fmt_visual_square(std::cout, phi) << std::endl;
+  const auto format = run.output.format == "dat" ? phase_field::io::Format::text
+                                                 : phase_field::io::Format::snapshot;
+  phase_field::io::AsyncWriter writer;
+  const auto start = std::chrono::steady_clock::now();
+
+  const auto snapshot = [&](const phase_field::Field2D &field, const std::size_t frame,
+                            const std::size_t step, const double time) {
+    if (args.verbose) {
+      std::system("clear");
+      std::cout << "time: " << std::setw(6) << std::fixed << time * 1.0e9 << " [ns] ";
+      std::cout << "(step:" << std::setw(5) << step << ")" << std::endl;
+      phase_field::io::fmt_visual_square(std::cout, field) << std::endl;
+    }
+    writer.submit(output / fmt_filename(frame), field, format, {step, time, param});
+  };
+
+  /*
+   * A checkpoint holds everything the loops below depend on, so the resumed run takes the same
+   * steps bit for bit. It is written at the top of a step, after the snapshots before it.
+   */
+  auto last_checkpoint = std::chrono::steady_clock::now();
+  const auto checkpoint_due = [&]() {
+    const double since =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - last_checkpoint).count();
+    return stop_signal != 0 || (run.checkpoint.interval > 0.0 && since >= run.checkpoint.interval);
+  };
+  const auto save = [&](const phase_field::Field2D &data, const std::size_t step,
+                        const double time, nlohmann::json state) {
+    writer.flush();
+    state["backend"] = backend;
+    state["dt_scale"] = run.solver.dt_scale;
+    phase_field::io::SnapshotInfo info(step, time, param);
+    info.meta["checkpoint"] = std::move(state);
+    phase_field::io::write_checkpoint(ckpt_path, {&data}, info);
+    last_checkpoint = std::chrono::steady_clock::now();
+    log_stream << "checkpoint:  step " << step << std::endl;
+  };
+  if (args.counters && !phase_field::profile::enable_counters()) {
+    std::clog << "hardware counters unavailable ("
+              << (phase_field::profile::enabled ? "perf_event" : "built without ENABLE_PROFILE")
+              << ")" << std::endl;
+  }
+  std::signal(SIGTERM, request_stop);
+  std::signal(SIGINT, request_stop);
+  std::signal(SIGUSR1, request_stop);
+
+  const std::size_t n_steps = run.steps;
+  const std::size_t interval = run.output.interval;
+  if (backend == "adaptive") {
+    /* Same physical time and snapshot times as the fixed step, named by the fixed step count */
+    std::size_t frame = 0;
+    bool taken = false;
+    if (!resumed.is_null()) {
+      frame = resumed.at("frame").get<std::size_t>();
+      stepper->restore(resumed.at("time").get<double>(), resumed.at("steps").get<std::size_t>(),
+                      resumed.at("dt").get<double>());
+      taken = true;
+    } else {
+      log_stream << "step time[sec] dt[sec] dt/tau0" << std::endl;
+    }
+    const auto state = [&]() -> nlohmann::json {
+      return {{"frame", frame}, {"time", stepper->time()}, {"steps", stepper->steps()},
+              {"dt", stepper->dt()}};
+    };
+    auto phi_next = phase_field::Field2D::like(phi);
+    while (frame < n_steps) {
+      if (!taken) {
+        snapshot(phi, frame, stepper->steps(), stepper->time());
+        taken = true;
       }
-      phase_field::io::write(args.output / fmt_filename(step), phi, true);
+      const double t_end = std::min(frame + interval, n_steps) * param.dt;
+      if (stepper->time() >= t_end) {
+        frame += interval;
+        taken = false;
+        continue;
+      }
+      if (checkpoint_due()) {
+        save(phi, stepper->steps(), stepper->time(), state());
+        if (stop_signal) {
+          break;
+        }
+      }
+      const double dt = stepper->step(phi, phi_next, t_end);
+      std::swap(phi, phi_next);
+      log_stream << stepper->steps() << " " << std::scientific << stepper->time() << " " << dt
+                 << " " << std::fixed << dt / param.tau0 << std::endl;
+    }
+    if (!stop_signal) {
+      if (run.checkpoint.interval > 0.0) {
+        save(phi, stepper->steps(), stepper->time(), state());
+      }
+      log_stream << "steps:       " << stepper->steps() << " (fixed step: " << n_steps << ")"
+                 << std::endl;
+    }
+  } else if (backend == "amr") {
+    if (resumed.is_null()) {
+      amr->initialize(phi);
+    }
+    phase_field::Field2D data;
+    const auto save_amr = [&](const std::size_t step) {
+      save(data, step, step * param.dt, {{"step", step}, {"amr", amr->checkpoint(data)}});
+    };
+    for (std::size_t step = amr->steps(); step < n_steps; ++step) {
+      if (checkpoint_due()) {
+        save_amr(step);
+        if (stop_signal) {
+          break;
+        }
+      }
+      if (step % interval == 0) {
+        amr->to_uniform(phi);
+        snapshot(phi, step, step, step * param.dt);
+      }
+      amr->step();
+    }
+    if (!stop_signal) {
+      if (run.checkpoint.interval > 0.0) {
+        save_amr(amr->steps());
+      }
+      log_stream << "patches:     " << amr->patches() << " (" << amr->cells() << " cells)"
+                 << std::endl;
+    }
+  } else {
+    /*
+     * The fused, temporal, semi_implicit and padded backends run up to the next snapshot in one
+     * call, in chunks of at most max_chunk steps so checkpoints and signals are still seen every
+     * few steps. The padded backend steps its own fields and copies the interior back after
+     * every chunk, for the output.
+     */
+    constexpr std::size_t max_chunk = 64;
+    phase_field::PingPong2D fields(std::move(phi));
+    std::size_t step = 0;
+    if (!resumed.is_null()) {
+      step = resumed.at("step").get<std::size_t>();
+      if (backend == "narrow_band") {
+        narrow_band->restore(fields.current(), fields.next(),
+                            resumed.at("tiles").get<std::string>());
+      }
+    }
+    std::optional<phase_field::PaddedPingPong2D> padded_fields;
+    if (backend == "padded") {
+      padded_fields.emplace(phase_field::PaddedField2D(fields.current()));
+    }
+    const auto state = [&]() -> nlohmann::json {
+      nlohmann::json ret = {{"step", step}};
+      if (backend == "narrow_band") {
+        ret["tiles"] = narrow_band->state();
+      }
+      return ret;
+    };
+    while (step < n_steps) {
+      if (checkpoint_due()) {
+        save(fields.current(), step, step * param.dt, state());
+        if (stop_signal) {
+          break;
+        }
+      }
+      if (step % interval == 0) {
+        snapshot(fields.current(), step, step, step * param.dt);
+      }
+      if (backend == "fused" || backend == "temporal" || backend == "semi_implicit" ||
+          backend == "padded") {
+        const std::size_t n =
+            std::min({n_steps, (step / interval + 1) * interval, step + max_chunk}) - step;
+        if (backend == "fused") {
+          system.advance(fields, n);
+        } else if (backend == "temporal") {
+          temporal->advance(fields, n);
+        } else if (backend == "semi_implicit") {
+          semi_implicit->advance(fields, n);
+        } else {
+          padded->advance(*padded_fields, n);
+          padded_fields->current().copy_to(fields.current());
+        }
+        step += n;
+        continue;
+      }
+      if (backend == "narrow_band") {
+        narrow_band->predict(fields.current(), fields.next());
+      } else {
+        system.predict_reference(fields.current(), fields.next());
+      }
+      fields.swap();
+      ++step;
+    }
+    if (!stop_signal && run.checkpoint.interval > 0.0) {
+      save(fields.current(), step, step * param.dt, state());
+    }
+  }
+  writer.flush();
+  const auto elapsed =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  log_stream << std::fixed << std::setprecision(3);
+  log_stream << "elapsed:     " << elapsed << " [sec]" << std::endl;
+  log_stream << "io blocked:  " << writer.blocked_seconds() << " [sec] (copy "
+             << writer.copy_seconds() << " [sec], " << writer.written() << " snapshots)"
+             << std::endl;
+  log_stream << "io written:  " << writer.write_seconds() << " [sec] in background" << std::endl;
+  if constexpr (phase_field::profile::enabled) {
+    /* Stage totals of this process, next to out.log */
+    phase_field::profile::write(output / "profile.json");
+    phase_field::profile::write(output / "profile.csv");
+    for (const auto &stage : phase_field::profile::report()) {
+      log_stream << "profile:     " << std::setw(10) << stage["stage"].get<std::string>() << " "
+                 << stage["seconds"].get<double>() << " [sec] "
+                 << stage["bandwidth"].get<double>() / 1e9 << " [GB/s]" << std::endl;
     }
-    system.predict(phi, phi_next);
-    phi = phi_next;
   }
 
-  std::cout << "Result is saved in " << args.output << std::endl;
+  if (stop_signal) {
+    std::cout << "Stopped by signal " << stop_signal << ", resume with --restart from "
+              << ckpt_path << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Result is saved in " << output << std::endl;
   return EXIT_SUCCESS;
 }
@@ -0,0 +1,298 @@
+/*
+ * Copyright (c) 2025 Materials Modelling Lab, The University of Tokyo
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include <phase_field/config.hh>
+#include <phase_field/ensemble.hh>
+#include <phase_field/io.hh>
+#include <phase_field/util.hh>
+#include <phase_field/writer.hh>
+
+struct Args {
+  bool check = false;
+  std::filesystem::path config; // *Required
+  std::filesystem::path output; // *Optional, overrides the run file
+  std::string format;           // *Optional, overrides the run file
+};
+
+static void parse_args(const int argc, const char *const argv[], Args &args) {
+  const auto &show_help = [argv](std::ostream &os) -> std::ostream & {
+    os << argv[0] << " --config <file> [Option]" << std::endl;
+    os << std::endl;
+    os << "Options:" << std::endl;
+    os << "    --config   (Req) JSON run file with a sweep or a list of members" << std::endl;
+    os << "    --check    (Opt) Validate the ensemble and print it without running" << std::endl;
+    os << "    --output   (Opt) Output folder (default: output)" << std::endl;
+    os << "    --format   (Opt) Output format pfs or dat (default: pfs)" << std::endl;
+    os << "    --help     (Opt) Print help" << std::endl;
+    return os;
+  };
+  enum class Context {
+    none = 0,
+    config,
+    output,
+    format,
+  } ctx = Context::none;
+
+  for (int64_t i = 1; i < argc; ++i) {
+    if (!strncmp(argv[i], "--", 2)) {
+      ctx = Context::none;
+      if (!strcmp(argv[i], "--check")) {
+        args.check = true;
+      } else if (!strcmp(argv[i], "--config")) {
+        ctx = Context::config;
+      } else if (!strcmp(argv[i], "--output")) {
+        ctx = Context::output;
+      } else if (!strcmp(argv[i], "--format")) {
+        ctx = Context::format;
+      } else if (!strcmp(argv[i], "--help")) {
+        show_help(std::cout);
+        exit(EXIT_SUCCESS);
+      } else {
+        throw std::invalid_argument(std::string("Invalid token '") + argv[i] + "' given");
+      }
+    } else {
+      switch (ctx) {
+      case Context::config: {
+        args.config = argv[i];
+        ctx = Context::none;
+        break;
+      }
+      case Context::output: {
+        args.output = argv[i];
+        ctx = Context::none;
+        break;
+      }
+      case Context::format: {
+        args.format = argv[i];
+        ctx = Context::none;
+        break;
+      }
+      default:
+        throw std::invalid_argument("Invalid token given");
+      }
+    }
+  }
+
+  if (ctx != Context::none) {
+    std::clog << "required option for '" << argv[argc - 1] << "' not given" << std::endl;
+    exit(EXIT_FAILURE);
+  }
+  if (args.config.empty()) {
+    show_help(std::clog);
+    exit(EXIT_FAILURE);
+  }
+}
+
+/**
+ * @brief Ensemble run: the shared run and the material overrides of every member
+ *  The run file is a RunConfig with two more keys, at least one of which is required:
+ *    "sweep":   {"u": [...], "lambda": [...], ...}  every combination of the listed values
+ *    "members": [{"u": -0.2, "epsilon_c": 0.02}, ...] explicit members
+ *  Keys are those of "material" and apply on top of it. Members of a sweep come first.
+ */
+struct Ensemble {
+  phase_field::RunConfig run;
+  std::vector<nlohmann::json> overrides;
+  std::vector<phase_field::Param> params;
+};
+
+static Ensemble get_ensemble(const Args &args) {
+  std::ifstream fi(args.config);
+  if (!fi) {
+    throw std::runtime_error("could not open '" + args.config.string() + "'");
+  }
+  nlohmann::json j;
+  try {
+    fi >> j;
+  } catch (const nlohmann::json::parse_error &e) {
+    throw std::invalid_argument("'" + args.config.string() + "' is not valid JSON: " + e.what());
+  }
+  if (!j.is_object()) {
+    throw std::invalid_argument("run file must hold an object");
+  }
+
+  Ensemble ret;
+  if (j.contains("sweep")) {
+    const auto &sweep = j.at("sweep");
+    if (!sweep.is_object() || sweep.empty()) {
+      throw std::invalid_argument("'sweep' must be an object of value lists");
+    }
+    ret.overrides.push_back(nlohmann::json::object());
+    for (const auto &item : sweep.items()) {
+      if (!item.value().is_array() || item.value().empty()) {
+        throw std::invalid_argument("'sweep." + item.key() + "' must be a non-empty list");
+      }
+      std::vector<nlohmann::json> next;
+      for (const auto &o : ret.overrides) {
+        for (const auto &v : item.value()) {
+          next.push_back(o);
+          next.back()[item.key()] = v;
+        }
+      }
+      ret.overrides = std::move(next);
+    }
+    j.erase("sweep");
+  }
+  if (j.contains("members")) {
+    const auto &members = j.at("members");
+    if (!members.is_array() || members.empty()) {
+      throw std::invalid_argument("'members' must be a non-empty list");
+    }
+    for (const auto &m : members) {
+      ret.overrides.push_back(m);
+    }
+    j.erase("members");
+  }
+  if (ret.overrides.empty()) {
+    throw std::invalid_argument("run file has neither 'sweep' nor 'members'");
+  }
+
+  ret.run = phase_field::RunConfig::from_json(j);
+  if (!args.output.empty()) {
+    ret.run.output.directory = args.output;
+  }
+  if (!args.format.empty()) {
+    ret.run.output.format = args.format;
+  }
+  if (ret.run.solver.backend != "fused") {
+    throw std::invalid_argument("ensemble runs only support the fused backend");
+  }
+  ret.run.validate();
+
+  /* Every member is checked as a run of its own before anything is allocated */
+  for (std::size_t m = 0; m < ret.overrides.size(); ++m) {
+    auto member = ret.run;
+    member.param = phase_field::RunConfig::with_overrides(ret.run.param, ret.overrides[m],
+                                                          "members[" + std::to_string(m) + "]");
+    member.validate();
+    ret.params.push_back(member.param);
+  }
+  return ret;
+}
+
+int main(int argc, char *argv[]) {
+  Args args;
+  Ensemble ensemble;
+  try {
+    parse_args(argc, argv, args);
+    ensemble = get_ensemble(args);
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  const auto &run = ensemble.run;
+  const auto &params = ensemble.params;
+  const auto n_members = static_cast<int64_t>(params.size());
+  const auto lanes = (n_members + phase_field::EnsembleField2D::lane_multiple - 1) /
+                     phase_field::EnsembleField2D::lane_multiple *
+                     phase_field::EnsembleField2D::lane_multiple;
+  const auto bytes = run.bytes() * lanes;
+  if (args.check) {
+    nlohmann::json j = run.to_json();
+    j["members"] = ensemble.overrides;
+    std::cout << j.dump(2) << std::endl;
+    std::cout << "members: " << n_members << std::endl;
+    std::cout << "fields:  " << bytes / (1024.0 * 1024.0) << " [MiB]" << std::endl;
+    return EXIT_SUCCESS;
+  }
+
+  const auto &output = run.output.directory;
+  const auto member_dir = [&output](const int64_t m) {
+    std::stringstream ss;
+    ss << "member_" << std::setfill('0') << std::setw(4) << m;
+    return output / ss.str();
+  };
+  const auto fmt_filename = [&run](const std::size_t step) -> std::string {
+    std::stringstream ss;
+    ss << "pf_step";
+    ss << std::setfill('0') << std::setw(6) << step;
+    ss << "." << run.output.format;
+    return ss.str();
+  };
+  for (int64_t m = 0; m < n_members; ++m) {
+    const auto dir = member_dir(m);
+    if (!std::filesystem::is_directory(dir) && !std::filesystem::create_directories(dir)) {
+      std::cerr << "failed to create " << dir << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  std::ofstream log_stream{output / "out.log"};
+  if (!log_stream) {
+    std::cerr << "could not open " << output / "out.log" << std::endl;
+    return EXIT_FAILURE;
+  }
+  {
+    nlohmann::json j = run.to_json();
+    j["members"] = nlohmann::json::array();
+    for (int64_t m = 0; m < n_members; ++m) {
+      j["members"].push_back({{"directory", member_dir(m).filename().string()},
+                              {"overrides", ensemble.overrides[m]},
+                              {"param", params[m]}});
+    }
+    std::ofstream fo{output / "run.json"};
+    fo << j.dump(2) << std::endl;
+  }
+  std::cout << n_members << " members on a " << run.grid.ny << "x" << run.grid.nx << " grid ("
+            << bytes / (1024.0 * 1024.0) << " [MiB])" << std::endl;
+
+  const phase_field::EnsemblePhaseField2D system(params);
+  auto phi = system.make_field(run.grid.ny, run.grid.nx);
+  auto phi_next = system.make_field(run.grid.ny, run.grid.nx);
+  phase_field::Field2D member({static_cast<std::size_t>(run.grid.ny),
+                               static_cast<std::size_t>(run.grid.nx)});
+  if (run.initial.type == "corner") {
+    phase_field::set_nuclear_to_corner(member, run.initial.radius);
+  } else if (run.initial.type == "circle") {
+    phase_field::set_nuclear(member, run.initial.center_y, run.initial.center_x,
+                             run.initial.radius);
+  } else {
+    phase_field::io::read_snapshot(run.initial.file, member);
+  }
+  for (int64_t m = 0; m < n_members; ++m) {
+    phi.set(m, member);
+  }
+
+  const auto format = run.output.format == "dat" ? phase_field::io::Format::text
+                                                 : phase_field::io::Format::snapshot;
+  phase_field::io::AsyncWriter writer;
+  const auto snapshot = [&](const std::size_t step) {
+    for (int64_t m = 0; m < n_members; ++m) {
+      phi.get(m, member);
+      writer.submit(member_dir(m) / fmt_filename(step), member, format,
+                    {step, step * params[m].dt, params[m]});
+    }
+  };
+
+  const auto start = std::chrono::steady_clock::now();
+  for (std::size_t step = 0; step < run.steps; ++step) {
+    if (step % run.output.interval == 0) {
+      snapshot(step);
+    }
+    system.predict(phi, phi_next);
+    std::swap(phi, phi_next);
+  }
+  writer.flush();
+  const auto elapsed =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  log_stream << std::fixed << std::setprecision(3);
+  log_stream << "members:     " << n_members << std::endl;
+  log_stream << "elapsed:     " << elapsed << " [sec]" << std::endl;
+  log_stream << "throughput:  " << n_members * 3600.0 / elapsed << " [cases/hour], "
+             << static_cast<double>(n_members) * run.steps * run.grid.ny * run.grid.nx / elapsed
+             << " [cell updates/sec]" << std::endl;
+  log_stream << "io blocked:  " << writer.blocked_seconds() << " [sec] (" << writer.written()
+             << " snapshots)" << std::endl;
+
+  std::cout << "Result is saved in " << output << std::endl;
+  return EXIT_SUCCESS;
+}
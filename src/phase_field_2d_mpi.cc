@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2025 Materials Modelling Lab, The University of Tokyo
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+
+#include <phase_field/io.hh>
+#include <phase_field/mpi.hh>
+#include <phase_field/util.hh>
+
+struct Args {
+  bool verbose = false;
+  std::filesystem::path output = "output"; // *Optional
+  std::size_t size = 80;                   // *Optional
+};
+
+static void parse_args(const int argc, const char *const argv[], Args &args) {
+  const auto &show_help = [argv](std::ostream &os) -> std::ostream & {
+    os << argv[0] << " [Option]" << std::endl;
+    os << std::endl;
+    os << "Options:" << std::endl;
+    os << "    --verbose  (Opt) Verbose mode" << std::endl;
+    os << "    --output   (Opt) Output folder (default: output)" << std::endl;
+    os << "    --size     (Opt) Global grid size along y and x (default: 80)" << std::endl;
+    os << "    --help     (Opt) Print help" << std::endl;
+    return os;
+  };
+  enum class Context {
+    none = 0,
+    output,
+    size,
+  } ctx = Context::none;
+
+  for (int64_t i = 1; i < argc; ++i) {
+    if (!strncmp(argv[i], "--", 2)) {
+      ctx = Context::none;
+      if (!strcmp(argv[i], "--verbose")) {
+        args.verbose = true;
+      } else if (!strcmp(argv[i], "--output")) {
+        ctx = Context::output;
+      } else if (!strcmp(argv[i], "--size")) {
+        ctx = Context::size;
+      } else if (!strcmp(argv[i], "--help")) {
+        show_help(std::cout);
+        MPI_Finalize();
+        exit(EXIT_SUCCESS);
+      } else {
+        throw std::invalid_argument(std::string("Invalid token '") + argv[i] + "' given");
+      }
+    } else {
+      switch (ctx) {
+      case Context::output: {
+        args.output = argv[i];
+        ctx = Context::none;
+        break;
+      }
+      case Context::size: {
+        args.size = std::stoul(argv[i]);
+        ctx = Context::none;
+        break;
+      }
+      default:
+        throw std::invalid_argument("Invalid token given");
+      }
+    }
+  }
+
+  if (ctx != Context::none) {
+    throw std::invalid_argument(std::string("required option for '") + argv[argc - 1] +
+                                "' not given");
+  }
+}
+
+int main(int argc, char *argv[]) {
+  int provided;
+  MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &provided);
+  if (provided < MPI_THREAD_FUNNELED) {
+    std::cerr << "MPI does not support MPI_THREAD_FUNNELED" << std::endl;
+    MPI_Abort(MPI_COMM_WORLD, EXIT_FAILURE);
+  }
+
+  Args args;
+  try {
+    parse_args(argc, argv, args);
+  } catch (const std::invalid_argument &e) {
+    std::cerr << e.what() << std::endl;
+    MPI_Finalize();
+    return EXIT_FAILURE;
+  }
+  const auto fmt_filename = [](const std::size_t step) -> std::string {
+    std::stringstream ss;
+    ss << "pf_step";
+    ss << std::setfill('0') << std::setw(6) << step;
+    ss << ".pfs";
+    return ss.str();
+  };
+
+  int rank;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  if (rank == 0 && !std::filesystem::is_directory(args.output) &&
+      !std::filesystem::create_directories(args.output)) {
+    std::cerr << "failed to create " << args.output << std::endl;
+    MPI_Abort(MPI_COMM_WORLD, EXIT_FAILURE);
+  }
+  std::ofstream log_stream;
+  if (rank == 0) {
+    log_stream.open(args.output / "out.log");
+  }
+
+  phase_field::Param param = phase_field::get_pure_ni_param();
+
+  param.lambda = 16.0;
+  param.u = -0.2;
+  param.setup();
+
+  /* The decomposition frees its communicator, so it must go out of scope before finalize */
+  {
+    const phase_field::mpi::BlockDecomposition2D decomp(MPI_COMM_WORLD, args.size, args.size);
+    if (rank == 0) {
+      std::cout << param << std::endl;
+      log_stream << param << std::endl;
+      log_stream << "ranks:       " << decomp.size() << " (" << decomp.process_grid()[0] << " x "
+                 << decomp.process_grid()[1] << ")" << std::endl;
+    }
+
+    const auto system = phase_field::mpi::DistributedPhaseField2D(param, decomp);
+    auto phi = decomp.make_field();
+    {
+      phase_field::Field2D global;
+      if (rank == 0) {
+        global.resize({args.size, args.size});
+        phase_field::set_nuclear_to_corner(global, 10);
+      }
+      decomp.scatter(global, phi);
+    }
+
+    const double start = MPI_Wtime();
+    double io_time = 0.0;
+    auto phi_next = decomp.make_field();
+    for (std::size_t step = 0; step < 5000; ++step) {
+      if (step % 100 == 0) {
+        if (args.verbose && rank == 0) {
+          std::cout << "time: " << std::setw(6) << std::fixed << step * param.dt * 1.0e9 << " [ns] ";
+          std::cout << "(step:" << std::setw(5) << step << ")" << std::endl;
+        }
+        const double io_start = MPI_Wtime();
+        phase_field::mpi::write_snapshot(args.output / fmt_filename(step), decomp, phi,
+                                         {step, step * param.dt, param});
+        io_time += MPI_Wtime() - io_start;
+      }
+      system.predict(phi, phi_next);
+      std::swap(phi, phi_next);
+    }
+    const double elapsed = MPI_Wtime() - start;
+
+    if (rank == 0) {
+      log_stream << std::fixed << std::setprecision(3);
+      log_stream << "elapsed:     " << elapsed << " [sec]" << std::endl;
+      log_stream << "io:          " << io_time << " [sec]" << std::endl;
+      std::cout << "Result is saved in " << args.output << std::endl;
+    }
+  }
+  MPI_Finalize();
+  return EXIT_SUCCESS;
+}
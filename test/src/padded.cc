@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2025 Materials Modelling Lab, The University of Tokyo
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+#include <phase_field/padded.hh>
+#include <phase_field/phase_field.hh>
+#include <phase_field/util.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+/*
+ * Every boundary kind of PaddedPhaseField2D against a run that must give the same field:
+ *   mirror:    a corner nucleus on the quarter domain against the full domain mirrored about
+ *              the centre with periodic boundaries, the image of the mirror boundaries
+ *   periodic:  the field shifted across the boundary against the result shifted
+ *   dirichlet: a nucleus in the middle against the fused kernel on a plain field two cells
+ *              larger, its outer ring held at the value
+ * and the boundaries Boundaries2D::validate rejects.
+ */
+namespace {
+using phase_field::Boundaries2D;
+using phase_field::Boundary;
+using phase_field::Field2D;
+using phase_field::PaddedField2D;
+using phase_field::PaddedPhaseField2D;
+using phase_field::PaddedPingPong2D;
+
+constexpr std::size_t n = 128;
+constexpr std::size_t n_steps = 200;
+constexpr double tolerance = 1e-12;
+constexpr double liquid = phase_field::FieldState::liquid;
+
+phase_field::Param get_param() {
+  phase_field::Param p = phase_field::get_pure_ni_param();
+  p.lambda = 16.0;
+  p.u = -0.2;
+  p.setup();
+  return p;
+}
+
+Field2D run(const Boundaries2D &b, const Field2D &initial) {
+  const PaddedPhaseField2D system(get_param(), b);
+  PaddedPingPong2D fields{PaddedField2D(initial)};
+  system.advance(fields, n_steps);
+  Field2D ret = Field2D::like(initial);
+  fields.current().copy_to(ret);
+  return ret;
+}
+
+/* Largest difference of a with b[y + dy][x + dx], indices of b taken modulo its shape */
+double diff(const Field2D &a, const Field2D &b, const std::size_t dy, const std::size_t dx) {
+  const auto ny = a.shape()[0];
+  const auto nx = a.shape()[1];
+  const auto my = b.shape()[0];
+  const auto mx = b.shape()[1];
+  double ret = 0.0;
+  for (std::size_t y = 0; y < ny; ++y) {
+    for (std::size_t x = 0; x < nx; ++x) {
+      const double d = std::abs(a[y][x] - b[(y + dy) % my][(x + dx) % mx]);
+      ret = std::isnan(d) ? HUGE_VAL : std::max(ret, d);
+    }
+  }
+  return ret;
+}
+} // namespace
+
+TEST(PaddedPhaseField2D, Mirror) {
+  Field2D quarter({n, n});
+  phase_field::set_nuclear_to_corner(quarter, static_cast<int64_t>(n / 8));
+  Field2D full({2 * n, 2 * n});
+  for (std::size_t y = 0; y < 2 * n; ++y) {
+    for (std::size_t x = 0; x < 2 * n; ++x) {
+      full[y][x] = quarter[y < n ? n - 1 - y : y - n][x < n ? n - 1 - x : x - n];
+    }
+  }
+  EXPECT_LE(diff(run(Boundaries2D(Boundary::mirror()), quarter),
+                 run(Boundaries2D(Boundary::periodic()), full), n, n),
+            tolerance);
+}
+
+TEST(PaddedPhaseField2D, Periodic) {
+  const std::size_t sy = n / 3;
+  const std::size_t sx = n / 5;
+  Field2D phi({n, n});
+  phase_field::set_nuclear(phi, static_cast<int64_t>(n / 8), static_cast<int64_t>(n / 8),
+                           static_cast<int64_t>(n / 8));
+  Field2D shifted = Field2D::like(phi);
+  for (std::size_t y = 0; y < n; ++y) {
+    for (std::size_t x = 0; x < n; ++x) {
+      shifted[(y + sy) % n][(x + sx) % n] = phi[y][x];
+    }
+  }
+  const Boundaries2D b(Boundary::periodic());
+  EXPECT_LE(diff(run(b, phi), run(b, shifted), sy, sx), tolerance);
+}
+
+TEST(PaddedPhaseField2D, Dirichlet) {
+  Field2D phi({n, n});
+  phase_field::set_nuclear(phi, static_cast<int64_t>(n / 2), static_cast<int64_t>(n / 2),
+                           static_cast<int64_t>(n / 8));
+  const int64_t g = PaddedField2D::ghost;
+  const auto m = n + 2 * g;
+  Field2D cur({m, m});
+  Field2D next({m, m});
+  for (std::size_t y = 0; y < m; ++y) {
+    for (std::size_t x = 0; x < m; ++x) {
+      const bool ring = y < g || y >= n + g || x < g || x >= n + g;
+      cur[y][x] = ring ? liquid : phi[y - g][x - g];
+      next[y][x] = cur[y][x];
+    }
+  }
+  const phase_field::FusedPredictKernel fused(get_param());
+  phase_field::FusedPredictKernel::Scratch s;
+  const auto mi = static_cast<int64_t>(m);
+  for (std::size_t step = 0; step < n_steps; ++step) {
+    fused.tile(cur, next, {g, mi - g, g, mi - g}, {0, mi, 0, mi}, s);
+    std::swap(cur, next);
+  }
+  EXPECT_LE(diff(run(Boundaries2D(Boundary::dirichlet(liquid)), phi), cur, g, g), tolerance);
+}
+
+TEST(Boundaries2D, PeriodicMustBePaired) {
+  const auto m = Boundary::mirror();
+  const auto p = Boundary::periodic();
+  const int64_t g = PaddedField2D::ghost;
+  EXPECT_THROW(Boundaries2D(p, m, m, m).validate(16, 16, g), std::invalid_argument);
+  EXPECT_THROW(Boundaries2D(m, m, m, p).validate(16, 16, g), std::invalid_argument);
+  EXPECT_NO_THROW(Boundaries2D(p, p, m, m).validate(16, 16, g));
+}
+
+TEST(Boundaries2D, DomainSmallerThanGhost) {
+  const int64_t g = PaddedField2D::ghost;
+  const auto d = Boundary::dirichlet(liquid);
+  EXPECT_THROW(Boundaries2D(Boundary::mirror()).validate(g - 1, 16, g), std::invalid_argument);
+  EXPECT_THROW(Boundaries2D(Boundary::periodic()).validate(16, g - 1, g), std::invalid_argument);
+  /* Dirichlet never reads the interior */
+  EXPECT_NO_THROW(Boundaries2D(d).validate(g - 1, g - 1, g));
+  /* The solver checks its boundaries against the field */
+  const PaddedPhaseField2D system(get_param(), Boundaries2D(Boundary::mirror()));
+  PaddedPingPong2D fields{PaddedField2D(Field2D({1, 16}))};
+  EXPECT_THROW(system.advance(fields, 1), std::invalid_argument);
+}